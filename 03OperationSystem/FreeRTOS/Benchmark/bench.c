@@ -0,0 +1,75 @@
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+void vBenchInit( void )
+{
+    /* Not reset: the scheduler is running, and the DWT run time counter would
+     * take a lower count for a wrap.  Samples are differences anyway. */
+    #ifndef USE_HOST_SIM
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+
+    printf( "# bench,unit,samples,min,median,p99,max,mean\n" );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReport( const char * pcName,
+                   uint32_t * pulSamples,
+                   uint32_t ulCount )
+{
+    uint32_t i, j, ulValue;
+    uint64_t ullSum = 0;
+
+    if( ulCount == 0 )
+    {
+        printf( "%s,%s,0,,,,,\n", pcName, benchTIME_UNIT );
+        return;
+    }
+
+    /* Insertion sort: sample sets are small and this keeps the target free
+     * of qsort(). */
+    for( i = 1; i < ulCount; i++ )
+    {
+        ulValue = pulSamples[ i ];
+
+        for( j = i; ( j > 0 ) && ( pulSamples[ j - 1 ] > ulValue ); j-- )
+        {
+            pulSamples[ j ] = pulSamples[ j - 1 ];
+        }
+
+        pulSamples[ j ] = ulValue;
+    }
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        ullSum += pulSamples[ i ];
+    }
+
+    printf( "%s,%s,%lu,%lu,%lu,%lu,%lu,%lu\n",
+            pcName,
+            benchTIME_UNIT,
+            ( unsigned long ) ulCount,
+            ( unsigned long ) pulSamples[ 0 ],
+            ( unsigned long ) pulSamples[ ulCount / 2 ],
+            ( unsigned long ) pulSamples[ ( ( ulCount * 99 ) + 99 ) / 100 - 1 ],
+            ( unsigned long ) pulSamples[ ulCount - 1 ],
+            ( unsigned long ) ( ullSum / ulCount ) );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchDone( void )
+{
+    printf( "# done\n" );
+
+    #ifdef USE_HOST_SIM
+        fflush( stdout );
+        vTaskEndScheduler();
+    #else
+        vTaskDelete( NULL );
+    #endif
+}
@@ -0,0 +1,132 @@
+/*
+ * Kernel benchmark helpers.
+ *
+ * Timestamps come from the Cortex-M3 DWT cycle counter on target and from
+ * CLOCK_MONOTONIC (in nanoseconds) on the Posix host build, so every result
+ * is reported in the unit named by benchTIME_UNIT.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Samples recorded per measured operation. */
+#ifndef benchSAMPLE_COUNT
+    #define benchSAMPLE_COUNT    256
+#endif
+
+#define benchSTACK_SIZE          ( configMINIMAL_STACK_SIZE * 2 )
+
+#ifdef USE_HOST_SIM
+    #include <time.h>
+
+    #define benchTIME_UNIT    "ns"
+
+    static inline uint32_t ulBenchNow( void )
+    {
+        struct timespec xNow;
+
+        clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+        return ( uint32_t ) ( ( uint64_t ) xNow.tv_sec * 1000000000ULL + ( uint64_t ) xNow.tv_nsec );
+    }
+#else
+    #include "air32f10x.h"
+
+    #define benchTIME_UNIT    "cycles"
+
+    static inline uint32_t ulBenchNow( void )
+    {
+        return DWT->CYCCNT;
+    }
+#endif
+
+/* Start the cycle counter and print the table header. */
+void vBenchInit( void );
+
+/* Sort pulSamples in place and print one table row: name, unit, sample
+ * count, min, median, p99, max and mean. */
+void vBenchReport( const char * pcName,
+                   uint32_t * pulSamples,
+                   uint32_t ulCount );
+
+/* End of a benchmark run: stops the simulator on the host, deletes the
+ * calling task on target. */
+void vBenchDone( void );
+
+/* Create the task that runs the kernel primitive suite in kernel_bench.c. */
+void vStartKernelBenchmarks( UBaseType_t uxPriority );
+
+/* Software timer service task cost versus timer count (timer_bench.c).  Runs
+ * in the calling task, which must be below configTIMER_TASK_PRIORITY. */
+void vRunTimerBenchmarks( void );
+
+/* pvPortMalloc()/vPortFree() latency and fragmentation under a mixed
+ * allocation pattern (heap_bench.c).  Runs in the calling task. */
+void vRunHeapBenchmarks( void );
+
+/* Deadline misses of a periodic task set under rate monotonic priorities and
+ * under the EDF class (edf_bench.c).  Runs in the calling task, which blocks
+ * while the task set runs. */
+void vRunEDFBenchmarks( void );
+
+/* Order in which tasks spread over the whole priority range run, and wake
+ * latency at the lowest and highest priority (priority_bench.c).  Runs in the
+ * calling task, which must be at least one priority below
+ * configMAX_PRIORITIES - 1. */
+void vRunPriorityBenchmarks( void );
+
+/* Queue and mutex block and wake latency versus the number of tasks waiting
+ * on them (contention_bench.c).  Runs in the calling task, which must be at
+ * least one priority below configMAX_PRIORITIES - 1. */
+void vRunContentionBenchmarks( void );
+
+/* Hand-over of a contended mutex under priority inheritance and under the
+ * priority ceiling protocol (ceiling_bench.c).  Runs in the calling task, which
+ * must be at least one priority below configMAX_PRIORITIES - 1. */
+void vRunCeilingBenchmarks( void );
+
+/* Reader-writer lock fast path cost, and read throughput against a mutex as
+ * reader tasks are added (rw_lock_bench.c).  Runs in the calling task, which
+ * must be at least one priority below configMAX_PRIORITIES - 1. */
+void vRunRWLockBenchmarks( void );
+
+/* Interrupt work deferred to the timer task and to a work queue
+ * (work_queue_bench.c).  Runs in the calling task, which must be at least one
+ * priority below configMAX_PRIORITIES - 1 and below configTIMER_TASK_PRIORITY. */
+void vRunWorkQueueBenchmarks( void );
+
+/* Fan-out of a frame to several readers through a queue per reader against
+ * the zero-copy message bus, and the drops of a subscription that is not read
+ * (msg_bus_bench.c).  Runs in the calling task, which reads every subscription
+ * itself, so it has no priority constraint. */
+void vRunMsgBusBenchmarks( void );
+
+/* Wake latency of a task waiting on several queues with xWaitAny() against a
+ * task blocked on one queue (wait_any_bench.c).  Runs in the calling task,
+ * which must be at least one priority below configMAX_PRIORITIES - 1. */
+void vRunWaitAnyBenchmarks( void );
+
+/* RAM per state machine and switch cost of C++20 coroutines run by one task
+ * against a task per state machine (coroutine_bench.cpp).  Only built where
+ * the C++ benchmarks are (benchUSE_CPP).  Runs in the calling task, which must
+ * be at least one priority below configMAX_PRIORITIES - 1. */
+void vRunCoroutineBenchmarks( void );
+
+/* Queue and stream buffer calls through the typed C++ wrappers in static
+ * storage against the C API (cpp_wrapper_bench.cpp).  Only built with
+ * benchUSE_CPP.  Runs in the calling task. */
+void vRunCppWrapperBenchmarks( void );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /* BENCH_H */
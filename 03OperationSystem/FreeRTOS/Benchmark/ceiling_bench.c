@@ -0,0 +1,130 @@
+/*
+ * Hand-over of a contended mutex under priority inheritance and under the
+ * immediate priority ceiling protocol (configUSE_MUTEX_PRIORITY_CEILING).
+ *
+ * A low priority task takes the mutex, wakes a task one priority above it
+ * that takes the same mutex, and gives the mutex back:
+ *
+ *   mutex_round_inherit  with xSemaphoreCreateMutex().  The woken task
+ *                        pre-empts the holder, blocks on the mutex and lends
+ *                        it its priority, then runs again when the mutex is
+ *                        given: four context switches per round.
+ *   mutex_round_ceiling  with xSemaphoreCreateMutexWithCeiling() at the
+ *                        priority of the woken task.  The holder is not
+ *                        pre-empted, and the woken task runs once the holder
+ *                        drops from the ceiling and finds the mutex free: two
+ *                        context switches per round.
+ *
+ * Each row is the time from the take in the low priority task until it runs
+ * again after the round.  A "# mutex_ceiling" line per protocol reports how
+ * many times the woken task found the mutex taken.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+static uint32_t ulSamples[ benchSAMPLE_COUNT ];
+
+static SemaphoreHandle_t xBenchMutex;
+static TaskHandle_t xBenchTask;
+static TaskHandle_t xHighTask;
+static volatile uint32_t ulFoundTaken;
+/*-----------------------------------------------------------*/
+
+static void prvHighTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if( uxSemaphoreGetCount( xBenchMutex ) == 0U )
+        {
+            ulFoundTaken++;
+        }
+
+        ( void ) xSemaphoreTake( xBenchMutex, portMAX_DELAY );
+        ( void ) xSemaphoreGive( xBenchMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLowTask( void * pvParameters )
+{
+    uint32_t i, t0;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xSemaphoreTake( xBenchMutex, portMAX_DELAY );
+        xTaskNotifyGive( xHighTask );
+        ( void ) xSemaphoreGive( xBenchMutex );
+        ulSamples[ i ] = ulBenchNow() - t0;
+    }
+
+    xTaskNotifyGive( xBenchTask );
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunRounds( const char * pcProtocol,
+                          SemaphoreHandle_t xMutex,
+                          UBaseType_t uxPriority )
+{
+    TaskHandle_t xLowTask = NULL;
+    char cName[ 32 ];
+
+    xBenchMutex = xMutex;
+    configASSERT( xBenchMutex );
+    ulFoundTaken = 0;
+
+    xTaskCreate( prvHighTask, "high", benchSTACK_SIZE, NULL, uxPriority + 1, &xHighTask );
+    configASSERT( xHighTask );
+    xTaskCreate( prvLowTask, "low", benchSTACK_SIZE, NULL, uxPriority, &xLowTask );
+    configASSERT( xLowTask );
+
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    vTaskDelete( xLowTask );
+    vTaskDelete( xHighTask );
+    vSemaphoreDelete( xBenchMutex );
+
+    ( void ) snprintf( cName, sizeof( cName ), "mutex_round_%s", pcProtocol );
+    vBenchReport( cName, ulSamples, benchSAMPLE_COUNT );
+    printf( "# mutex_ceiling,protocol=%s,rounds=%lu,found_taken=%lu\n",
+            pcProtocol,
+            ( unsigned long ) benchSAMPLE_COUNT,
+            ( unsigned long ) ulFoundTaken );
+}
+/*-----------------------------------------------------------*/
+
+void vRunCeilingBenchmarks( void )
+{
+    const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+
+    configASSERT( uxPriority + 1 < configMAX_PRIORITIES );
+
+    xBenchTask = xTaskGetCurrentTaskHandle();
+
+    prvRunRounds( "inherit", xSemaphoreCreateMutex(), uxPriority );
+    prvRunRounds( "ceiling", xSemaphoreCreateMutexWithCeiling( uxPriority + 1 ), uxPriority );
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
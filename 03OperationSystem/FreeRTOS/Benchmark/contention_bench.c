@@ -0,0 +1,239 @@
+/*
+ * Block and wake latency of a queue and a mutex versus the number of tasks
+ * waiting on them.
+ *
+ * For each waiter count N, N tasks one priority above the benchmark task wait
+ * on the same object, so every task that blocks is queued behind the N - 1
+ * others of its priority:
+ *
+ *   queue_send_wake_N      the xQueueSend() call in the benchmark task until
+ *                          the waiter at the head of the queue's wait list is
+ *                          running.
+ *   queue_block_N          the xQueueReceive() call of that waiter on the
+ *                          then empty queue until the benchmark task is
+ *                          running again.
+ *   mutex_block_N          the xSemaphoreTake() call of one more task on a
+ *                          mutex that N waiters and a blocked holder keep
+ *                          taken, until the benchmark task is running again.
+ *                          The task gives up after one tick.  Only with
+ *                          configUSE_MUTEXES set to 1.
+ *
+ * Build once with configUSE_EVENT_LIST_INDEX set to 0 and once set to 1 to
+ * compare the sorted insert into the wait list against the indexed one.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+/* Largest number of tasks waiting on one object.  Each one takes a TCB and a
+ * stack from the FreeRTOS heap. */
+#ifndef benchCONTENTION_MAX_TASKS
+    #ifdef USE_HOST_SIM
+        #define benchCONTENTION_MAX_TASKS    32
+    #else
+        #define benchCONTENTION_MAX_TASKS    20
+    #endif
+#endif
+
+/* The waiters do nothing but block, so they get the smallest stack. */
+#define benchCONTENTION_STACK_SIZE           configMINIMAL_STACK_SIZE
+
+static const uint32_t ulWaiterCounts[] = { 1, 8, benchCONTENTION_MAX_TASKS };
+
+static uint32_t ulSamplesA[ benchSAMPLE_COUNT ];
+static uint32_t ulSamplesB[ benchSAMPLE_COUNT ];
+static TaskHandle_t xWaiters[ benchCONTENTION_MAX_TASKS ];
+
+static QueueHandle_t xContendedQueue;
+
+#if ( configUSE_MUTEXES == 1 )
+    static SemaphoreHandle_t xContendedMutex;
+    static TaskHandle_t xBenchTask;
+#endif
+
+static volatile uint32_t ulWakeStart;
+static volatile uint32_t ulBlockStart;
+static volatile uint32_t ulSampleIndex;
+/*-----------------------------------------------------------*/
+
+static void prvQueueWaiterTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulBlockStart = ulBenchNow();
+
+        if( xQueueReceive( xContendedQueue, &ulValue, portMAX_DELAY ) == pdPASS )
+        {
+            if( ulSampleIndex < benchSAMPLE_COUNT )
+            {
+                ulSamplesA[ ulSampleIndex ] = ulBenchNow() - ulWakeStart;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateWaiters( TaskFunction_t pxWaiter,
+                              uint32_t ulCount,
+                              UBaseType_t uxPriority )
+{
+    uint32_t i;
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        xTaskCreate( pxWaiter, "waiter", benchCONTENTION_STACK_SIZE, NULL, uxPriority, &xWaiters[ i ] );
+        configASSERT( xWaiters[ i ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeleteWaiters( uint32_t ulCount )
+{
+    uint32_t i;
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        vTaskDelete( xWaiters[ i ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueue( uint32_t ulWaiters,
+                           UBaseType_t uxPriority )
+{
+    char cName[ 32 ];
+    uint32_t i;
+
+    xContendedQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( xContendedQueue );
+
+    /* Each waiter runs straight away and blocks on the empty queue. */
+    prvCreateWaiters( prvQueueWaiterTask, ulWaiters, uxPriority + 1 );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ulSampleIndex = i;
+        ulWakeStart = ulBenchNow();
+        ( void ) xQueueSend( xContendedQueue, &i, 0 );
+
+        /* The woken waiter has taken the item and blocked again behind the
+         * other waiters. */
+        ulSamplesB[ i ] = ulBenchNow() - ulBlockStart;
+    }
+
+    prvDeleteWaiters( ulWaiters );
+    vQueueDelete( xContendedQueue );
+
+    ( void ) snprintf( cName, sizeof( cName ), "queue_send_wake_%lu", ( unsigned long ) ulWaiters );
+    vBenchReport( cName, ulSamplesA, benchSAMPLE_COUNT );
+    ( void ) snprintf( cName, sizeof( cName ), "queue_block_%lu", ( unsigned long ) ulWaiters );
+    vBenchReport( cName, ulSamplesB, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static void prvMutexWaiterTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        /* The holder never gives the mutex back. */
+        ( void ) xSemaphoreTake( xContendedMutex, portMAX_DELAY );
+
+        for( ; ; )
+        {
+            vTaskSuspend( NULL );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMutexProbeTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            ulBlockStart = ulBenchNow();
+            ( void ) xSemaphoreTake( xContendedMutex, 1 );
+
+            xTaskNotifyGive( xBenchTask );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchMutex( uint32_t ulWaiters,
+                               UBaseType_t uxPriority )
+    {
+        TaskHandle_t xHolder = NULL, xProbe = NULL;
+        char cName[ 32 ];
+        uint32_t i;
+
+        xContendedMutex = xSemaphoreCreateMutex();
+        configASSERT( xContendedMutex );
+
+        /* The holder runs first, takes the mutex and suspends itself.  The
+         * waiters after it block on the mutex and raise the holder to their
+         * priority, which changes nothing while it is suspended. */
+        xTaskCreate( prvMutexWaiterTask, "holder", benchCONTENTION_STACK_SIZE, NULL, uxPriority + 1, &xHolder );
+        configASSERT( xHolder );
+        prvCreateWaiters( prvMutexWaiterTask, ulWaiters, uxPriority + 1 );
+
+        xTaskCreate( prvMutexProbeTask, "probe", benchCONTENTION_STACK_SIZE, NULL, uxPriority + 1, &xProbe );
+        configASSERT( xProbe );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            xTaskNotifyGive( xProbe );
+            ulSamplesA[ i ] = ulBenchNow() - ulBlockStart;
+
+            /* Wait for the probe to time out before the next sample. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+
+        vTaskDelete( xProbe );
+        prvDeleteWaiters( ulWaiters );
+        vTaskDelete( xHolder );
+        vSemaphoreDelete( xContendedMutex );
+
+        ( void ) snprintf( cName, sizeof( cName ), "mutex_block_%lu", ( unsigned long ) ulWaiters );
+        vBenchReport( cName, ulSamplesA, benchSAMPLE_COUNT );
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+void vRunContentionBenchmarks( void )
+{
+    const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+    uint32_t i;
+
+    configASSERT( uxPriority + 1 < configMAX_PRIORITIES );
+
+    #if ( configUSE_MUTEXES == 1 )
+        xBenchTask = xTaskGetCurrentTaskHandle();
+    #endif
+
+    for( i = 0; i < ( sizeof( ulWaiterCounts ) / sizeof( ulWaiterCounts[ 0 ] ) ); i++ )
+    {
+        prvBenchQueue( ulWaiterCounts[ i ], uxPriority );
+
+        #if ( configUSE_MUTEXES == 1 )
+            prvBenchMutex( ulWaiterCounts[ i ], uxPriority );
+        #endif
+
+        /* Let the idle task free the deleted waiters. */
+        vTaskDelay( 2 );
+    }
+}
@@ -0,0 +1,298 @@
+/*
+ * State machines as C++20 coroutines run by one task (freertos/coroutine.hpp)
+ * against a task per state machine.
+ *
+ * RAM: benchCORO_MACHINES state machines that wait for a notification are
+ * created both ways, and a "# coroutine_ram" line reports the heap each one
+ * takes - its coroutine frame, or its TCB and configMINIMAL_STACK_SIZE stack -
+ * and the heap taken by the task that runs the coroutines, which is paid once.
+ *
+ * Switch cost, each row the time from one state machine handing over to the
+ * other until the other runs:
+ *
+ *   coroutine_switch     two coroutines of one executor notify each other
+ *                        with vCoroutineNotifyGive() and NotifyTake().
+ *   task_switch          two tasks of the same priority notify each other
+ *                        with xTaskNotifyGive() and ulTaskNotifyTake().
+ *   coroutine_queue_wake the benchmark task sends to a queue that a coroutine
+ *                        is waiting on with QueueReceive(), for comparison
+ *                        with queue_receive_wake of a task blocked on the
+ *                        queue.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "bench.h"
+
+#if ( ( configUSE_WAITERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+#include "freertos/coroutine.hpp"
+
+#define benchCORO_MACHINES    16
+
+using freertos::Coroutine;
+using freertos::CoroutineHandle_t;
+using freertos::Executor;
+
+static uint32_t ulSamples[ benchSAMPLE_COUNT ];
+
+static Executor xExecutor;
+static TaskHandle_t xBenchTask;
+
+static volatile BaseType_t xStopMachines;
+static volatile uint32_t ulHandOverTime;
+static CoroutineHandle_t xPingCoroutine;
+static CoroutineHandle_t xPongCoroutine;
+static TaskHandle_t xPingTask;
+static TaskHandle_t xPongTask;
+static QueueHandle_t xBenchQueue;
+/*-----------------------------------------------------------*/
+
+static void prvExecutorTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    xExecutor.run();
+
+    xTaskNotifyGive( xBenchTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvStartExecutor( void )
+{
+    TaskHandle_t xTask = NULL;
+
+    xTaskCreate( prvExecutorTask, "executor", benchSTACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1, &xTask );
+    configASSERT( xTask );
+
+    return xTask;
+}
+/*-----------------------------------------------------------*/
+
+static Coroutine prvMachineCoroutine( void )
+{
+    while( xStopMachines == pdFALSE )
+    {
+        ( void ) co_await freertos::NotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMachineTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchRam( void )
+{
+    CoroutineHandle_t xMachines[ benchCORO_MACHINES ];
+    TaskHandle_t xTasks[ benchCORO_MACHINES ];
+    size_t xFree, xCoroutineBytes, xTaskBytes, xExecutorBytes;
+    uint32_t i;
+
+    xStopMachines = pdFALSE;
+
+    xFree = xPortGetFreeHeapSize();
+
+    for( i = 0; i < benchCORO_MACHINES; i++ )
+    {
+        xMachines[ i ] = xExecutor.spawn( prvMachineCoroutine() );
+        configASSERT( xMachines[ i ] );
+    }
+
+    xCoroutineBytes = ( xFree - xPortGetFreeHeapSize() ) / benchCORO_MACHINES;
+
+    xFree = xPortGetFreeHeapSize();
+    ( void ) prvStartExecutor();
+    xExecutorBytes = xFree - xPortGetFreeHeapSize();
+
+    xFree = xPortGetFreeHeapSize();
+
+    for( i = 0; i < benchCORO_MACHINES; i++ )
+    {
+        xTasks[ i ] = NULL;
+        xTaskCreate( prvMachineTask, "machine", configMINIMAL_STACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1, &xTasks[ i ] );
+        configASSERT( xTasks[ i ] );
+    }
+
+    xTaskBytes = ( xFree - xPortGetFreeHeapSize() ) / benchCORO_MACHINES;
+
+    for( i = 0; i < benchCORO_MACHINES; i++ )
+    {
+        vTaskDelete( xTasks[ i ] );
+    }
+
+    /* Each coroutine returns once woken, and the executor task with them. */
+    xStopMachines = pdTRUE;
+
+    for( i = 0; i < benchCORO_MACHINES; i++ )
+    {
+        freertos::vCoroutineNotifyGive( xMachines[ i ] );
+    }
+
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    printf( "# coroutine_ram,machines=%lu,coroutine_bytes=%lu,task_bytes=%lu,executor_task_bytes=%lu\n",
+            ( unsigned long ) benchCORO_MACHINES,
+            ( unsigned long ) xCoroutineBytes,
+            ( unsigned long ) xTaskBytes,
+            ( unsigned long ) xExecutorBytes );
+}
+/*-----------------------------------------------------------*/
+
+static Coroutine prvPingCoroutine( void )
+{
+    uint32_t i;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ulHandOverTime = ulBenchNow();
+        freertos::vCoroutineNotifyGive( xPongCoroutine );
+        ( void ) co_await freertos::NotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static Coroutine prvPongCoroutine( void )
+{
+    uint32_t i;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ( void ) co_await freertos::NotifyTake( pdTRUE, portMAX_DELAY );
+        ulSamples[ i ] = ulBenchNow() - ulHandOverTime;
+        freertos::vCoroutineNotifyGive( xPingCoroutine );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void * pvParameters )
+{
+    uint32_t i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ulHandOverTime = ulBenchNow();
+        xTaskNotifyGive( xPongTask );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    xTaskNotifyGive( xBenchTask );
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void * pvParameters )
+{
+    uint32_t i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ulSamples[ i ] = ulBenchNow() - ulHandOverTime;
+        xTaskNotifyGive( xPingTask );
+    }
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchSwitch( void )
+{
+    /* The pong coroutine runs first and waits, as the pong task does. */
+    xPongCoroutine = xExecutor.spawn( prvPongCoroutine() );
+    xPingCoroutine = xExecutor.spawn( prvPingCoroutine() );
+    configASSERT( xPongCoroutine && xPingCoroutine );
+
+    ( void ) prvStartExecutor();
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    vBenchReport( "coroutine_switch", ulSamples, benchSAMPLE_COUNT );
+
+    xTaskCreate( prvPongTask, "pong", benchSTACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1, &xPongTask );
+    xTaskCreate( prvPingTask, "ping", benchSTACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1, &xPingTask );
+    configASSERT( xPongTask && xPingTask );
+
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    vTaskDelete( xPingTask );
+    vTaskDelete( xPongTask );
+    vBenchReport( "task_switch", ulSamples, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+static Coroutine prvReaderCoroutine( void )
+{
+    uint32_t i, ulSent;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        if( co_await freertos::QueueReceive( xBenchQueue, &ulSent, portMAX_DELAY ) == pdPASS )
+        {
+            ulSamples[ i ] = ulBenchNow() - ulSent;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueueWake( void )
+{
+    CoroutineHandle_t xReader;
+    uint32_t i, ulNow;
+
+    xBenchQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( xBenchQueue );
+
+    xReader = xExecutor.spawn( prvReaderCoroutine() );
+    configASSERT( xReader );
+    ( void ) xReader;
+    ( void ) prvStartExecutor();
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        /* The executor task pre-empts the send. */
+        ulNow = ulBenchNow();
+        ( void ) xQueueSend( xBenchQueue, &ulNow, 0 );
+    }
+
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    vQueueDelete( xBenchQueue );
+    vBenchReport( "coroutine_queue_wake", ulSamples, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+void vRunCoroutineBenchmarks( void )
+{
+    configASSERT( uxTaskPriorityGet( NULL ) + 1 < configMAX_PRIORITIES );
+
+    xBenchTask = xTaskGetCurrentTaskHandle();
+
+    prvBenchRam();
+    prvBenchSwitch();
+    prvBenchQueueWake();
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+
+#endif /* if ( ( configUSE_WAITERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
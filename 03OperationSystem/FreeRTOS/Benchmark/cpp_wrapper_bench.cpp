@@ -0,0 +1,252 @@
+/*
+ * The typed C++ wrappers of FreeRTOS-Cpp (freertos/queue.hpp and
+ * freertos/stream_buffer.hpp) against the C API they wrap.
+ *
+ * Each row is one call on an object nobody waits on, so no context switch:
+ *
+ *   c_queue_send_16 / c_queue_receive_16
+ *                               xQueueSend() and xQueueReceive() of a
+ *                               benchITEM_SIZE byte item.
+ *   cpp_queue_send_16 / cpp_queue_receive_16
+ *                               Queue<T, N>::send() and receive(), which call
+ *                               the same functions.
+ *   cpp_queue_send_in_place_16 / cpp_queue_receive_in_place_16
+ *                               Queue<T, N>::sendInPlace() and
+ *                               receiveInPlace(), which copy the item with a
+ *                               fixed-size copy through the zero-copy API.
+ *   c_stream_send_16 / cpp_stream_send_16 (and _receive_16)
+ *                               xStreamBufferSend() against
+ *                               StreamBuffer<N>::send().
+ *
+ * Every call goes through one of the prv...() functions below, which are kept
+ * out of line so that "make sizes" in Posix_GCC (or nm -S on the target
+ * object) shows the code each way of making the call costs at the call site.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#include "bench.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+#include "freertos/queue.hpp"
+#include "freertos/stream_buffer.hpp"
+
+#define benchITEM_SIZE       16
+#define benchQUEUE_LENGTH    4
+
+#define benchNO_INLINE       __attribute__( ( noinline ) )
+
+typedef struct BenchItem
+{
+    uint32_t ulWords[ benchITEM_SIZE / sizeof( uint32_t ) ];
+} BenchItem_t;
+
+static uint32_t ulSamplesA[ benchSAMPLE_COUNT ];
+static uint32_t ulSamplesB[ benchSAMPLE_COUNT ];
+
+static freertos::Queue< BenchItem_t, benchQUEUE_LENGTH > xCppQueue;
+static freertos::StreamBuffer< benchITEM_SIZE * benchQUEUE_LENGTH > xCppStream;
+/*-----------------------------------------------------------*/
+
+static benchNO_INLINE BaseType_t prvSendC( QueueHandle_t xQueue,
+                                           const BenchItem_t & xItem )
+{
+    return xQueueSend( xQueue, &xItem, 0 );
+}
+
+static benchNO_INLINE BaseType_t prvReceiveC( QueueHandle_t xQueue,
+                                              BenchItem_t & xItem )
+{
+    return xQueueReceive( xQueue, &xItem, 0 );
+}
+
+static benchNO_INLINE BaseType_t prvSendCpp( const BenchItem_t & xItem )
+{
+    return xCppQueue.send( xItem, 0 );
+}
+
+static benchNO_INLINE BaseType_t prvReceiveCpp( BenchItem_t & xItem )
+{
+    return xCppQueue.receive( xItem, 0 );
+}
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static benchNO_INLINE BaseType_t prvSendInPlace( const BenchItem_t & xItem )
+    {
+        return xCppQueue.sendInPlace( xItem, 0 );
+    }
+
+    static benchNO_INLINE BaseType_t prvReceiveInPlace( BenchItem_t & xItem )
+    {
+        return xCppQueue.receiveInPlace( xItem, 0 );
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+static benchNO_INLINE size_t prvStreamSendC( StreamBufferHandle_t xStream,
+                                             const BenchItem_t & xItem )
+{
+    return xStreamBufferSend( xStream, &xItem, sizeof( xItem ), 0 );
+}
+
+static benchNO_INLINE size_t prvStreamReceiveC( StreamBufferHandle_t xStream,
+                                                BenchItem_t & xItem )
+{
+    return xStreamBufferReceive( xStream, &xItem, sizeof( xItem ), 0 );
+}
+
+static benchNO_INLINE size_t prvStreamSendCpp( const BenchItem_t & xItem )
+{
+    return xCppStream.send( &xItem, sizeof( xItem ), 0 );
+}
+
+static benchNO_INLINE size_t prvStreamReceiveCpp( BenchItem_t & xItem )
+{
+    return xCppStream.receive( &xItem, sizeof( xItem ), 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueue( void )
+{
+    BenchItem_t xItem = { { 0 } };
+    QueueHandle_t xQueue;
+    uint32_t i, t0;
+
+    /* The C queue is created the same way as the wrapper's, so both differ
+     * only in how they are called. */
+    static StaticQueue_t xQueueBuffer;
+    static BenchItem_t xQueueStorage[ benchQUEUE_LENGTH ];
+
+    xQueue = xQueueCreateStatic( benchQUEUE_LENGTH, sizeof( BenchItem_t ), ( uint8_t * ) xQueueStorage, &xQueueBuffer );
+    configASSERT( xQueue );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        xItem.ulWords[ 0 ] = i;
+
+        t0 = ulBenchNow();
+        ( void ) prvSendC( xQueue, xItem );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) prvReceiveC( xQueue, xItem );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+
+        configASSERT( xItem.ulWords[ 0 ] == i );
+    }
+
+    vBenchReport( "c_queue_send_16", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "c_queue_receive_16", ulSamplesB, benchSAMPLE_COUNT );
+
+    vQueueDelete( xQueue );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        xItem.ulWords[ 0 ] = i;
+
+        t0 = ulBenchNow();
+        ( void ) prvSendCpp( xItem );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) prvReceiveCpp( xItem );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+
+        configASSERT( xItem.ulWords[ 0 ] == i );
+    }
+
+    vBenchReport( "cpp_queue_send_16", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "cpp_queue_receive_16", ulSamplesB, benchSAMPLE_COUNT );
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    {
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            xItem.ulWords[ 0 ] = i;
+
+            t0 = ulBenchNow();
+            ( void ) prvSendInPlace( xItem );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+            ( void ) prvReceiveInPlace( xItem );
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+
+            configASSERT( xItem.ulWords[ 0 ] == i );
+        }
+
+        vBenchReport( "cpp_queue_send_in_place_16", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "cpp_queue_receive_in_place_16", ulSamplesB, benchSAMPLE_COUNT );
+    }
+    #endif /* configUSE_QUEUE_ZERO_COPY */
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchStreamBuffer( void )
+{
+    BenchItem_t xItem = { { 0 } };
+    StreamBufferHandle_t xStream;
+    uint32_t i, t0;
+
+    static StaticStreamBuffer_t xStreamBuffer;
+    static uint8_t ucStreamStorage[ ( benchITEM_SIZE * benchQUEUE_LENGTH ) + 1 ];
+
+    xStream = xStreamBufferCreateStatic( sizeof( ucStreamStorage ), 1, ucStreamStorage, &xStreamBuffer );
+    configASSERT( xStream );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        xItem.ulWords[ 0 ] = i;
+
+        t0 = ulBenchNow();
+        ( void ) prvStreamSendC( xStream, xItem );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) prvStreamReceiveC( xStream, xItem );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+
+        configASSERT( xItem.ulWords[ 0 ] == i );
+    }
+
+    vBenchReport( "c_stream_send_16", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "c_stream_receive_16", ulSamplesB, benchSAMPLE_COUNT );
+
+    vStreamBufferDelete( xStream );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        xItem.ulWords[ 0 ] = i;
+
+        t0 = ulBenchNow();
+        ( void ) prvStreamSendCpp( xItem );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) prvStreamReceiveCpp( xItem );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+
+        configASSERT( xItem.ulWords[ 0 ] == i );
+    }
+
+    vBenchReport( "cpp_stream_send_16", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "cpp_stream_receive_16", ulSamplesB, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+void vRunCppWrapperBenchmarks( void )
+{
+    configASSERT( xCppStream.getSpacesAvailable() == ( benchITEM_SIZE * benchQUEUE_LENGTH ) );
+
+    prvBenchQueue();
+    prvBenchStreamBuffer();
+}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
@@ -0,0 +1,191 @@
+/*
+ * Schedulability of a periodic task set under fixed priorities and under the
+ * earliest deadline first class (configUSE_EDF_SCHEDULER).
+ *
+ * Two periodic tasks with deadlines equal to their periods, C = 20, T = 50
+ * and C = 35, T = 70 ticks, load the CPU to 90%.  They are released together
+ * and run for benchEDF_RUN_TICKS, first with each scheduling policy:
+ *
+ *   rm   rate monotonic priorities, the shorter period task one priority
+ *        above the other.  The worst case response time of the second task is
+ *        75 ticks, so some of its jobs miss their deadline.
+ *   edf  both tasks at configEDF_TASK_PRIORITY with vTaskSetEDFParameters(),
+ *        which meets every deadline of any such set up to 100% load.
+ *
+ * A job spins until it has been on the CPU for its execution time.  Only
+ * the time between consecutive time stamps less than benchEDF_GAP apart is
+ * counted, so the time the job spends pre-empted is left out.
+ *
+ * One "# edf_schedulability" line per policy and task reports the jobs
+ * completed, the jobs that completed after their deadline and the worst
+ * response time in ticks.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* Two hyperperiods of the task set per policy. */
+    #define benchEDF_RUN_TICKS       ( ( TickType_t ) 700 )
+
+/* Time for the tasks to be created and wait for the common release. */
+    #define benchEDF_START_DELAY     ( ( TickType_t ) 2 )
+
+    #define benchEDF_TASK_COUNT      2
+
+/* One tick in time stamp units, and the longest gap between two consecutive
+ * time stamps still counted as running. */
+    #ifdef USE_HOST_SIM
+        #define benchEDF_TICK_TIME    ( 1000000000UL / configTICK_RATE_HZ )
+        #define benchEDF_GAP          2000U
+    #else
+        #define benchEDF_TICK_TIME    ( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+        #define benchEDF_GAP          64U
+    #endif
+
+    #if ( ( configEDF_TASK_PRIORITY + 1 ) >= configMAX_PRIORITIES )
+        #error The rate monotonic run needs a priority above configEDF_TASK_PRIORITY.
+    #endif
+
+typedef struct BenchPeriodicTask
+{
+    TickType_t xCost;
+    TickType_t xPeriod;
+    volatile uint32_t ulJobs;
+    volatile uint32_t ulMisses;
+    volatile TickType_t xWorstResponse;
+} BenchPeriodicTask_t;
+
+static BenchPeriodicTask_t xBenchTasks[ benchEDF_TASK_COUNT ] =
+{
+    { 20, 50 },
+    { 35, 70 }
+};
+
+static TickType_t xBenchStart;
+/*-----------------------------------------------------------*/
+
+static void prvRunFor( TickType_t xTicks )
+{
+    uint32_t ulRan = 0, ulLast, ulNow;
+    const uint32_t ulCost = ( uint32_t ) xTicks * ( uint32_t ) benchEDF_TICK_TIME;
+
+    ulLast = ulBenchNow();
+
+    while( ulRan < ulCost )
+    {
+        ulNow = ulBenchNow();
+
+        if( ( ulNow - ulLast ) < benchEDF_GAP )
+        {
+            ulRan += ulNow - ulLast;
+        }
+
+        ulLast = ulNow;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void * pvParameters )
+{
+    BenchPeriodicTask_t * pxTask = ( BenchPeriodicTask_t * ) pvParameters;
+    TickType_t xRelease, xResponse;
+
+    /* The first job is released at xBenchStart. */
+    xRelease = xBenchStart - pxTask->xPeriod;
+    ( void ) xTaskDelayUntil( &xRelease, pxTask->xPeriod );
+
+    for( ; ; )
+    {
+        prvRunFor( pxTask->xCost );
+
+        xResponse = xTaskGetTickCount() - xRelease;
+
+        if( xResponse > pxTask->xWorstResponse )
+        {
+            pxTask->xWorstResponse = xResponse;
+        }
+
+        if( xResponse > pxTask->xPeriod )
+        {
+            pxTask->ulMisses++;
+        }
+
+        pxTask->ulJobs++;
+
+        ( void ) xTaskDelayUntil( &xRelease, pxTask->xPeriod );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTaskSet( const char * pcPolicy,
+                           BaseType_t xUseEDF )
+{
+    TaskHandle_t xHandles[ benchEDF_TASK_COUNT ];
+    UBaseType_t uxPriority;
+    uint32_t i;
+
+    /* Nothing runs until every task has its parameters. */
+    vTaskSuspendAll();
+    {
+        xBenchStart = xTaskGetTickCount() + benchEDF_START_DELAY;
+
+        for( i = 0; i < benchEDF_TASK_COUNT; i++ )
+        {
+            xBenchTasks[ i ].ulJobs = 0;
+            xBenchTasks[ i ].ulMisses = 0;
+            xBenchTasks[ i ].xWorstResponse = 0;
+
+            if( ( xUseEDF == pdFALSE ) && ( i == 0 ) )
+            {
+                uxPriority = configEDF_TASK_PRIORITY + 1;
+            }
+            else
+            {
+                uxPriority = configEDF_TASK_PRIORITY;
+            }
+
+            xTaskCreate( prvPeriodicTask, "periodic", benchSTACK_SIZE, &xBenchTasks[ i ], uxPriority, &xHandles[ i ] );
+            configASSERT( xHandles[ i ] );
+
+            if( xUseEDF != pdFALSE )
+            {
+                vTaskSetEDFParameters( xHandles[ i ], xBenchTasks[ i ].xPeriod, 0 );
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    vTaskDelay( benchEDF_START_DELAY + benchEDF_RUN_TICKS );
+
+    for( i = 0; i < benchEDF_TASK_COUNT; i++ )
+    {
+        vTaskDelete( xHandles[ i ] );
+    }
+
+    for( i = 0; i < benchEDF_TASK_COUNT; i++ )
+    {
+        printf( "# edf_schedulability,policy=%s,task=%lu,cost=%lu,period=%lu,jobs=%lu,misses=%lu,worst_response=%lu\n",
+                pcPolicy,
+                ( unsigned long ) ( i + 1U ),
+                ( unsigned long ) xBenchTasks[ i ].xCost,
+                ( unsigned long ) xBenchTasks[ i ].xPeriod,
+                ( unsigned long ) xBenchTasks[ i ].ulJobs,
+                ( unsigned long ) xBenchTasks[ i ].ulMisses,
+                ( unsigned long ) xBenchTasks[ i ].xWorstResponse );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vRunEDFBenchmarks( void )
+{
+    prvRunTaskSet( "rm", pdFALSE );
+    prvRunTaskSet( "edf", pdTRUE );
+}
+
+#endif /* configUSE_EDF_SCHEDULER */
@@ -0,0 +1,175 @@
+/*
+ * Worst-case latency and fragmentation of pvPortMalloc()/vPortFree() under a
+ * mixed, long running allocation pattern.
+ *
+ * benchHEAP_SLOTS pointers are filled with blocks of random size (mostly
+ * small, some medium, a few large) until the heap is most of the way full,
+ * then random slots are freed and re-allocated benchHEAP_OPS times, timing
+ * every call:
+ *
+ *   <heap>_malloc_mixed  pvPortMalloc() in the churn phase.
+ *   <heap>_free_mixed    vPortFree() in the churn phase.
+ *
+ * A second pattern leaves benchHEAP_SLOTS / 2 small holes below the rest of
+ * the free space, the worst case for a first fit search:
+ *
+ *   <heap>_malloc_past_holes  pvPortMalloc() of a block none of the holes
+ *                             can hold.
+ *
+ * At the end a "# <heap>_fragmentation" line reports the free space, the
+ * largest free block, the number of free blocks, the allocations that failed
+ * and the share of the free space not usable by one request.
+ *
+ * The host build links this once against heap_4.c and once against heap_6.c,
+ * and the Makefile names the heap through benchHEAP_IMPL.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#ifndef benchHEAP_IMPL
+    #define benchHEAP_IMPL    "heap"
+#endif
+
+/* Sized so the live blocks take most of configTOTAL_HEAP_SIZE, which is when
+ * the free space is split into the most pieces. */
+#ifdef USE_HOST_SIM
+    #define benchHEAP_SLOTS         1024
+    #define benchHEAP_OPS           16384
+    #define benchHEAP_MEDIUM_MAX    640U
+    #define benchHEAP_LARGE_MAX     2048U
+#else
+    #define benchHEAP_SLOTS         48
+    #define benchHEAP_OPS           1024
+    #define benchHEAP_MEDIUM_MAX    320U
+    #define benchHEAP_LARGE_MAX     1024U
+#endif
+
+/* Size of the small blocks used to punch holes in the heap. */
+#define benchHEAP_HOLE_SIZE    32U
+
+static uint32_t ulMallocSamples[ benchHEAP_OPS ];
+static uint32_t ulFreeSamples[ benchHEAP_OPS ];
+static void * pvSlots[ benchHEAP_SLOTS ];
+static uint32_t ulSeed = 1U;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    /* Numerical Recipes LCG, so every heap sees the same request sequence. */
+    ulSeed = ( ulSeed * 1664525U ) + 1013904223U;
+
+    return ulSeed >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvRandomSize( void )
+{
+    uint32_t ulClass = prvRandom() % 64U;
+
+    if( ulClass < 48U )
+    {
+        return 8U + ( prvRandom() % 120U );
+    }
+    else if( ulClass < 63U )
+    {
+        return 128U + ( prvRandom() % ( benchHEAP_MEDIUM_MAX - 128U ) );
+    }
+    else
+    {
+        return benchHEAP_MEDIUM_MAX + ( prvRandom() % ( benchHEAP_LARGE_MAX - benchHEAP_MEDIUM_MAX ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vRunHeapBenchmarks( void )
+{
+    uint32_t i, t0, ulMallocs = 0, ulFrees = 0, ulFailed = 0, ulSlot;
+    size_t xSize;
+    HeapStats_t xStats;
+
+    for( i = 0; i < benchHEAP_SLOTS; i++ )
+    {
+        pvSlots[ i ] = pvPortMalloc( prvRandomSize() );
+    }
+
+    for( i = 0; i < benchHEAP_OPS; i++ )
+    {
+        ulSlot = prvRandom() % benchHEAP_SLOTS;
+
+        if( pvSlots[ ulSlot ] != NULL )
+        {
+            t0 = ulBenchNow();
+            vPortFree( pvSlots[ ulSlot ] );
+            ulFreeSamples[ ulFrees++ ] = ulBenchNow() - t0;
+            pvSlots[ ulSlot ] = NULL;
+        }
+        else
+        {
+            xSize = prvRandomSize();
+
+            t0 = ulBenchNow();
+            pvSlots[ ulSlot ] = pvPortMalloc( xSize );
+            ulMallocSamples[ ulMallocs++ ] = ulBenchNow() - t0;
+
+            if( pvSlots[ ulSlot ] == NULL )
+            {
+                ulFailed++;
+            }
+        }
+    }
+
+    vPortGetHeapStats( &xStats );
+
+    vBenchReport( benchHEAP_IMPL "_malloc_mixed", ulMallocSamples, ulMallocs );
+    vBenchReport( benchHEAP_IMPL "_free_mixed", ulFreeSamples, ulFrees );
+
+    printf( "# " benchHEAP_IMPL "_fragmentation,free=%lu,largest=%lu,free_blocks=%lu,failed=%lu,unusable=%lu%%\n",
+            ( unsigned long ) xStats.xAvailableHeapSpaceInBytes,
+            ( unsigned long ) xStats.xSizeOfLargestFreeBlockInBytes,
+            ( unsigned long ) xStats.xNumberOfFreeBlocks,
+            ( unsigned long ) ulFailed,
+            ( unsigned long ) ( ( xStats.xAvailableHeapSpaceInBytes == 0U ) ? 0U :
+                                100U - ( ( xStats.xSizeOfLargestFreeBlockInBytes * 100U ) / xStats.xAvailableHeapSpaceInBytes ) ) );
+
+    for( i = 0; i < benchHEAP_SLOTS; i++ )
+    {
+        vPortFree( pvSlots[ i ] );
+        pvSlots[ i ] = NULL;
+    }
+
+    /* Small blocks with every other one freed again. */
+    for( i = 0; i < benchHEAP_SLOTS; i++ )
+    {
+        pvSlots[ i ] = pvPortMalloc( benchHEAP_HOLE_SIZE );
+    }
+
+    for( i = 0; i < benchHEAP_SLOTS; i += 2U )
+    {
+        vPortFree( pvSlots[ i ] );
+        pvSlots[ i ] = NULL;
+    }
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        void * pvBlock;
+
+        t0 = ulBenchNow();
+        pvBlock = pvPortMalloc( benchHEAP_HOLE_SIZE * 4U );
+        ulMallocSamples[ i ] = ulBenchNow() - t0;
+
+        vPortFree( pvBlock );
+    }
+
+    vBenchReport( benchHEAP_IMPL "_malloc_past_holes", ulMallocSamples, benchSAMPLE_COUNT );
+
+    for( i = 0; i < benchHEAP_SLOTS; i++ )
+    {
+        vPortFree( pvSlots[ i ] );
+        pvSlots[ i ] = NULL;
+    }
+}
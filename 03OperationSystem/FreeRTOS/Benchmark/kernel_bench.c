@@ -0,0 +1,916 @@
+/*
+ * Latency of the core kernel primitives.
+ *
+ * Each primitive is measured twice: the bare call with nobody waiting on the
+ * object (no context switch), and the time from the call in this task until
+ * a higher priority task blocked on the same object is running again (the
+ * "_wake" rows, which include the context switch).
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "spsc_ring.h"
+#include "mem_pool.h"
+#include "event_groups.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchSTREAM_CHUNK    16
+#define benchFRAME_SIZE      64
+#define benchDMA_BLOCK       256
+#define benchBURST           32
+#define benchPOOL_BLOCKS     8
+#define benchSNAPSHOT_TASKS  8
+
+typedef struct BenchWaiter
+{
+    void ( * pxWait )( void );
+} BenchWaiter_t;
+
+static uint32_t ulSamplesA[ benchSAMPLE_COUNT ];
+static uint32_t ulSamplesB[ benchSAMPLE_COUNT ];
+
+static UBaseType_t uxBenchPriority;
+static volatile uint32_t ulWakeStart;
+static volatile uint32_t ulWakeIndex;
+
+static QueueHandle_t xBenchQueue;
+static SemaphoreHandle_t xBenchSemaphore;
+static StreamBufferHandle_t xBenchStream;
+static SpscRingHandle_t xBenchRing;
+static EventGroupHandle_t xBenchEvents;
+static MemPoolHandle_t xBenchPool;
+/*-----------------------------------------------------------*/
+
+static void prvWakeLatencyTask( void * pvParameters )
+{
+    const BenchWaiter_t * pxWaiter = ( const BenchWaiter_t * ) pvParameters;
+
+    for( ; ; )
+    {
+        pxWaiter->pxWait();
+
+        if( ulWakeIndex < benchSAMPLE_COUNT )
+        {
+            ulSamplesB[ ulWakeIndex++ ] = ulBenchNow() - ulWakeStart;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Start a waiter one priority above the benchmark task, then time each
+ * pxSignal() call until the waiter has run. */
+static void prvMeasureWake( const char * pcName,
+                            const BenchWaiter_t * pxWaiter,
+                            void ( * pxSignal )( void ) )
+{
+    TaskHandle_t xWaiterTask = NULL;
+    uint32_t i;
+
+    ulWakeIndex = 0;
+    xTaskCreate( prvWakeLatencyTask, "wake", benchSTACK_SIZE, ( void * ) pxWaiter, uxBenchPriority + 1, &xWaiterTask );
+    configASSERT( xWaiterTask );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ulWakeStart = ulBenchNow();
+        pxSignal();
+    }
+
+    vTaskDelete( xWaiterTask );
+    vBenchReport( pcName, ulSamplesB, ulWakeIndex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTimerOverhead( void )
+{
+    uint32_t i, t0;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "timer_overhead", ulSamplesA, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueWait( void )
+{
+    uint32_t ulItem;
+
+    ( void ) xQueueReceive( xBenchQueue, &ulItem, portMAX_DELAY );
+}
+
+static void prvQueueSignal( void )
+{
+    uint32_t ulItem = 0;
+
+    ( void ) xQueueSend( xBenchQueue, &ulItem, portMAX_DELAY );
+}
+
+static void prvBenchQueue( void )
+{
+    static const BenchWaiter_t xWaiter = { prvQueueWait };
+    uint32_t i, t0, ulItem = 0;
+
+    xBenchQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( xBenchQueue );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xQueueSend( xBenchQueue, &ulItem, 0 );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xQueueReceive( xBenchQueue, &ulItem, 0 );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "queue_send", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "queue_receive", ulSamplesB, benchSAMPLE_COUNT );
+
+    prvMeasureWake( "queue_send_wake", &xWaiter, prvQueueSignal );
+
+    vQueueDelete( xBenchQueue );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* A benchFRAME_SIZE item written and read through copies, then in place. */
+    static void prvBenchQueueZeroCopy( void )
+    {
+        static uint8_t ucFrame[ benchFRAME_SIZE ];
+        uint32_t i, t0;
+        void * pvItem;
+
+        xBenchQueue = xQueueCreate( 1, benchFRAME_SIZE );
+        configASSERT( xBenchQueue );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            ucFrame[ 0 ] = ( uint8_t ) i;
+
+            t0 = ulBenchNow();
+            ( void ) xQueueSend( xBenchQueue, ucFrame, 0 );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+            ( void ) xQueueReceive( xBenchQueue, ucFrame, 0 );
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "queue_send_64", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "queue_receive_64", ulSamplesB, benchSAMPLE_COUNT );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+
+            if( xQueueReserve( xBenchQueue, &pvItem, 0 ) == pdPASS )
+            {
+                ( ( uint8_t * ) pvItem )[ 0 ] = ( uint8_t ) i;
+                ( void ) xQueueCommit( xBenchQueue );
+            }
+
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+
+            if( xQueuePeekRef( xBenchQueue, &pvItem, 0 ) == pdPASS )
+            {
+                ucFrame[ 0 ] = ( ( uint8_t * ) pvItem )[ 0 ];
+                ( void ) xQueueRelease( xBenchQueue );
+            }
+
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "queue_reserve_commit_64", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "queue_peekref_release_64", ulSamplesB, benchSAMPLE_COUNT );
+
+        vQueueDelete( xBenchQueue );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+    static volatile uint32_t ulBurstReceived;
+
+/* Drains the burst queue one item at a time (pvParameters NULL) or with
+ * xQueueReceiveMultiple(). */
+    static void prvBurstReceiverTask( void * pvParameters )
+    {
+        uint32_t ulItems[ benchBURST ];
+
+        for( ; ; )
+        {
+            if( pvParameters == NULL )
+            {
+                ( void ) xQueueReceive( xBenchQueue, ulItems, portMAX_DELAY );
+                ulBurstReceived++;
+            }
+            else
+            {
+                ulBurstReceived += xQueueReceiveMultiple( xBenchQueue, ulItems, benchBURST, portMAX_DELAY );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/* One row per burst of benchBURST items: sent and received with per-item
+ * calls, then with the batch calls, then handed to a higher priority receiver
+ * both ways. */
+    static void prvBenchQueueBatch( void )
+    {
+        uint32_t ulItems[ benchBURST ] = { 0 };
+        uint32_t i, j, t0;
+        TaskHandle_t xReceiver = NULL;
+
+        xBenchQueue = xQueueCreate( benchBURST, sizeof( uint32_t ) );
+        configASSERT( xBenchQueue );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+
+            for( j = 0; j < benchBURST; j++ )
+            {
+                ( void ) xQueueSend( xBenchQueue, &( ulItems[ j ] ), 0 );
+            }
+
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+
+            for( j = 0; j < benchBURST; j++ )
+            {
+                ( void ) xQueueReceive( xBenchQueue, &( ulItems[ j ] ), 0 );
+            }
+
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "queue_send_x32", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "queue_receive_x32", ulSamplesB, benchSAMPLE_COUNT );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            ( void ) xQueueSendMultiple( xBenchQueue, ulItems, benchBURST, 0 );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+            ( void ) xQueueReceiveMultiple( xBenchQueue, ulItems, benchBURST, 0 );
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "queue_send_multiple_32", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "queue_receive_multiple_32", ulSamplesB, benchSAMPLE_COUNT );
+
+        /* With a receiver waiting, every per-item send switches to it and
+         * back, while a batch wakes it once. */
+        ulBurstReceived = 0;
+        xTaskCreate( prvBurstReceiverTask, "burst", benchSTACK_SIZE, NULL, uxBenchPriority + 1, &xReceiver );
+        configASSERT( xReceiver );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+
+            for( j = 0; j < benchBURST; j++ )
+            {
+                ( void ) xQueueSend( xBenchQueue, &( ulItems[ j ] ), portMAX_DELAY );
+            }
+
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+        }
+
+        vTaskDelete( xReceiver );
+        configASSERT( ulBurstReceived == ( benchSAMPLE_COUNT * benchBURST ) );
+        vBenchReport( "queue_send_x32_wake", ulSamplesA, benchSAMPLE_COUNT );
+
+        ulBurstReceived = 0;
+        xTaskCreate( prvBurstReceiverTask, "burst", benchSTACK_SIZE, ( void * ) xBenchQueue, uxBenchPriority + 1, &xReceiver );
+        configASSERT( xReceiver );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            ( void ) xQueueSendMultiple( xBenchQueue, ulItems, benchBURST, portMAX_DELAY );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+        }
+
+        vTaskDelete( xReceiver );
+        configASSERT( ulBurstReceived == ( benchSAMPLE_COUNT * benchBURST ) );
+        vBenchReport( "queue_send_multiple_32_wake", ulSamplesA, benchSAMPLE_COUNT );
+
+        vQueueDelete( xBenchQueue );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_QUEUE_BATCH */
+
+static void prvSemaphoreWait( void )
+{
+    ( void ) xSemaphoreTake( xBenchSemaphore, portMAX_DELAY );
+}
+
+static void prvSemaphoreSignal( void )
+{
+    ( void ) xSemaphoreGive( xBenchSemaphore );
+}
+
+static void prvBenchSemaphore( void )
+{
+    static const BenchWaiter_t xWaiter = { prvSemaphoreWait };
+    uint32_t i, t0;
+
+    xBenchSemaphore = xSemaphoreCreateBinary();
+    configASSERT( xBenchSemaphore );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xSemaphoreGive( xBenchSemaphore );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xSemaphoreTake( xBenchSemaphore, 0 );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "semaphore_give", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "semaphore_take", ulSamplesB, benchSAMPLE_COUNT );
+
+    prvMeasureWake( "semaphore_give_wake", &xWaiter, prvSemaphoreSignal );
+
+    vSemaphoreDelete( xBenchSemaphore );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+/* Uncontended take and give, which configUSE_MUTEX_FAST_PATH turns into a
+ * compare and swap each. */
+    static void prvBenchMutex( void )
+    {
+        SemaphoreHandle_t xMutex;
+        uint32_t i, t0;
+
+        xMutex = xSemaphoreCreateMutex();
+        configASSERT( xMutex );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            ( void ) xSemaphoreTake( xMutex, 0 );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+            ( void ) xSemaphoreGive( xMutex );
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "mutex_take", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "mutex_give", ulSamplesB, benchSAMPLE_COUNT );
+
+        vSemaphoreDelete( xMutex );
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xNotifyTarget;
+
+static void prvNotifyWait( void )
+{
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+}
+
+static void prvNotifySignal( void )
+{
+    ( void ) xTaskNotifyGive( xNotifyTarget );
+}
+
+static void prvBenchNotify( void )
+{
+    static const BenchWaiter_t xWaiter = { prvNotifyWait };
+    TaskHandle_t xSelf = xTaskGetCurrentTaskHandle();
+    TaskHandle_t xWaiterTask = NULL;
+    uint32_t i, t0;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xTaskNotifyGive( xSelf );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "task_notify", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "task_notify_take", ulSamplesB, benchSAMPLE_COUNT );
+
+    /* The waiter needs its own handle as the notification target, so it
+     * cannot go through prvMeasureWake(). */
+    ulWakeIndex = 0;
+    xTaskCreate( prvWakeLatencyTask, "wake", benchSTACK_SIZE, ( void * ) &xWaiter, uxBenchPriority + 1, &xWaiterTask );
+    configASSERT( xWaiterTask );
+    xNotifyTarget = xWaiterTask;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ulWakeStart = ulBenchNow();
+        prvNotifySignal();
+    }
+
+    vTaskDelete( xWaiterTask );
+    vBenchReport( "task_notify_wake", ulSamplesB, ulWakeIndex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamWait( void )
+{
+    uint8_t ucChunk[ benchSTREAM_CHUNK ];
+
+    ( void ) xStreamBufferReceive( xBenchStream, ucChunk, sizeof( ucChunk ), portMAX_DELAY );
+}
+
+static void prvStreamSignal( void )
+{
+    static const uint8_t ucChunk[ benchSTREAM_CHUNK ] = { 0 };
+
+    ( void ) xStreamBufferSend( xBenchStream, ucChunk, sizeof( ucChunk ), portMAX_DELAY );
+}
+
+static void prvBenchStreamBuffer( void )
+{
+    static const BenchWaiter_t xWaiter = { prvStreamWait };
+    uint8_t ucChunk[ benchSTREAM_CHUNK ] = { 0 };
+    uint32_t i, t0;
+
+    xBenchStream = xStreamBufferCreate( benchSTREAM_CHUNK * 4, 1 );
+    configASSERT( xBenchStream );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xStreamBufferSend( xBenchStream, ucChunk, sizeof( ucChunk ), 0 );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xStreamBufferReceive( xBenchStream, ucChunk, sizeof( ucChunk ), 0 );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "stream_send_16", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "stream_receive_16", ulSamplesB, benchSAMPLE_COUNT );
+
+    prvMeasureWake( "stream_send_16_wake", &xWaiter, prvStreamSignal );
+
+    vStreamBufferDelete( xBenchStream );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/* A benchDMA_BLOCK block moved through copies, then produced and consumed in
+ * place the way a DMA engine and an in-place parser would. */
+    static void prvBenchStreamZeroCopy( void )
+    {
+        static uint8_t ucBlock[ benchDMA_BLOCK ];
+        uint32_t i, t0;
+        size_t xLength;
+        void * pvRegion;
+
+        /* The storage area is one byte longer than the size requested, so this
+         * makes it exactly four blocks and no block ever straddles the end. */
+        xBenchStream = xStreamBufferCreate( ( benchDMA_BLOCK * 4 ) - 1, 1 );
+        configASSERT( xBenchStream );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            ( void ) xStreamBufferSend( xBenchStream, ucBlock, sizeof( ucBlock ), 0 );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+            ( void ) xStreamBufferReceive( xBenchStream, ucBlock, sizeof( ucBlock ), 0 );
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "stream_send_256", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "stream_receive_256", ulSamplesB, benchSAMPLE_COUNT );
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            xLength = xStreamBufferAcquireWrite( xBenchStream, &pvRegion, 0 );
+            configASSERT( xLength >= benchDMA_BLOCK );
+            ( void ) xStreamBufferCommitWrite( xBenchStream, benchDMA_BLOCK );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            t0 = ulBenchNow();
+            xLength = xStreamBufferAcquireRead( xBenchStream, &pvRegion, 0 );
+            configASSERT( xLength == benchDMA_BLOCK );
+            ( void ) xStreamBufferReleaseRead( xBenchStream, xLength );
+            ulSamplesB[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "stream_acquire_commit_256", ulSamplesA, benchSAMPLE_COUNT );
+        vBenchReport( "stream_acquire_release_256", ulSamplesB, benchSAMPLE_COUNT );
+
+        vStreamBufferDelete( xBenchStream );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+static void prvRingWait( void )
+{
+    uint8_t ucByte;
+
+    /* The waiter is created afresh by each prvMeasureWake(), so it registers
+     * itself here, outside the timed window. */
+    vSpscRingSetNotification( xBenchRing, xTaskGetCurrentTaskHandle(), 0 );
+    ( void ) xSpscRingReceive( xBenchRing, &ucByte, portMAX_DELAY );
+}
+
+static void prvRingSignal( void )
+{
+    const uint8_t ucByte = 0;
+
+    ( void ) xSpscRingPush( xBenchRing, &ucByte );
+}
+
+static void prvStreamByteSignal( void )
+{
+    const uint8_t ucByte = 0;
+
+    ( void ) xStreamBufferSend( xBenchStream, &ucByte, sizeof( ucByte ), portMAX_DELAY );
+}
+
+static void prvStreamByteWait( void )
+{
+    uint8_t ucByte;
+
+    ( void ) xStreamBufferReceive( xBenchStream, &ucByte, sizeof( ucByte ), portMAX_DELAY );
+}
+
+/* Single bytes, as a USART receive interrupt would hand them to a task,
+ * through a stream buffer and through the lock-free ring. */
+static void prvBenchSpscRing( void )
+{
+    static const BenchWaiter_t xStreamWaiter = { prvStreamByteWait };
+    static const BenchWaiter_t xRingWaiter = { prvRingWait };
+    uint8_t ucByte = 0;
+    uint32_t i, t0;
+
+    xBenchStream = xStreamBufferCreate( benchBURST, 1 );
+    configASSERT( xBenchStream );
+    xBenchRing = xSpscRingCreate( benchBURST, sizeof( uint8_t ) );
+    configASSERT( xBenchRing );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xStreamBufferSend( xBenchStream, &ucByte, sizeof( ucByte ), 0 );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xStreamBufferReceive( xBenchStream, &ucByte, sizeof( ucByte ), 0 );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "stream_send_1", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "stream_receive_1", ulSamplesB, benchSAMPLE_COUNT );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xSpscRingPush( xBenchRing, &ucByte );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xSpscRingPop( xBenchRing, &ucByte );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "spsc_push_1", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "spsc_pop_1", ulSamplesB, benchSAMPLE_COUNT );
+
+    prvMeasureWake( "stream_send_1_wake", &xStreamWaiter, prvStreamByteSignal );
+    prvMeasureWake( "spsc_push_1_wake", &xRingWaiter, prvRingSignal );
+
+    vSpscRingDelete( xBenchRing );
+    vStreamBufferDelete( xBenchStream );
+}
+/*-----------------------------------------------------------*/
+
+/* A 64 byte frame buffer taken from a pool and from the heap. */
+static void prvBenchMemPool( void )
+{
+    void * pvBlock;
+    uint32_t i, t0;
+
+    xBenchPool = xMemPoolCreate( benchFRAME_SIZE, benchPOOL_BLOCKS );
+    configASSERT( xBenchPool );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        pvBlock = pvMemPoolAlloc( xBenchPool );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        vMemPoolFree( xBenchPool, pvBlock );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "pool_alloc_64", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "pool_free_64", ulSamplesB, benchSAMPLE_COUNT );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        pvBlock = pvPortMalloc( benchFRAME_SIZE );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        vPortFree( pvBlock );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "heap_malloc_64", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "heap_free_64", ulSamplesB, benchSAMPLE_COUNT );
+
+    vMemPoolDelete( xBenchPool );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( void )
+{
+    ( void ) xEventGroupWaitBits( xBenchEvents, 0x01, pdTRUE, pdFALSE, portMAX_DELAY );
+}
+
+static void prvEventSignal( void )
+{
+    ( void ) xEventGroupSetBits( xBenchEvents, 0x01 );
+}
+
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+/* Called from this task with interrupts masked, the way an interrupt handler
+ * would call it. */
+    static void prvEventSignalFromISR( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        ( void ) xEventGroupSetBitsFromISR( xBenchEvents, 0x01, &xHigherPriorityTaskWoken );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+
+#endif /* configUSE_EVENT_GROUP_ISR_FAST_PATH */
+
+#if ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+
+/* What xEventGroupSetBitsFromISR() does without the fast path: the set is
+ * deferred to the timer task. */
+    static void prvEventSignalDeferred( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        ( void ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xBenchEvents, 0x01, &xHigherPriorityTaskWoken );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+
+static void prvBenchEventGroup( void )
+{
+    static const BenchWaiter_t xWaiter = { prvEventWait };
+    uint32_t i, t0;
+
+    xBenchEvents = xEventGroupCreate();
+    configASSERT( xBenchEvents );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xEventGroupSetBits( xBenchEvents, 0x01 );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        ( void ) xEventGroupClearBits( xBenchEvents, 0x01 );
+    }
+
+    vBenchReport( "event_group_set", ulSamplesA, benchSAMPLE_COUNT );
+
+    prvMeasureWake( "event_group_set_wake", &xWaiter, prvEventSignal );
+
+    /* Interrupt side: the call with nobody waiting (for the deferred path this
+     * includes the timer task running the set), then the time until a waiting
+     * task runs. */
+    #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+    {
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            prvEventSignalFromISR();
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            ( void ) xEventGroupClearBits( xBenchEvents, 0x01 );
+        }
+
+        vBenchReport( "event_group_set_isr", ulSamplesA, benchSAMPLE_COUNT );
+
+        prvMeasureWake( "event_group_set_isr_wake", &xWaiter, prvEventSignalFromISR );
+    }
+    #endif
+
+    #if ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    {
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            prvEventSignalDeferred();
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+
+            ( void ) xEventGroupClearBits( xBenchEvents, 0x01 );
+        }
+
+        vBenchReport( "event_group_set_isr_deferred", ulSamplesA, benchSAMPLE_COUNT );
+
+        prvMeasureWake( "event_group_set_isr_deferred_wake", &xWaiter, prvEventSignalDeferred );
+    }
+    #endif
+
+    vEventGroupDelete( xBenchEvents );
+}
+/*-----------------------------------------------------------*/
+
+static volatile uint32_t ulYieldStamp;
+
+static void prvYieldTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulYieldStamp = ulBenchNow();
+        taskYIELD();
+    }
+}
+
+static void prvBenchContextSwitch( void )
+{
+    TaskHandle_t xYieldTask = NULL;
+    uint32_t i;
+
+    /* A peer at the same priority, so every taskYIELD() is a forced
+     * vTaskSwitchContext() to the other task. */
+    xTaskCreate( prvYieldTask, "yield", benchSTACK_SIZE, NULL, uxBenchPriority, &xYieldTask );
+    configASSERT( xYieldTask );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        taskYIELD();
+        ulSamplesA[ i ] = ulBenchNow() - ulYieldStamp;
+    }
+
+    vTaskDelete( xYieldTask );
+    vBenchReport( "task_yield_switch", ulSamplesA, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    static void prvBenchRunTimeSnapshot( void )
+    {
+        TaskRunTimeSnapshot_t xSnapshot[ benchSNAPSHOT_TASKS ];
+        uint32_t i, t0;
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            ( void ) uxTaskGetRunTimeSnapshot( xSnapshot, benchSNAPSHOT_TASKS, NULL );
+            ulSamplesA[ i ] = ulBenchNow() - t0;
+        }
+
+        vBenchReport( "run_time_snapshot", ulSamplesA, benchSAMPLE_COUNT );
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+static void prvKernelBenchTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vBenchInit();
+
+    prvBenchTimerOverhead();
+    prvBenchQueue();
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        prvBenchQueueZeroCopy();
+    #endif
+
+    #if ( configUSE_QUEUE_BATCH == 1 )
+        prvBenchQueueBatch();
+    #endif
+
+    prvBenchSemaphore();
+
+    #if ( configUSE_MUTEXES == 1 )
+        prvBenchMutex();
+    #endif
+
+    vRunPriorityBenchmarks();
+    vRunContentionBenchmarks();
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        vRunCeilingBenchmarks();
+    #endif
+
+    vRunRWLockBenchmarks();
+
+    #if ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+        vRunWorkQueueBenchmarks();
+    #endif
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        vRunMsgBusBenchmarks();
+    #endif
+
+    #if ( configUSE_WAITERS == 1 )
+        vRunWaitAnyBenchmarks();
+    #endif
+
+    #if ( defined( benchUSE_CPP ) && ( configUSE_WAITERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        vRunCoroutineBenchmarks();
+    #endif
+
+    #if ( defined( benchUSE_CPP ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        vRunCppWrapperBenchmarks();
+    #endif
+
+    prvBenchNotify();
+    prvBenchStreamBuffer();
+
+    #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+        prvBenchStreamZeroCopy();
+    #endif
+
+    prvBenchSpscRing();
+    prvBenchMemPool();
+
+    prvBenchEventGroup();
+    prvBenchContextSwitch();
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        prvBenchRunTimeSnapshot();
+    #endif
+
+    vRunHeapBenchmarks();
+
+    #if ( configUSE_TIMERS == 1 )
+        vRunTimerBenchmarks();
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        vRunEDFBenchmarks();
+    #endif
+
+    vBenchDone();
+}
+/*-----------------------------------------------------------*/
+
+void vStartKernelBenchmarks( UBaseType_t uxPriority )
+{
+    configASSERT( uxPriority + 1 < configMAX_PRIORITIES );
+
+    uxBenchPriority = uxPriority;
+    xTaskCreate( prvKernelBenchTask, "bench", benchSTACK_SIZE, NULL, uxPriority, NULL );
+}
@@ -0,0 +1,199 @@
+/*
+ * Fan-out of a frame to several readers by copying it into a queue per reader,
+ * and by publishing it on a message bus (msg_bus.h), where each reader gets a
+ * pointer to the one buffer.
+ *
+ * A benchMSG_FRAME_SIZE byte frame goes to benchMSG_SUBSCRIBERS readers, each
+ * of which is then read by the benchmark task itself:
+ *
+ *   msg_fanout_queue_publish   xQueueSend() of the frame to each reader's
+ *                              queue, one copy per reader.
+ *   msg_fanout_queue_receive   xQueueReceive() from each queue, one more copy.
+ *   msg_fanout_bus_publish     pvMsgBusAlloc(), writing the frame into the
+ *                              buffer, and uxMsgBusPublish().
+ *   msg_fanout_bus_receive     pvMsgBusReceive() and vMsgBusRelease() for each
+ *                              subscription.
+ *
+ * The bus trades the copies for critical sections around the reference count,
+ * one per publish and one per release.  On the Posix port a critical section
+ * masks signals with a system call and costs more than copying the frame, so
+ * the host rows favour the queues; on the Cortex-M3 it is a write to BASEPRI.
+ *
+ * Then benchMSG_BURST messages are published to a subscription with a backlog
+ * of benchMSG_BACKLOG that is not read.  A "# msg_bus" line reports how many
+ * were delivered and dropped, and how many buffers are free after the
+ * subscription is dropped, which must be all of them.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "msg_bus.h"
+
+#include "bench.h"
+
+#define benchMSG_FRAME_SIZE     256
+#define benchMSG_SUBSCRIBERS    3
+#define benchMSG_BACKLOG        4
+#define benchMSG_BURST          10
+
+static uint32_t ulSamplesA[ benchSAMPLE_COUNT ];
+static uint32_t ulSamplesB[ benchSAMPLE_COUNT ];
+
+static uint8_t ucFrame[ benchMSG_FRAME_SIZE ];
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueueFanout( void )
+{
+    QueueHandle_t xQueues[ benchMSG_SUBSCRIBERS ];
+    uint8_t ucReceived[ benchMSG_FRAME_SIZE ];
+    uint32_t i, j, t0, t1, t2;
+
+    for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+    {
+        xQueues[ j ] = xQueueCreate( 1, benchMSG_FRAME_SIZE );
+        configASSERT( xQueues[ j ] );
+    }
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ucFrame[ 0 ] = ( uint8_t ) i;
+
+        t0 = ulBenchNow();
+
+        for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+        {
+            ( void ) xQueueSend( xQueues[ j ], ucFrame, 0 );
+        }
+
+        t1 = ulBenchNow();
+
+        for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+        {
+            ( void ) xQueueReceive( xQueues[ j ], ucReceived, 0 );
+            configASSERT( ucReceived[ 0 ] == ( uint8_t ) i );
+        }
+
+        t2 = ulBenchNow();
+
+        ulSamplesA[ i ] = t1 - t0;
+        ulSamplesB[ i ] = t2 - t1;
+    }
+
+    for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+    {
+        vQueueDelete( xQueues[ j ] );
+    }
+
+    vBenchReport( "msg_fanout_queue_publish", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "msg_fanout_queue_receive", ulSamplesB, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchBusFanout( MsgBusHandle_t xBus )
+{
+    MsgTopicHandle_t xTopic;
+    MsgSubscriberHandle_t xSubscribers[ benchMSG_SUBSCRIBERS ];
+    uint8_t * pucMessage;
+    uint32_t i, j, t0, t1, t2;
+
+    xTopic = xMsgBusCreateTopic( xBus );
+    configASSERT( xTopic );
+
+    for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+    {
+        xSubscribers[ j ] = xMsgBusSubscribe( xTopic, 1 );
+        configASSERT( xSubscribers[ j ] );
+    }
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ucFrame[ 0 ] = ( uint8_t ) i;
+
+        t0 = ulBenchNow();
+
+        pucMessage = ( uint8_t * ) pvMsgBusAlloc( xBus );
+        configASSERT( pucMessage );
+        memcpy( pucMessage, ucFrame, benchMSG_FRAME_SIZE );
+        ( void ) uxMsgBusPublish( xTopic, pucMessage, benchMSG_FRAME_SIZE );
+
+        t1 = ulBenchNow();
+
+        for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+        {
+            pucMessage = ( uint8_t * ) pvMsgBusReceive( xSubscribers[ j ], 0 );
+            configASSERT( pucMessage && ( pucMessage[ 0 ] == ( uint8_t ) i ) );
+            vMsgBusRelease( pucMessage );
+        }
+
+        t2 = ulBenchNow();
+
+        ulSamplesA[ i ] = t1 - t0;
+        ulSamplesB[ i ] = t2 - t1;
+    }
+
+    for( j = 0; j < benchMSG_SUBSCRIBERS; j++ )
+    {
+        vMsgBusUnsubscribe( xSubscribers[ j ] );
+    }
+
+    vMsgBusDeleteTopic( xTopic );
+
+    vBenchReport( "msg_fanout_bus_publish", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "msg_fanout_bus_receive", ulSamplesB, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchBusBacklog( MsgBusHandle_t xBus )
+{
+    MsgTopicHandle_t xTopic;
+    MsgSubscriberHandle_t xSubscriber;
+    void * pvMessage;
+    uint32_t i, ulDelivered = 0;
+
+    xTopic = xMsgBusCreateTopic( xBus );
+    configASSERT( xTopic );
+    xSubscriber = xMsgBusSubscribe( xTopic, benchMSG_BACKLOG );
+    configASSERT( xSubscriber );
+
+    for( i = 0; i < benchMSG_BURST; i++ )
+    {
+        /* The subscription holds at most benchMSG_BACKLOG buffers, so one is
+         * always free. */
+        pvMessage = pvMsgBusAlloc( xBus );
+        configASSERT( pvMessage );
+        ulDelivered += ( uint32_t ) uxMsgBusPublish( xTopic, pvMessage, 0 );
+    }
+
+    printf( "# msg_bus,backlog=%lu,published=%lu,delivered=%lu,dropped=%lu,",
+            ( unsigned long ) benchMSG_BACKLOG,
+            ( unsigned long ) benchMSG_BURST,
+            ( unsigned long ) ulDelivered,
+            ( unsigned long ) ulMsgBusGetDropCount( xSubscriber ) );
+
+    vMsgBusUnsubscribe( xSubscriber );
+    vMsgBusDeleteTopic( xTopic );
+
+    printf( "buffers=%lu,free=%lu\n",
+            ( unsigned long ) ( benchMSG_BACKLOG + 1 ),
+            ( unsigned long ) uxMsgBusGetFreeMessageCount( xBus ) );
+}
+/*-----------------------------------------------------------*/
+
+void vRunMsgBusBenchmarks( void )
+{
+    MsgBusHandle_t xBus;
+
+    prvBenchQueueFanout();
+
+    xBus = xMsgBusCreate( benchMSG_FRAME_SIZE, benchMSG_BACKLOG + 1 );
+    configASSERT( xBus );
+
+    prvBenchBusFanout( xBus );
+    prvBenchBusBacklog( xBus );
+
+    vMsgBusDelete( xBus );
+}
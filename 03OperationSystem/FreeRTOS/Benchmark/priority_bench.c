@@ -0,0 +1,163 @@
+/*
+ * Selection of the highest priority ready task across the whole priority
+ * range, which above 32 priorities goes through the two level ready bit map of
+ * the port ("make prio256" in Posix_GCC builds the benchmarks with 256
+ * priorities).
+ *
+ * benchPRIORITY_TASKS tasks with priorities spread from one above the
+ * benchmark task up to configMAX_PRIORITIES - 1 are made ready together with
+ * the scheduler suspended, in an order that is not their priority order.  Each
+ * records its priority when it runs and suspends itself, so they must run in
+ * descending priority order.  They are then resumed together once more, which
+ * sets their ready bits again after they were cleared.  A "# task_selection"
+ * line reports the tasks run and how many ran before a task of a higher
+ * priority, which must be none.
+ *
+ *   task_select_wake_low   time from xTaskNotifyGive() until a task one
+ *                          priority above the benchmark task is running.
+ *   task_select_wake_high  the same for a task at configMAX_PRIORITIES - 1,
+ *                          which is in the top word of a two level bit map.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define benchPRIORITY_TASKS     16
+#define benchPRIORITY_ROUNDS    2
+
+/* Coprime with benchPRIORITY_TASKS, so the tasks are created out of priority
+ * order. */
+#define benchPRIORITY_STRIDE    7
+
+static uint32_t ulSamples[ benchSAMPLE_COUNT ];
+
+static UBaseType_t uxRunOrder[ benchPRIORITY_TASKS * benchPRIORITY_ROUNDS ];
+static volatile uint32_t ulRuns;
+static volatile uint32_t ulWakeStart;
+static volatile uint32_t ulWakeIndex;
+/*-----------------------------------------------------------*/
+
+static void prvLadderTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( ulRuns < ( benchPRIORITY_TASKS * benchPRIORITY_ROUNDS ) )
+        {
+            uxRunOrder[ ulRuns++ ] = uxTaskPriorityGet( NULL );
+        }
+
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunSelection( void )
+{
+    TaskHandle_t xTasks[ benchPRIORITY_TASKS ];
+    const UBaseType_t uxLowest = uxTaskPriorityGet( NULL ) + 1;
+    const UBaseType_t uxSpan = ( UBaseType_t ) configMAX_PRIORITIES - 1 - uxLowest;
+    UBaseType_t uxPriority, uxRound;
+    uint32_t i, ulOutOfOrder = 0;
+
+    ulRuns = 0;
+
+    vTaskSuspendAll();
+    {
+        for( i = 0; i < benchPRIORITY_TASKS; i++ )
+        {
+            uxPriority = uxLowest + ( ( ( i * benchPRIORITY_STRIDE ) % benchPRIORITY_TASKS ) * uxSpan ) / ( benchPRIORITY_TASKS - 1 );
+            xTasks[ i ] = NULL;
+            xTaskCreate( prvLadderTask, "ladder", benchSTACK_SIZE, NULL, uxPriority, &( xTasks[ i ] ) );
+            configASSERT( xTasks[ i ] );
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    for( uxRound = 1; uxRound < benchPRIORITY_ROUNDS; uxRound++ )
+    {
+        vTaskSuspendAll();
+        {
+            for( i = 0; i < benchPRIORITY_TASKS; i++ )
+            {
+                vTaskResume( xTasks[ i ] );
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+    /* Each round must run from the highest priority down. */
+    for( i = 1; i < ulRuns; i++ )
+    {
+        if( ( ( i % benchPRIORITY_TASKS ) != 0U ) && ( uxRunOrder[ i ] > uxRunOrder[ i - 1 ] ) )
+        {
+            ulOutOfOrder++;
+        }
+    }
+
+    printf( "# task_selection,priorities=%lu,tasks=%lu,runs=%lu,out_of_order=%lu\n",
+            ( unsigned long ) configMAX_PRIORITIES,
+            ( unsigned long ) benchPRIORITY_TASKS,
+            ( unsigned long ) ulRuns,
+            ( unsigned long ) ulOutOfOrder );
+
+    for( i = 0; i < benchPRIORITY_TASKS; i++ )
+    {
+        vTaskDelete( xTasks[ i ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if( ulWakeIndex < benchSAMPLE_COUNT )
+        {
+            ulSamples[ ulWakeIndex++ ] = ulBenchNow() - ulWakeStart;
+        }
+    }
+}
+
+static void prvMeasureWake( const char * pcName,
+                            UBaseType_t uxPriority )
+{
+    TaskHandle_t xWakeTask = NULL;
+    uint32_t i;
+
+    ulWakeIndex = 0;
+    xTaskCreate( prvWakeTask, "wake", benchSTACK_SIZE, NULL, uxPriority, &xWakeTask );
+    configASSERT( xWakeTask );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        ulWakeStart = ulBenchNow();
+        xTaskNotifyGive( xWakeTask );
+    }
+
+    vTaskDelete( xWakeTask );
+    vBenchReport( pcName, ulSamples, ulWakeIndex );
+}
+/*-----------------------------------------------------------*/
+
+void vRunPriorityBenchmarks( void )
+{
+    configASSERT( uxTaskPriorityGet( NULL ) + 1 < configMAX_PRIORITIES );
+
+    prvRunSelection();
+
+    prvMeasureWake( "task_select_wake_low", uxTaskPriorityGet( NULL ) + 1 );
+    prvMeasureWake( "task_select_wake_high", configMAX_PRIORITIES - 1 );
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
@@ -0,0 +1,304 @@
+/*
+ * Reader-writer lock (rw_lock.h) cost and read throughput against a mutex.
+ *
+ *   rw_lock_read_take    xRWLockTakeRead() and xRWLockGiveRead() on a lock
+ *   rw_lock_read_give    nobody waits for: the compare and swap fast path.
+ *   rw_lock_write_take   xRWLockTakeWrite() and xRWLockGiveWrite(), likewise.
+ *   rw_lock_write_give
+ *
+ * Then, for each reader count N, N tasks at the priority of the benchmark task
+ * read a table under the lock in a loop for benchRW_LOCK_RUN_TICKS ticks,
+ * time sliced, while a writer one priority above rewrites the table every
+ * benchRW_LOCK_WRITE_PERIOD ticks.  Once with a reader-writer lock, and once
+ * with a mutex taken by readers and writer alike.  A "# rw_lock" line per run
+ * reports the reads done by all readers together and the number of reads that
+ * saw a half written table, which must be 0.
+ *
+ * With the mutex, a reader pre-empted at the end of its time slice while it
+ * holds the mutex makes each of the other readers block in turn.  With the
+ * reader-writer lock they keep reading, so the read count holds up as readers
+ * are added.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rw_lock.h"
+
+#include "bench.h"
+
+/* Words in the shared table.  A read sums all of them. */
+#define benchRW_LOCK_TABLE_SIZE       64
+
+#define benchRW_LOCK_RUN_TICKS        pdMS_TO_TICKS( 50 )
+#define benchRW_LOCK_WRITE_PERIOD     pdMS_TO_TICKS( 5 )
+#define benchRW_LOCK_STACK_SIZE       configMINIMAL_STACK_SIZE
+#define benchRW_LOCK_MAX_READERS      8
+
+typedef struct BenchLock
+{
+    const char * pcName;
+    void ( * pvTakeRead )( void );
+    void ( * pvGiveRead )( void );
+    void ( * pvTakeWrite )( void );
+    void ( * pvGiveWrite )( void );
+} BenchLock_t;
+
+static const uint32_t ulReaderCounts[] = { 1, 2, 4, benchRW_LOCK_MAX_READERS };
+
+static uint32_t ulSamplesA[ benchSAMPLE_COUNT ];
+static uint32_t ulSamplesB[ benchSAMPLE_COUNT ];
+
+static const BenchLock_t * pxBenchLock;
+static RWLockHandle_t xBenchRWLock;
+static TaskHandle_t xBenchTask;
+
+static volatile uint32_t ulTable[ benchRW_LOCK_TABLE_SIZE ];
+static volatile uint32_t ulReads[ benchRW_LOCK_MAX_READERS ];
+static volatile uint32_t ulTornReads;
+static volatile uint32_t ulWrites;
+static volatile BaseType_t xStop;
+/*-----------------------------------------------------------*/
+
+static void prvRWLockTakeRead( void )
+{
+    ( void ) xRWLockTakeRead( xBenchRWLock, portMAX_DELAY );
+}
+
+static void prvRWLockGiveRead( void )
+{
+    ( void ) xRWLockGiveRead( xBenchRWLock );
+}
+
+static void prvRWLockTakeWrite( void )
+{
+    ( void ) xRWLockTakeWrite( xBenchRWLock, portMAX_DELAY );
+}
+
+static void prvRWLockGiveWrite( void )
+{
+    ( void ) xRWLockGiveWrite( xBenchRWLock );
+}
+
+static const BenchLock_t xRWLockOps =
+{
+    "rw_lock", prvRWLockTakeRead, prvRWLockGiveRead, prvRWLockTakeWrite, prvRWLockGiveWrite
+};
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static SemaphoreHandle_t xBenchMutex;
+
+    static void prvMutexTake( void )
+    {
+        ( void ) xSemaphoreTake( xBenchMutex, portMAX_DELAY );
+    }
+
+    static void prvMutexGive( void )
+    {
+        ( void ) xSemaphoreGive( xBenchMutex );
+    }
+
+    static const BenchLock_t xMutexOps =
+    {
+        "mutex", prvMutexTake, prvMutexGive, prvMutexTake, prvMutexGive
+    };
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    volatile uint32_t * const pulReads = ( volatile uint32_t * ) pvParameters;
+    uint32_t i, ulSum;
+
+    while( xStop == pdFALSE )
+    {
+        pxBenchLock->pvTakeRead();
+
+        ulSum = 0;
+
+        for( i = 0; i < benchRW_LOCK_TABLE_SIZE; i++ )
+        {
+            ulSum += ulTable[ i ];
+        }
+
+        /* The writer stores the same value in every word. */
+        if( ulSum != ( ulTable[ 0 ] * benchRW_LOCK_TABLE_SIZE ) )
+        {
+            ulTornReads++;
+        }
+
+        pxBenchLock->pvGiveRead();
+
+        ( *pulReads )++;
+    }
+
+    xTaskNotifyGive( xBenchTask );
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void * pvParameters )
+{
+    uint32_t i;
+
+    ( void ) pvParameters;
+
+    while( xStop == pdFALSE )
+    {
+        vTaskDelay( benchRW_LOCK_WRITE_PERIOD );
+
+        pxBenchLock->pvTakeWrite();
+
+        for( i = 0; i < benchRW_LOCK_TABLE_SIZE; i++ )
+        {
+            ulTable[ i ] = ulWrites + 1U;
+        }
+
+        ulWrites++;
+        pxBenchLock->pvGiveWrite();
+    }
+
+    xTaskNotifyGive( xBenchTask );
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunReaders( const BenchLock_t * pxLock,
+                           uint32_t ulReaders,
+                           UBaseType_t uxPriority )
+{
+    TaskHandle_t xReaders[ benchRW_LOCK_MAX_READERS ];
+    TaskHandle_t xWriter = NULL;
+    uint32_t i, ulTotal = 0;
+
+    pxBenchLock = pxLock;
+    xStop = pdFALSE;
+    ulTornReads = 0;
+    ulWrites = 0;
+
+    for( i = 0; i < benchRW_LOCK_TABLE_SIZE; i++ )
+    {
+        ulTable[ i ] = 0;
+    }
+
+    xTaskCreate( prvWriterTask, "writer", benchRW_LOCK_STACK_SIZE, NULL, uxPriority + 1, &xWriter );
+    configASSERT( xWriter );
+
+    for( i = 0; i < ulReaders; i++ )
+    {
+        ulReads[ i ] = 0;
+        xTaskCreate( prvReaderTask, "reader", benchRW_LOCK_STACK_SIZE, ( void * ) &( ulReads[ i ] ), uxPriority, &xReaders[ i ] );
+        configASSERT( xReaders[ i ] );
+    }
+
+    vTaskDelay( benchRW_LOCK_RUN_TICKS );
+    xStop = pdTRUE;
+
+    /* Every task gives the lock back before it stops. */
+    for( i = 0; i < ( ulReaders + 1U ); i++ )
+    {
+        ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+    }
+
+    for( i = 0; i < ulReaders; i++ )
+    {
+        vTaskDelete( xReaders[ i ] );
+        ulTotal += ulReads[ i ];
+    }
+
+    vTaskDelete( xWriter );
+
+    printf( "# rw_lock,lock=%s,readers=%lu,ticks=%lu,reads=%lu,writes=%lu,torn=%lu\n",
+            pxLock->pcName,
+            ( unsigned long ) ulReaders,
+            ( unsigned long ) benchRW_LOCK_RUN_TICKS,
+            ( unsigned long ) ulTotal,
+            ( unsigned long ) ulWrites,
+            ( unsigned long ) ulTornReads );
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchUncontended( void )
+{
+    uint32_t i, t0;
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xRWLockTakeRead( xBenchRWLock, 0 );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xRWLockGiveRead( xBenchRWLock );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "rw_lock_read_take", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "rw_lock_read_give", ulSamplesB, benchSAMPLE_COUNT );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        t0 = ulBenchNow();
+        ( void ) xRWLockTakeWrite( xBenchRWLock, 0 );
+        ulSamplesA[ i ] = ulBenchNow() - t0;
+
+        t0 = ulBenchNow();
+        ( void ) xRWLockGiveWrite( xBenchRWLock );
+        ulSamplesB[ i ] = ulBenchNow() - t0;
+    }
+
+    vBenchReport( "rw_lock_write_take", ulSamplesA, benchSAMPLE_COUNT );
+    vBenchReport( "rw_lock_write_give", ulSamplesB, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+void vRunRWLockBenchmarks( void )
+{
+    const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+    uint32_t i;
+
+    configASSERT( uxPriority + 1 < configMAX_PRIORITIES );
+
+    xBenchTask = xTaskGetCurrentTaskHandle();
+
+    xBenchRWLock = xRWLockCreate();
+    configASSERT( xBenchRWLock );
+
+    #if ( configUSE_MUTEXES == 1 )
+        xBenchMutex = xSemaphoreCreateMutex();
+        configASSERT( xBenchMutex );
+    #endif
+
+    prvBenchUncontended();
+
+    for( i = 0; i < ( sizeof( ulReaderCounts ) / sizeof( ulReaderCounts[ 0 ] ) ); i++ )
+    {
+        prvRunReaders( &xRWLockOps, ulReaderCounts[ i ], uxPriority );
+
+        #if ( configUSE_MUTEXES == 1 )
+            prvRunReaders( &xMutexOps, ulReaderCounts[ i ], uxPriority );
+        #endif
+    }
+
+    #if ( configUSE_MUTEXES == 1 )
+        vSemaphoreDelete( xBenchMutex );
+    #endif
+
+    vRWLockDelete( xBenchRWLock );
+}
@@ -0,0 +1,151 @@
+/*
+ * Cost of the software timer service task versus the number of timers.
+ *
+ * For each timer count N, N auto-reload timers with short, mixed periods are
+ * left running while two things are measured from the benchmark task, which
+ * runs below the timer service task:
+ *
+ *   timer_reset_N        the xTimerReset() call, including the timer task
+ *                        pre-empting it to re-insert the timer.
+ *   timer_daemon_tick_N  the time the benchmark task loses in each tick while
+ *                        spinning, i.e. the tick interrupt plus the timer task
+ *                        processing the timers that expired.  N = 0 is the
+ *                        baseline with no timer running.
+ *
+ * Build once with configUSE_TIMER_WHEEL set to 0 and once set to 1 to compare
+ * the sorted active list against the timing wheel.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+/* Largest number of timers created at once.  Each one takes a Timer_t from
+ * the FreeRTOS heap. */
+#ifndef benchTIMER_MAX_COUNT
+    #ifdef USE_HOST_SIM
+        #define benchTIMER_MAX_COUNT    1024
+    #else
+        #define benchTIMER_MAX_COUNT    64
+    #endif
+#endif
+
+/* Timer periods are spread over 1 to benchTIMER_PERIOD_SPREAD ticks, so on
+ * average N / ( benchTIMER_PERIOD_SPREAD / 2 ) timers expire every tick. */
+#define benchTIMER_PERIOD_SPREAD    20U
+
+/* Reset commands use a period well beyond the running timers so the re-insert
+ * lands behind all of them in the sorted list. */
+#define benchTIMER_RESET_PERIOD     pdMS_TO_TICKS( 1000 )
+
+/* A gap between two consecutive time stamps in the spin loop longer than this
+ * means the benchmark task was pre-empted. */
+#ifdef USE_HOST_SIM
+    #define benchTIMER_GAP          2000U
+#else
+    #define benchTIMER_GAP          64U
+#endif
+
+static uint32_t ulSamples[ benchSAMPLE_COUNT ];
+static TimerHandle_t xBenchTimers[ benchTIMER_MAX_COUNT ];
+static volatile uint32_t ulExpiries;
+/*-----------------------------------------------------------*/
+
+static void prvBenchTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    ulExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+/* Spin for benchSAMPLE_COUNT ticks, recording how long this task was kept
+ * off the CPU during each of them. */
+static void prvMeasureDaemonTicks( const char * pcName )
+{
+    uint32_t ulIndex = 0, ulLast, ulNow, ulStolen = 0;
+    TickType_t xTick, xLastTick;
+
+    /* Start on a tick boundary. */
+    vTaskDelay( 1 );
+    xLastTick = xTaskGetTickCount();
+    ulLast = ulBenchNow();
+
+    while( ulIndex < benchSAMPLE_COUNT )
+    {
+        ulNow = ulBenchNow();
+
+        if( ( ulNow - ulLast ) > benchTIMER_GAP )
+        {
+            ulStolen += ulNow - ulLast;
+        }
+
+        ulLast = ulNow;
+        xTick = xTaskGetTickCount();
+
+        if( xTick != xLastTick )
+        {
+            ulSamples[ ulIndex++ ] = ulStolen;
+            ulStolen = 0;
+            xLastTick = xTick;
+        }
+    }
+
+    vBenchReport( pcName, ulSamples, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTimerCount( uint32_t ulCount )
+{
+    char cName[ 32 ];
+    uint32_t i, t0;
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        xBenchTimers[ i ] = xTimerCreate( "bt", 1U + ( i % benchTIMER_PERIOD_SPREAD ), pdTRUE, NULL, prvBenchTimerCallback );
+        configASSERT( xBenchTimers[ i ] );
+        ( void ) xTimerStart( xBenchTimers[ i ], portMAX_DELAY );
+    }
+
+    /* Give each timer a long period first so the measured reset re-inserts
+     * it behind every running timer, then restore its short period. */
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        TimerHandle_t xTimer = xBenchTimers[ i % ulCount ];
+
+        ( void ) xTimerChangePeriod( xTimer, benchTIMER_RESET_PERIOD, portMAX_DELAY );
+
+        t0 = ulBenchNow();
+        ( void ) xTimerReset( xTimer, portMAX_DELAY );
+        ulSamples[ i ] = ulBenchNow() - t0;
+
+        ( void ) xTimerChangePeriod( xTimer, 1U + ( ( i % ulCount ) % benchTIMER_PERIOD_SPREAD ), portMAX_DELAY );
+    }
+
+    snprintf( cName, sizeof( cName ), "timer_reset_%lu", ( unsigned long ) ulCount );
+    vBenchReport( cName, ulSamples, benchSAMPLE_COUNT );
+
+    snprintf( cName, sizeof( cName ), "timer_daemon_tick_%lu", ( unsigned long ) ulCount );
+    prvMeasureDaemonTicks( cName );
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        ( void ) xTimerDelete( xBenchTimers[ i ], portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vRunTimerBenchmarks( void )
+{
+    uint32_t ulCount;
+
+    prvMeasureDaemonTicks( "timer_daemon_tick_0" );
+
+    for( ulCount = 16; ulCount <= benchTIMER_MAX_COUNT; ulCount *= 4U )
+    {
+        prvBenchTimerCount( ulCount );
+    }
+}
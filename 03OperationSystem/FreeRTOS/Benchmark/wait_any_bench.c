@@ -0,0 +1,281 @@
+/*
+ * Wake latency of a task that waits on several queues at once with a waiter
+ * (waiter.h), against a task that is blocked on a single queue.
+ *
+ * A server task one priority above the benchmark task waits for the queues,
+ * and the benchmark task sends the time stamp of the send to one of them:
+ *
+ *   queue_receive_wake  the server is blocked in xQueueReceive() on the one
+ *                       queue.
+ *   wait_any_wake       the server is blocked in xWaitAny() on a waiter with
+ *                       benchWAIT_ANY_SOURCES queues, and the item goes to
+ *                       each of the queues in turn.
+ *   queue_set_wake      the same with a queue set and xQueueSelectFromSet(),
+ *                       when configUSE_QUEUE_SETS is 1.
+ *
+ * Each row is the time from the send until the server has received the item.
+ *
+ * Then an item is sent to every queue with the scheduler suspended.  A
+ * "# wait_any" line reports how many times the server was woken for them, which
+ * must be once, and the ready bits it was woken with.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "waiter.h"
+
+#include "bench.h"
+
+#if ( configUSE_WAITERS == 1 )
+
+#define benchWAIT_ANY_SOURCES    8
+
+static uint32_t ulSamples[ benchSAMPLE_COUNT ];
+
+static QueueHandle_t xQueues[ benchWAIT_ANY_SOURCES ];
+static WaiterHandle_t xBenchWaiter;
+static volatile uint32_t ulReceived;
+static volatile uint32_t ulWakes;
+static volatile uint32_t ulLastReadyBits;
+static volatile BaseType_t xStopServer;
+/*-----------------------------------------------------------*/
+
+static void prvRecord( uint32_t ulSent )
+{
+    uint32_t ulNow = ulBenchNow();
+
+    if( ulReceived < benchSAMPLE_COUNT )
+    {
+        ulSamples[ ulReceived ] = ulNow - ulSent;
+    }
+
+    ulReceived++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueServerTask( void * pvParameters )
+{
+    uint32_t ulSent;
+
+    ( void ) pvParameters;
+
+    while( xStopServer == pdFALSE )
+    {
+        if( xQueueReceive( xQueues[ 0 ], &ulSent, portMAX_DELAY ) == pdPASS )
+        {
+            prvRecord( ulSent );
+        }
+    }
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitAnyServerTask( void * pvParameters )
+{
+    uint32_t ulSent, ulReadyBits;
+    UBaseType_t x;
+
+    ( void ) pvParameters;
+
+    while( xStopServer == pdFALSE )
+    {
+        if( xWaitAny( xBenchWaiter, &ulReadyBits, portMAX_DELAY ) == pdPASS )
+        {
+            ulWakes++;
+            ulLastReadyBits = ulReadyBits;
+
+            for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+            {
+                if( ( ulReadyBits & ( 1UL << x ) ) != 0U )
+                {
+                    while( xQueueReceive( xQueues[ x ], &ulSent, 0 ) == pdPASS )
+                    {
+                        prvRecord( ulSent );
+                    }
+                }
+            }
+        }
+    }
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    static QueueSetHandle_t xBenchSet;
+
+    static void prvQueueSetServerTask( void * pvParameters )
+    {
+        QueueSetMemberHandle_t xMember;
+        uint32_t ulSent;
+
+        ( void ) pvParameters;
+
+        while( xStopServer == pdFALSE )
+        {
+            xMember = xQueueSelectFromSet( xBenchSet, portMAX_DELAY );
+
+            if( ( xMember != NULL ) && ( xQueueReceive( ( QueueHandle_t ) xMember, &ulSent, 0 ) == pdPASS ) )
+            {
+                prvRecord( ulSent );
+            }
+        }
+
+        for( ; ; )
+        {
+            vTaskSuspend( NULL );
+        }
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+static void prvStopServer( TaskHandle_t xServer )
+{
+    uint32_t ulNow = ulBenchNow();
+
+    /* Wake the server once more so it is not waiting when it is deleted, as a
+     * waiter cannot be deleted with a task waiting on it. */
+    xStopServer = pdTRUE;
+    ( void ) xQueueSend( xQueues[ 0 ], &ulNow, 0 );
+    vTaskDelete( xServer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunWakes( const char * pcName,
+                         TaskFunction_t pxServer,
+                         UBaseType_t uxSources )
+{
+    TaskHandle_t xServer = NULL;
+    uint32_t i, ulNow;
+
+    ulReceived = 0;
+    xStopServer = pdFALSE;
+
+    xTaskCreate( pxServer, "server", benchSTACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1, &xServer );
+    configASSERT( xServer );
+
+    for( i = 0; i < benchSAMPLE_COUNT; i++ )
+    {
+        /* The server pre-empts the send. */
+        ulNow = ulBenchNow();
+        ( void ) xQueueSend( xQueues[ i % uxSources ], &ulNow, 0 );
+    }
+
+    configASSERT( ulReceived == benchSAMPLE_COUNT );
+
+    prvStopServer( xServer );
+    vBenchReport( pcName, ulSamples, benchSAMPLE_COUNT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunBurst( void )
+{
+    TaskHandle_t xServer = NULL;
+    uint32_t ulNow;
+    UBaseType_t x;
+
+    ulReceived = 0;
+    ulWakes = 0;
+    ulLastReadyBits = 0;
+    xStopServer = pdFALSE;
+
+    xTaskCreate( prvWaitAnyServerTask, "server", benchSTACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1, &xServer );
+    configASSERT( xServer );
+
+    vTaskSuspendAll();
+    {
+        ulNow = ulBenchNow();
+
+        for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+        {
+            ( void ) xQueueSend( xQueues[ x ], &ulNow, 0 );
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    printf( "# wait_any,sources=%lu,sent=%lu,received=%lu,burst_wakes=%lu,ready_bits=0x%lx\n",
+            ( unsigned long ) benchWAIT_ANY_SOURCES,
+            ( unsigned long ) benchWAIT_ANY_SOURCES,
+            ( unsigned long ) ulReceived,
+            ( unsigned long ) ulWakes,
+            ( unsigned long ) ulLastReadyBits );
+
+    prvStopServer( xServer );
+}
+/*-----------------------------------------------------------*/
+
+void vRunWaitAnyBenchmarks( void )
+{
+    UBaseType_t x;
+
+    configASSERT( uxTaskPriorityGet( NULL ) + 1 < configMAX_PRIORITIES );
+
+    for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+    {
+        xQueues[ x ] = xQueueCreate( 1, sizeof( uint32_t ) );
+        configASSERT( xQueues[ x ] );
+    }
+
+    prvRunWakes( "queue_receive_wake", prvQueueServerTask, 1 );
+
+    xBenchWaiter = xWaiterCreate();
+    configASSERT( xBenchWaiter );
+
+    for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+    {
+        ( void ) xWaiterAddQueue( xBenchWaiter, xQueues[ x ], 1UL << x );
+    }
+
+    prvRunWakes( "wait_any_wake", prvWaitAnyServerTask, benchWAIT_ANY_SOURCES );
+    prvRunBurst();
+
+    for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+    {
+        ( void ) xWaiterRemoveQueue( xBenchWaiter, xQueues[ x ] );
+    }
+
+    vWaiterDelete( xBenchWaiter );
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        xBenchSet = xQueueCreateSet( benchWAIT_ANY_SOURCES );
+        configASSERT( xBenchSet );
+
+        for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+        {
+            ( void ) xQueueAddToSet( xQueues[ x ], xBenchSet );
+        }
+
+        prvRunWakes( "queue_set_wake", prvQueueSetServerTask, benchWAIT_ANY_SOURCES );
+
+        for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+        {
+            ( void ) xQueueRemoveFromSet( xQueues[ x ], xBenchSet );
+        }
+
+        vQueueDelete( xBenchSet );
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    for( x = 0; x < benchWAIT_ANY_SOURCES; x++ )
+    {
+        vQueueDelete( xQueues[ x ] );
+    }
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+
+#endif /* configUSE_WAITERS */
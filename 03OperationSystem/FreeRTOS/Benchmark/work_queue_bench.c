@@ -0,0 +1,182 @@
+/*
+ * Interrupt bottom halves deferred to the timer task with
+ * xTimerPendFunctionCallFromISR() and to a work queue (work_queue.h).
+ *
+ * The interrupt is simulated by calling the FromISR function from the
+ * benchmark task with interrupts masked, then yielding if a task was woken,
+ * the way a handler would exit.  Both the timer task and the worker run above
+ * the benchmark task, so the deferred function runs straight away.
+ *
+ *   defer_isr_timer_pend   the xTimerPendFunctionCallFromISR() call.
+ *   defer_isr_work_queue   the xWorkQueueSubmitFromISR() call.
+ *   defer_run_timer_pend   from the start of the call until the deferred
+ *   defer_run_work_queue   function runs.
+ *
+ * Then each mechanism is given benchDEFER_BURST requests for the same work in
+ * one interrupt.  A "# defer_burst" line reports how many were accepted and how
+ * many times the function ran: the timer command queue overflows after
+ * configTIMER_QUEUE_LENGTH, while the work item is pending once and the rest
+ * coalesce.  A "# work_queue" line gives the statistics the queue kept, with
+ * latencies in run time counter units.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "work_queue.h"
+
+#include "bench.h"
+
+#if ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+
+/* Requests for the same work made by one interrupt. */
+    #define benchDEFER_BURST    16
+
+    static uint32_t ulSamplesA[ benchSAMPLE_COUNT ];
+    static uint32_t ulSamplesB[ benchSAMPLE_COUNT ];
+
+    static WorkQueueHandle_t xBenchWorkQueue;
+    static WorkItemHandle_t xBenchWorkItem;
+
+    static volatile uint32_t ulRunStamp;
+    static volatile uint32_t ulRunCount;
+/*-----------------------------------------------------------*/
+
+    static void prvPendedFunction( void * pvParameter1,
+                                   uint32_t ulParameter2 )
+    {
+        ( void ) pvParameter1;
+        ( void ) ulParameter2;
+
+        ulRunStamp = ulBenchNow();
+        ulRunCount++;
+    }
+
+    static void prvWorkFunction( void * pvParameter )
+    {
+        ( void ) pvParameter;
+
+        ulRunStamp = ulBenchNow();
+        ulRunCount++;
+    }
+/*-----------------------------------------------------------*/
+
+/* Make ulRequests requests from one simulated interrupt.  Returns the number
+ * accepted, and the time the first call took in *pulCallTime. */
+    static uint32_t prvDeferFromISR( BaseType_t xUseWorkQueue,
+                                     uint32_t ulRequests,
+                                     uint32_t * pulCallTime )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t i, t0, ulAccepted = 0;
+        BaseType_t xResult;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+        for( i = 0; i < ulRequests; i++ )
+        {
+            t0 = ulBenchNow();
+
+            if( xUseWorkQueue != pdFALSE )
+            {
+                xResult = xWorkQueueSubmitFromISR( xBenchWorkQueue, xBenchWorkItem, &xHigherPriorityTaskWoken );
+            }
+            else
+            {
+                xResult = xTimerPendFunctionCallFromISR( prvPendedFunction, NULL, 0, &xHigherPriorityTaskWoken );
+            }
+
+            if( i == 0 )
+            {
+                *pulCallTime = ulBenchNow() - t0;
+            }
+
+            if( xResult == pdPASS )
+            {
+                ulAccepted++;
+            }
+        }
+
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+        return ulAccepted;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchDefer( const char * pcMechanism,
+                               BaseType_t xUseWorkQueue )
+    {
+        char cName[ 32 ];
+        uint32_t i, t0, ulAccepted;
+
+        for( i = 0; i < benchSAMPLE_COUNT; i++ )
+        {
+            t0 = ulBenchNow();
+            ( void ) prvDeferFromISR( xUseWorkQueue, 1, &( ulSamplesA[ i ] ) );
+            ulSamplesB[ i ] = ulRunStamp - t0;
+        }
+
+        ( void ) snprintf( cName, sizeof( cName ), "defer_isr_%s", pcMechanism );
+        vBenchReport( cName, ulSamplesA, benchSAMPLE_COUNT );
+        ( void ) snprintf( cName, sizeof( cName ), "defer_run_%s", pcMechanism );
+        vBenchReport( cName, ulSamplesB, benchSAMPLE_COUNT );
+
+        ulRunCount = 0;
+        ulAccepted = prvDeferFromISR( xUseWorkQueue, benchDEFER_BURST, &( ulSamplesA[ 0 ] ) );
+
+        /* Let the timer task catch up if the burst woke it late. */
+        vTaskDelay( 2 );
+
+        printf( "# defer_burst,mechanism=%s,requests=%lu,accepted=%lu,runs=%lu\n",
+                pcMechanism,
+                ( unsigned long ) benchDEFER_BURST,
+                ( unsigned long ) ulAccepted,
+                ( unsigned long ) ulRunCount );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRunWorkQueueBenchmarks( void )
+    {
+        const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+        WorkQueueStats_t xStats;
+        unsigned long ulMean = 0;
+
+        configASSERT( uxPriority + 1 < configMAX_PRIORITIES );
+
+        xBenchWorkQueue = xWorkQueueCreate( "work", uxPriority + 1, benchSTACK_SIZE );
+        configASSERT( xBenchWorkQueue );
+        xBenchWorkItem = xWorkItemCreate( prvWorkFunction, NULL );
+        configASSERT( xBenchWorkItem );
+
+        prvBenchDefer( "timer_pend", pdFALSE );
+        prvBenchDefer( "work_queue", pdTRUE );
+
+        vWorkQueueGetStats( xBenchWorkQueue, &xStats );
+
+        if( xStats.ulRun != 0U )
+        {
+            ulMean = ( unsigned long ) ( xStats.ulTotalLatency / xStats.ulRun );
+        }
+
+        printf( "# work_queue,submitted=%lu,coalesced=%lu,run=%lu,max_pending=%lu,latency_min=%lu,latency_max=%lu,latency_mean=%lu\n",
+                ( unsigned long ) xStats.ulSubmitted,
+                ( unsigned long ) xStats.ulCoalesced,
+                ( unsigned long ) xStats.ulRun,
+                ( unsigned long ) xStats.uxMaxPending,
+                ( unsigned long ) xStats.ulMinLatency,
+                ( unsigned long ) xStats.ulMaxLatency,
+                ulMean );
+
+        vWorkQueueDelete( xBenchWorkQueue );
+        vWorkItemDelete( xBenchWorkItem );
+
+        /* Let the idle task free the deleted worker. */
+        vTaskDelay( 2 );
+    }
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
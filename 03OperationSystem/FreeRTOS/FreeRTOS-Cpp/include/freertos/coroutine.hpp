@@ -0,0 +1,1098 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * C++20 coroutines run by an executor on the stack of one FreeRTOS task.
+ *
+ * A state machine written as a coroutine costs its coroutine frame - the
+ * locals that live across a co_await plus a few words of bookkeeping - instead
+ * of a TCB and a stack of its own.  Every coroutine of an executor runs on the
+ * stack of the task that calls Executor::run(), one at a time, and only gives
+ * up the CPU at a co_await:
+ *
+ *   co_await Delay( xTicks )                  like vTaskDelay().
+ *   co_await Yield()                          lets the other ready coroutines
+ *                                             run first.
+ *   co_await QueueReceive( xQueue, pv, xTicks )
+ *                                             like xQueueReceive(), returns
+ *                                             pdPASS or pdFAIL.
+ *   co_await StreamBufferReceive( xStreamBuffer, pv, xLength, xTicks )
+ *                                             like xStreamBufferReceive(),
+ *                                             returns the bytes read.
+ *   co_await NotifyTake( xClearCountOnExit, xTicks )
+ *                                             like ulTaskNotifyTake(), for a
+ *                                             coroutine notified with
+ *                                             vCoroutineNotifyGive() or
+ *                                             vCoroutineNotifyGiveFromISR().
+ *
+ * While no coroutine is ready the executor's task blocks in xWaitAny() on a
+ * waiter (waiter.h) to which every queue and stream buffer a coroutine is
+ * reading is added, with the time to the nearest Delay() or time out as its
+ * block time.  Coroutines made ready by another task or an interrupt are
+ * handed over through the waiter as well.
+ *
+ * Coroutine frames are allocated with pvPortMalloc() when the coroutine is
+ * called, and freed when it returns.  Nothing else allocates, and neither
+ * exceptions nor RTTI are used, so the header builds with -fno-exceptions
+ * -fno-rtti.
+ *
+ * A coroutine must not call a blocking kernel function with a block time, as
+ * that blocks every coroutine of the executor, and must not use the task
+ * notifications of the executor's task, which its waiter uses.
+ *
+ * configUSE_WAITERS and configSUPPORT_DYNAMIC_ALLOCATION must both be set to 1
+ * in FreeRTOSConfig.h.
+ *
+ * Example:
+ * @code{cpp}
+ *  freertos::Coroutine prvBlinker( TickType_t xPeriod )
+ *  {
+ *      for( ; ; )
+ *      {
+ *          vToggleLED();
+ *          co_await freertos::Delay( xPeriod );
+ *      }
+ *  }
+ *
+ *  freertos::Coroutine prvCommandParser( QueueHandle_t xCommands )
+ *  {
+ *      Command_t xCommand;
+ *
+ *      for( ; ; )
+ *      {
+ *          if( co_await freertos::QueueReceive( xCommands, &xCommand, portMAX_DELAY ) == pdPASS )
+ *          {
+ *              vHandleCommand( &xCommand );
+ *          }
+ *      }
+ *  }
+ *
+ *  static freertos::Executor xExecutor;
+ *
+ *  static void prvExecutorTask( void * pvParameters )
+ *  {
+ *      xExecutor.spawn( prvBlinker( pdMS_TO_TICKS( 500 ) ) );
+ *      xExecutor.spawn( prvCommandParser( xCommandQueue ) );
+ *
+ *      // Only returns once every coroutine has returned.
+ *      xExecutor.run();
+ *      vTaskDelete( NULL );
+ *  }
+ * @endcode
+ */
+
+#ifndef FREERTOS_COROUTINE_HPP
+#define FREERTOS_COROUTINE_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "waiter.h"
+
+#if ( configUSE_WAITERS != 1 )
+    #error freertos/coroutine.hpp needs configUSE_WAITERS set to 1 in FreeRTOSConfig.h.
+#endif
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+    #error freertos/coroutine.hpp allocates coroutine frames with pvPortMalloc() and needs configSUPPORT_DYNAMIC_ALLOCATION set to 1.
+#endif
+
+namespace freertos
+{
+    class Coroutine;
+    class Executor;
+    struct CoroutinePromise;
+
+    /* The handle of a running coroutine, as returned by Executor::spawn() and
+     * passed to vCoroutineNotifyGive().  Like a TaskHandle_t of a deleted task
+     * it must not be used once the coroutine has returned. */
+    typedef CoroutinePromise * CoroutineHandle_t;
+
+    void vCoroutineNotifyGive( CoroutineHandle_t xCoroutine ) noexcept;
+    void vCoroutineNotifyGiveFromISR( CoroutineHandle_t xCoroutine,
+                                      BaseType_t * pxHigherPriorityTaskWoken ) noexcept;
+
+    namespace detail
+    {
+        /* Values of CoroutinePromise::ucNotifyState. */
+        constexpr uint8_t ucNOT_WAITING_NOTIFICATION = 0;
+        constexpr uint8_t ucWAITING_NOTIFICATION = 1;
+        constexpr uint8_t ucNOTIFICATION_RECEIVED = 2;
+
+        /* What a suspended coroutine waits for, see TimedWait::ucKind. */
+        constexpr uint8_t ucWAIT_DELAY = 0;
+        constexpr uint8_t ucWAIT_NOTIFICATION = 1;
+        constexpr uint8_t ucWAIT_QUEUE = 2;
+        constexpr uint8_t ucWAIT_STREAM_BUFFER = 3;
+
+        /* A suspended coroutine.  Lives in the awaiter, so in the coroutine
+         * frame, for as long as the coroutine is suspended.  If it has a time
+         * limit it is kept in the executor's list of timed waits, in order of
+         * expiry. */
+        struct TimedWait
+        {
+            CoroutinePromise * pxPromise = nullptr;
+            TimedWait * pxNextTimed = nullptr;
+            TickType_t xTimeOnEntering = 0;
+            TickType_t xTicksToWait = 0;
+            BaseType_t xTimed = pdFALSE; /* pdTRUE while in the list of timed waits. */
+            uint8_t ucKind = ucWAIT_DELAY;
+        };
+
+        /* A queue or stream buffer read that found nothing to read.  The source
+         * is added to the executor's waiter while any read waits on it, and the
+         * reads are tried again whenever a source becomes ready. */
+        struct ReadWait : TimedWait
+        {
+            ReadWait * pxNextRead = nullptr;
+            void * pvSource = nullptr;
+            void * pvBuffer = nullptr;
+            size_t xBufferLength = 0;
+            size_t xReceived = 0; /* 1 for a queue item, or the bytes read. */
+        };
+    }
+
+    /* The promise of a Coroutine, holding what the executor keeps per
+     * coroutine. */
+    struct CoroutinePromise
+    {
+        Executor * pxExecutor = nullptr;
+        CoroutinePromise * pxNextReady = nullptr;
+        BaseType_t xQueued = pdFALSE; /* pdTRUE while in the executor's ready list. */
+        volatile uint32_t ulNotifiedValue = 0;
+        volatile uint8_t ucNotifyState = detail::ucNOT_WAITING_NOTIFICATION;
+
+        /* Frames come from the FreeRTOS heap.  As get_return_object_on_allocation_failure()
+         * is defined, a failed allocation gives an empty Coroutine rather than
+         * throwing. */
+        static void * operator new( size_t xSize ) noexcept
+        {
+            return pvPortMalloc( xSize );
+        }
+
+        static void operator delete( void * pv ) noexcept
+        {
+            vPortFree( pv );
+        }
+
+        static Coroutine get_return_object_on_allocation_failure() noexcept;
+        Coroutine get_return_object() noexcept;
+
+        /* A coroutine runs once it has been spawned, and frees its frame when it
+         * returns. */
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            configASSERT( 0 );
+        }
+
+        ~CoroutinePromise();
+    };
+
+    /* The return type of a coroutine run by an Executor.  Calling the
+     * coroutine creates its frame without running it; pass the Coroutine to
+     * Executor::spawn() to run it.  A Coroutine that is never spawned frees
+     * the frame when it goes out of scope. */
+    class Coroutine
+    {
+        public:
+            using promise_type = CoroutinePromise;
+
+            Coroutine() noexcept = default;
+
+            explicit Coroutine( std::coroutine_handle< CoroutinePromise > xHandleIn ) noexcept
+                : xHandle( xHandleIn )
+            {
+            }
+
+            Coroutine( Coroutine && xOther ) noexcept
+                : xHandle( xOther.xHandle )
+            {
+                xOther.xHandle = nullptr;
+            }
+
+            Coroutine( const Coroutine & ) = delete;
+            Coroutine & operator=( const Coroutine & ) = delete;
+            Coroutine & operator=( Coroutine && ) = delete;
+
+            ~Coroutine()
+            {
+                if( xHandle )
+                {
+                    xHandle.destroy();
+                }
+            }
+
+            /* false if the frame could not be allocated. */
+            explicit operator bool() const noexcept
+            {
+                return static_cast< bool >( xHandle );
+            }
+
+        private:
+            friend class Executor;
+
+            std::coroutine_handle< CoroutinePromise > xHandle;
+    };
+
+    /* Runs coroutines on the stack of the task that calls run(). */
+    class Executor
+    {
+        public:
+            Executor() noexcept = default;
+            Executor( const Executor & ) = delete;
+            Executor & operator=( const Executor & ) = delete;
+
+            /* Hands a coroutine to the executor, which runs it from run().  Can
+             * be called before run(), from a coroutine of the executor, or from
+             * another task while the executor has coroutines.  Returns the
+             * coroutine's handle, or NULL if its frame could not be allocated. */
+            CoroutineHandle_t spawn( Coroutine && xCoroutine ) noexcept;
+
+            /* Runs the spawned coroutines until every one of them has
+             * returned. */
+            void run() noexcept;
+
+            /* The number of spawned coroutines that have not returned yet. */
+            UBaseType_t getCoroutineCount() const noexcept
+            {
+                return uxCoroutines;
+            }
+
+        private:
+            friend struct CoroutinePromise;
+            friend class Delay;
+            friend class Yield;
+            friend class NotifyTake;
+            friend class QueueReceive;
+            friend class StreamBufferReceive;
+            friend void vCoroutineNotifyGive( CoroutineHandle_t xCoroutine ) noexcept;
+            friend void vCoroutineNotifyGiveFromISR( CoroutineHandle_t xCoroutine,
+                                                     BaseType_t * pxHigherPriorityTaskWoken ) noexcept;
+
+            /* Ready bits of the executor's waiter. */
+            static constexpr uint32_t ulREADY_LIST_BIT = 0x01UL; /* Another task or an interrupt readied a coroutine. */
+            static constexpr uint32_t ulREAD_SOURCE_BIT = 0x02UL; /* A queue or stream buffer being read became ready. */
+
+            void prvMakeReady( CoroutinePromise * pxPromise ) noexcept;
+            void prvMakeReadyFromISR( CoroutinePromise * pxPromise,
+                                      BaseType_t * pxHigherPriorityTaskWoken ) noexcept;
+            void prvResumeReady() noexcept;
+
+            static TickType_t prvTicksLeft( const detail::TimedWait * pxWait,
+                                            TickType_t xNow ) noexcept;
+            void prvAddTimed( detail::TimedWait * pxWait ) noexcept;
+            void prvRemoveTimed( detail::TimedWait * pxWait ) noexcept;
+            void prvExpireTimed() noexcept;
+            TickType_t prvTicksToNextExpiry() const noexcept;
+
+            BaseType_t prvIsBeingRead( const void * pvSource ) const noexcept;
+            void prvAddRead( detail::ReadWait * pxWait ) noexcept;
+            void prvRemoveRead( detail::ReadWait * pxWait ) noexcept;
+            void prvRetryReads() noexcept;
+            static size_t prvTryRead( detail::ReadWait * pxWait ) noexcept;
+
+            /* Written by other tasks and interrupts, so only accessed in a
+             * critical section. */
+            CoroutinePromise * pxReadyHead = nullptr;
+            CoroutinePromise * pxReadyTail = nullptr;
+            volatile UBaseType_t uxCoroutines = 0;
+
+            /* Only accessed by the executor's task. */
+            detail::TimedWait * pxTimedHead = nullptr;
+            detail::ReadWait * pxReadHead = nullptr;
+
+            WaiterHandle_t volatile xWaiter = nullptr;
+            TaskHandle_t volatile xTask = nullptr;
+    };
+    /*-----------------------------------------------------------*/
+
+    /* co_await Delay( xTicksToDelay ) suspends the coroutine for xTicksToDelay
+     * ticks. */
+    class Delay
+    {
+        public:
+            explicit Delay( TickType_t xTicksToDelay ) noexcept
+            {
+                xWait.xTicksToWait = xTicksToDelay;
+                xWait.ucKind = detail::ucWAIT_DELAY;
+            }
+
+            bool await_ready() const noexcept
+            {
+                return xWait.xTicksToWait == ( TickType_t ) 0;
+            }
+
+            void await_suspend( std::coroutine_handle< CoroutinePromise > xHandle ) noexcept
+            {
+                xWait.pxPromise = &xHandle.promise();
+                xWait.pxPromise->pxExecutor->prvAddTimed( &xWait );
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+        private:
+            detail::TimedWait xWait;
+    };
+    /*-----------------------------------------------------------*/
+
+    /* co_await Yield() moves the coroutine to the back of the ready list. */
+    class Yield
+    {
+        public:
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend( std::coroutine_handle< CoroutinePromise > xHandle ) noexcept
+            {
+                xHandle.promise().pxExecutor->prvMakeReady( &xHandle.promise() );
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+    };
+    /*-----------------------------------------------------------*/
+
+    /* co_await NotifyTake( xClearCountOnExit, xTicksToWait ) waits for the
+     * coroutine's notification value to be non-zero, and returns it as it was
+     * before it was cleared (xClearCountOnExit pdTRUE) or decremented - or 0 if
+     * xTicksToWait expired first. */
+    class NotifyTake
+    {
+        public:
+            NotifyTake( BaseType_t xClearCountOnExitIn,
+                        TickType_t xTicksToWait ) noexcept
+                : xClearCountOnExit( xClearCountOnExitIn )
+            {
+                xWait.xTicksToWait = xTicksToWait;
+                xWait.ucKind = detail::ucWAIT_NOTIFICATION;
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend( std::coroutine_handle< CoroutinePromise > xHandle ) noexcept
+            {
+                CoroutinePromise * const pxPromise = &xHandle.promise();
+                bool xSuspend = false;
+
+                xWait.pxPromise = pxPromise;
+
+                taskENTER_CRITICAL();
+                {
+                    if( ( pxPromise->ulNotifiedValue == 0U ) && ( xWait.xTicksToWait != ( TickType_t ) 0 ) )
+                    {
+                        pxPromise->ucNotifyState = detail::ucWAITING_NOTIFICATION;
+                        xSuspend = true;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xSuspend )
+                {
+                    pxPromise->pxExecutor->prvAddTimed( &xWait );
+                }
+
+                return xSuspend;
+            }
+
+            uint32_t await_resume() noexcept
+            {
+                CoroutinePromise * const pxPromise = xWait.pxPromise;
+                uint32_t ulReturn;
+
+                pxPromise->pxExecutor->prvRemoveTimed( &xWait );
+
+                taskENTER_CRITICAL();
+                {
+                    ulReturn = pxPromise->ulNotifiedValue;
+
+                    if( ulReturn != 0U )
+                    {
+                        if( xClearCountOnExit != pdFALSE )
+                        {
+                            pxPromise->ulNotifiedValue = 0U;
+                        }
+                        else
+                        {
+                            pxPromise->ulNotifiedValue = ulReturn - 1U;
+                        }
+                    }
+
+                    pxPromise->ucNotifyState = detail::ucNOT_WAITING_NOTIFICATION;
+                }
+                taskEXIT_CRITICAL();
+
+                return ulReturn;
+            }
+
+        private:
+            detail::TimedWait xWait;
+            BaseType_t xClearCountOnExit;
+    };
+    /*-----------------------------------------------------------*/
+
+    /* co_await QueueReceive( xQueue, pvBuffer, xTicksToWait ) receives an item
+     * from a queue, and returns pdPASS, or pdFAIL if xTicksToWait expired
+     * first. */
+    class QueueReceive
+    {
+        public:
+            QueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait ) noexcept
+            {
+                xWait.pvSource = xQueue;
+                xWait.pvBuffer = pvBuffer;
+                xWait.xTicksToWait = xTicksToWait;
+                xWait.ucKind = detail::ucWAIT_QUEUE;
+            }
+
+            bool await_ready() noexcept
+            {
+                xWait.xReceived = Executor::prvTryRead( &xWait );
+
+                return ( xWait.xReceived != 0U ) || ( xWait.xTicksToWait == ( TickType_t ) 0 );
+            }
+
+            void await_suspend( std::coroutine_handle< CoroutinePromise > xHandle ) noexcept
+            {
+                xWait.pxPromise = &xHandle.promise();
+                xWait.pxPromise->pxExecutor->prvAddRead( &xWait );
+            }
+
+            BaseType_t await_resume() const noexcept
+            {
+                BaseType_t xReturn;
+
+                if( xWait.xReceived != 0U )
+                {
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                return xReturn;
+            }
+
+        private:
+            detail::ReadWait xWait;
+    };
+    /*-----------------------------------------------------------*/
+
+    /* co_await StreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes,
+     * xTicksToWait ) reads from a stream or message buffer, and returns the
+     * number of bytes read - 0 if xTicksToWait expired first. */
+    class StreamBufferReceive
+    {
+        public:
+            StreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+                                 void * pvRxData,
+                                 size_t xBufferLengthBytes,
+                                 TickType_t xTicksToWait ) noexcept
+            {
+                xWait.pvSource = xStreamBuffer;
+                xWait.pvBuffer = pvRxData;
+                xWait.xBufferLength = xBufferLengthBytes;
+                xWait.xTicksToWait = xTicksToWait;
+                xWait.ucKind = detail::ucWAIT_STREAM_BUFFER;
+            }
+
+            bool await_ready() noexcept
+            {
+                xWait.xReceived = Executor::prvTryRead( &xWait );
+
+                return ( xWait.xReceived != 0U ) || ( xWait.xTicksToWait == ( TickType_t ) 0 );
+            }
+
+            void await_suspend( std::coroutine_handle< CoroutinePromise > xHandle ) noexcept
+            {
+                xWait.pxPromise = &xHandle.promise();
+                xWait.pxPromise->pxExecutor->prvAddRead( &xWait );
+            }
+
+            size_t await_resume() const noexcept
+            {
+                return xWait.xReceived;
+            }
+
+        private:
+            detail::ReadWait xWait;
+    };
+    /*-----------------------------------------------------------*/
+
+    inline Coroutine CoroutinePromise::get_return_object() noexcept
+    {
+        return Coroutine( std::coroutine_handle< CoroutinePromise >::from_promise( *this ) );
+    }
+
+    inline Coroutine CoroutinePromise::get_return_object_on_allocation_failure() noexcept
+    {
+        return Coroutine();
+    }
+
+    inline CoroutinePromise::~CoroutinePromise()
+    {
+        /* The frame is freed when the coroutine returns. */
+        if( pxExecutor != nullptr )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxExecutor->uxCoroutines = pxExecutor->uxCoroutines - 1U;
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline CoroutineHandle_t Executor::spawn( Coroutine && xCoroutine ) noexcept
+    {
+        CoroutinePromise * pxPromise = nullptr;
+
+        if( xCoroutine.xHandle )
+        {
+            pxPromise = &xCoroutine.xHandle.promise();
+            pxPromise->pxExecutor = this;
+
+            /* The executor owns the frame from now on. */
+            xCoroutine.xHandle = nullptr;
+
+            taskENTER_CRITICAL();
+            {
+                uxCoroutines = uxCoroutines + 1U;
+            }
+            taskEXIT_CRITICAL();
+
+            prvMakeReady( pxPromise );
+        }
+
+        return pxPromise;
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::run() noexcept
+    {
+        uint32_t ulReadyBits;
+        TickType_t xTicksToWait;
+        BaseType_t xReadyLeft;
+
+        xTask = xTaskGetCurrentTaskHandle();
+        xWaiter = xWaiterCreate();
+        configASSERT( xWaiter );
+
+        while( uxCoroutines != ( UBaseType_t ) 0 )
+        {
+            prvResumeReady();
+            prvExpireTimed();
+
+            xReadyLeft = pdFALSE;
+
+            taskENTER_CRITICAL();
+            {
+                if( pxReadyHead != nullptr )
+                {
+                    xReadyLeft = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* Only block if no coroutine is ready, but always collect the
+             * sources that have become ready, so a coroutine that keeps
+             * yielding does not starve the readers. */
+            if( xReadyLeft != pdFALSE )
+            {
+                xTicksToWait = 0;
+            }
+            else if( uxCoroutines != ( UBaseType_t ) 0 )
+            {
+                xTicksToWait = prvTicksToNextExpiry();
+            }
+            else
+            {
+                break;
+            }
+
+            ( void ) xWaitAny( xWaiter, &ulReadyBits, xTicksToWait );
+
+            if( ( ulReadyBits & ulREAD_SOURCE_BIT ) != 0U )
+            {
+                prvRetryReads();
+            }
+        }
+
+        /* Every source was removed when the last read waiting on it ended. */
+        vWaiterDelete( xWaiter );
+        xWaiter = nullptr;
+        xTask = nullptr;
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvMakeReady( CoroutinePromise * pxPromise ) noexcept
+    {
+        BaseType_t xAdded = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            if( pxPromise->xQueued == pdFALSE )
+            {
+                pxPromise->xQueued = pdTRUE;
+                pxPromise->pxNextReady = nullptr;
+
+                if( pxReadyTail != nullptr )
+                {
+                    pxReadyTail->pxNextReady = pxPromise;
+                }
+                else
+                {
+                    pxReadyHead = pxPromise;
+                }
+
+                pxReadyTail = pxPromise;
+                xAdded = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* The executor's own task looks at the ready list before it blocks. */
+        if( ( xAdded != pdFALSE ) && ( xWaiter != nullptr ) && ( xTaskGetCurrentTaskHandle() != xTask ) )
+        {
+            vWaiterSignal( xWaiter, ulREADY_LIST_BIT );
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvMakeReadyFromISR( CoroutinePromise * pxPromise,
+                                               BaseType_t * pxHigherPriorityTaskWoken ) noexcept
+    {
+        BaseType_t xAdded = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( pxPromise->xQueued == pdFALSE )
+            {
+                pxPromise->xQueued = pdTRUE;
+                pxPromise->pxNextReady = nullptr;
+
+                if( pxReadyTail != nullptr )
+                {
+                    pxReadyTail->pxNextReady = pxPromise;
+                }
+                else
+                {
+                    pxReadyHead = pxPromise;
+                }
+
+                pxReadyTail = pxPromise;
+                xAdded = pdTRUE;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        if( ( xAdded != pdFALSE ) && ( xWaiter != nullptr ) )
+        {
+            vWaiterSignalFromISR( xWaiter, ulREADY_LIST_BIT, pxHigherPriorityTaskWoken );
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvResumeReady() noexcept
+    {
+        CoroutinePromise * pxLast;
+        CoroutinePromise * pxPromise;
+
+        /* Only run the coroutines that are ready now.  Those they ready in turn
+         * run on the next pass, after the timers and sources are checked. */
+        taskENTER_CRITICAL();
+        {
+            pxLast = pxReadyTail;
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxLast != nullptr )
+        {
+            do
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxPromise = pxReadyHead;
+                    pxReadyHead = pxPromise->pxNextReady;
+
+                    if( pxReadyHead == nullptr )
+                    {
+                        pxReadyTail = nullptr;
+                    }
+
+                    pxPromise->xQueued = pdFALSE;
+                }
+                taskEXIT_CRITICAL();
+
+                /* May free the frame, so pxPromise is only compared from here
+                 * on. */
+                std::coroutine_handle< CoroutinePromise >::from_promise( *pxPromise ).resume();
+            } while( pxPromise != pxLast );
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline TickType_t Executor::prvTicksLeft( const detail::TimedWait * pxWait,
+                                              TickType_t xNow ) noexcept
+    {
+        const TickType_t xElapsed = xNow - pxWait->xTimeOnEntering;
+        TickType_t xTicksLeft;
+
+        if( xElapsed >= pxWait->xTicksToWait )
+        {
+            xTicksLeft = 0;
+        }
+        else
+        {
+            xTicksLeft = pxWait->xTicksToWait - xElapsed;
+        }
+
+        return xTicksLeft;
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvAddTimed( detail::TimedWait * pxWait ) noexcept
+    {
+        detail::TimedWait ** ppxLink = &pxTimedHead;
+        const TickType_t xNow = xTaskGetTickCount();
+
+        /* Waits without a time limit are not in the list. */
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( pxWait->xTicksToWait != portMAX_DELAY )
+        #endif
+        {
+            pxWait->xTimeOnEntering = xNow;
+
+            /* Ordered by the ticks left, which every wait loses at the same
+             * rate until it has expired. */
+            while( ( *ppxLink != nullptr ) && ( prvTicksLeft( *ppxLink, xNow ) <= pxWait->xTicksToWait ) )
+            {
+                ppxLink = &( ( *ppxLink )->pxNextTimed );
+            }
+
+            pxWait->pxNextTimed = *ppxLink;
+            *ppxLink = pxWait;
+            pxWait->xTimed = pdTRUE;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvRemoveTimed( detail::TimedWait * pxWait ) noexcept
+    {
+        detail::TimedWait ** ppxLink = &pxTimedHead;
+
+        if( pxWait->xTimed != pdFALSE )
+        {
+            while( *ppxLink != pxWait )
+            {
+                ppxLink = &( ( *ppxLink )->pxNextTimed );
+            }
+
+            *ppxLink = pxWait->pxNextTimed;
+            pxWait->xTimed = pdFALSE;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvExpireTimed() noexcept
+    {
+        const TickType_t xNow = xTaskGetTickCount();
+        detail::TimedWait * pxWait;
+        BaseType_t xResume;
+
+        while( ( pxTimedHead != nullptr ) && ( prvTicksLeft( pxTimedHead, xNow ) == ( TickType_t ) 0 ) )
+        {
+            pxWait = pxTimedHead;
+            pxTimedHead = pxWait->pxNextTimed;
+            pxWait->xTimed = pdFALSE;
+            xResume = pdTRUE;
+
+            if( pxWait->ucKind == detail::ucWAIT_NOTIFICATION )
+            {
+                /* A notification that got in first has readied the coroutine
+                 * already. */
+                taskENTER_CRITICAL();
+                {
+                    if( pxWait->pxPromise->ucNotifyState == detail::ucWAITING_NOTIFICATION )
+                    {
+                        pxWait->pxPromise->ucNotifyState = detail::ucNOT_WAITING_NOTIFICATION;
+                    }
+                    else
+                    {
+                        xResume = pdFALSE;
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else if( pxWait->ucKind != detail::ucWAIT_DELAY )
+            {
+                prvRemoveRead( static_cast< detail::ReadWait * >( pxWait ) );
+            }
+
+            if( xResume != pdFALSE )
+            {
+                prvMakeReady( pxWait->pxPromise );
+            }
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline TickType_t Executor::prvTicksToNextExpiry() const noexcept
+    {
+        TickType_t xTicksToWait = portMAX_DELAY;
+
+        if( pxTimedHead != nullptr )
+        {
+            xTicksToWait = prvTicksLeft( pxTimedHead, xTaskGetTickCount() );
+        }
+
+        return xTicksToWait;
+    }
+    /*-----------------------------------------------------------*/
+
+    inline BaseType_t Executor::prvIsBeingRead( const void * pvSource ) const noexcept
+    {
+        const detail::ReadWait * pxWait = pxReadHead;
+        BaseType_t xReturn = pdFALSE;
+
+        while( ( pxWait != nullptr ) && ( xReturn == pdFALSE ) )
+        {
+            if( pxWait->pvSource == pvSource )
+            {
+                xReturn = pdTRUE;
+            }
+
+            pxWait = pxWait->pxNextRead;
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvAddRead( detail::ReadWait * pxWait ) noexcept
+    {
+        detail::ReadWait ** ppxLink = &pxReadHead;
+        BaseType_t xBeingRead = pdFALSE;
+        BaseType_t xResult = pdPASS;
+
+        /* Reads are retried oldest first, as tasks waiting on a queue are
+         * unblocked. */
+        while( *ppxLink != nullptr )
+        {
+            if( ( *ppxLink )->pvSource == pxWait->pvSource )
+            {
+                xBeingRead = pdTRUE;
+            }
+
+            ppxLink = &( ( *ppxLink )->pxNextRead );
+        }
+
+        /* A source that is ready by the time it is added readies the waiter at
+         * once, so an item written since the read failed is not missed. */
+        if( xBeingRead == pdFALSE )
+        {
+            if( pxWait->ucKind == detail::ucWAIT_QUEUE )
+            {
+                xResult = xWaiterAddQueue( xWaiter, static_cast< QueueHandle_t >( pxWait->pvSource ), ulREAD_SOURCE_BIT );
+            }
+            else
+            {
+                xResult = xWaiterAddStreamBuffer( xWaiter, static_cast< StreamBufferHandle_t >( pxWait->pvSource ), ulREAD_SOURCE_BIT );
+            }
+        }
+
+        /* Fails if the source is in another waiter. */
+        configASSERT( xResult == pdPASS );
+        ( void ) xResult;
+
+        pxWait->pxNextRead = nullptr;
+        *ppxLink = pxWait;
+
+        prvAddTimed( pxWait );
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvRemoveRead( detail::ReadWait * pxWait ) noexcept
+    {
+        detail::ReadWait ** ppxLink = &pxReadHead;
+
+        while( *ppxLink != pxWait )
+        {
+            ppxLink = &( ( *ppxLink )->pxNextRead );
+        }
+
+        *ppxLink = pxWait->pxNextRead;
+
+        if( prvIsBeingRead( pxWait->pvSource ) == pdFALSE )
+        {
+            if( pxWait->ucKind == detail::ucWAIT_QUEUE )
+            {
+                ( void ) xWaiterRemoveQueue( xWaiter, static_cast< QueueHandle_t >( pxWait->pvSource ) );
+            }
+            else
+            {
+                ( void ) xWaiterRemoveStreamBuffer( xWaiter, static_cast< StreamBufferHandle_t >( pxWait->pvSource ) );
+            }
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline void Executor::prvRetryReads() noexcept
+    {
+        detail::ReadWait * pxWait = pxReadHead;
+        detail::ReadWait * pxNext;
+
+        while( pxWait != nullptr )
+        {
+            pxNext = pxWait->pxNextRead;
+            pxWait->xReceived = prvTryRead( pxWait );
+
+            if( pxWait->xReceived != 0U )
+            {
+                prvRemoveRead( pxWait );
+                prvRemoveTimed( pxWait );
+                prvMakeReady( pxWait->pxPromise );
+            }
+
+            pxWait = pxNext;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    inline size_t Executor::prvTryRead( detail::ReadWait * pxWait ) noexcept
+    {
+        size_t xReceived;
+
+        if( pxWait->ucKind == detail::ucWAIT_QUEUE )
+        {
+            if( xQueueReceive( static_cast< QueueHandle_t >( pxWait->pvSource ), pxWait->pvBuffer, 0 ) == pdPASS )
+            {
+                xReceived = 1U;
+            }
+            else
+            {
+                xReceived = 0U;
+            }
+        }
+        else
+        {
+            xReceived = xStreamBufferReceive( static_cast< StreamBufferHandle_t >( pxWait->pvSource ), pxWait->pvBuffer, pxWait->xBufferLength, 0 );
+        }
+
+        return xReceived;
+    }
+    /*-----------------------------------------------------------*/
+
+    /* Increments the notification value of a coroutine, readying it if it is
+     * waiting in NotifyTake(), like xTaskNotifyGive() does for a task.  Can be
+     * called from any task, including a coroutine. */
+    inline void vCoroutineNotifyGive( CoroutineHandle_t xCoroutine ) noexcept
+    {
+        BaseType_t xWake = pdFALSE;
+
+        configASSERT( xCoroutine );
+
+        taskENTER_CRITICAL();
+        {
+            xCoroutine->ulNotifiedValue = xCoroutine->ulNotifiedValue + 1U;
+
+            if( xCoroutine->ucNotifyState == detail::ucWAITING_NOTIFICATION )
+            {
+                xCoroutine->ucNotifyState = detail::ucNOTIFICATION_RECEIVED;
+                xWake = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xWake != pdFALSE )
+        {
+            xCoroutine->pxExecutor->prvMakeReady( xCoroutine );
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    /* A version of vCoroutineNotifyGive() that can be called from an
+     * interrupt. */
+    inline void vCoroutineNotifyGiveFromISR( CoroutineHandle_t xCoroutine,
+                                             BaseType_t * pxHigherPriorityTaskWoken ) noexcept
+    {
+        BaseType_t xWake = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xCoroutine );
+
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xCoroutine->ulNotifiedValue = xCoroutine->ulNotifiedValue + 1U;
+
+            if( xCoroutine->ucNotifyState == detail::ucWAITING_NOTIFICATION )
+            {
+                xCoroutine->ucNotifyState = detail::ucNOTIFICATION_RECEIVED;
+                xWake = pdTRUE;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xWake != pdFALSE )
+        {
+            xCoroutine->pxExecutor->prvMakeReadyFromISR( xCoroutine, pxHigherPriorityTaskWoken );
+        }
+    }
+}
+
+#endif /* FREERTOS_COROUTINE_HPP */
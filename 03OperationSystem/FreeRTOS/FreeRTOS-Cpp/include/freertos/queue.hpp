@@ -0,0 +1,232 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A queue of items of type T, N long, in static storage.
+ *
+ * Queue<T, N> holds the queue structure and the storage of its N items, so
+ * declaring one - as a global, a static or a class member - creates the queue
+ * with xQueueCreateStatic() without touching the FreeRTOS heap.  T must be
+ * trivially copyable, as the kernel copies items byte for byte, and the
+ * methods only take and return T, so the item size is never passed around.
+ *
+ * send(), receive() and the other methods are inline calls to the C API, so
+ * the item is copied by the kernel's memcpy() of uxItemSize bytes, a size only
+ * known at run time, exactly as from C.  The type does not turn that copy into
+ * a fixed-size one.  Only sendInPlace() and receiveInPlace(), available when
+ * configUSE_QUEUE_ZERO_COPY is 1, copy sizeof( T ) bytes themselves, straight
+ * into and out of the queue storage through xQueueReserve() and
+ * xQueuePeekRef(), which is a few word loads and stores for a small T.  They
+ * make two kernel calls where send() and receive() make one, so they only pay
+ * off where memcpy() is slow for the item size, and as only one slot of a
+ * queue can be reserved and only one referenced at a time they are for queues
+ * with a single writer and a single reader.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h.
+ *
+ * Example:
+ * @code{cpp}
+ *  struct SensorFrame
+ *  {
+ *      uint32_t ulTimestamp;
+ *      int16_t sSamples[ 6 ];
+ *  };
+ *
+ *  static freertos::Queue< SensorFrame, 8 > xFrames;
+ *
+ *  void vSensorTask( void * pvParameters )
+ *  {
+ *      SensorFrame xFrame;
+ *
+ *      for( ; ; )
+ *      {
+ *          vReadSensor( &xFrame );
+ *          ( void ) xFrames.send( xFrame, portMAX_DELAY );
+ *      }
+ *  }
+ * @endcode
+ */
+
+#ifndef FREERTOS_QUEUE_HPP
+#define FREERTOS_QUEUE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error freertos/queue.hpp creates queues with xQueueCreateStatic() and needs configSUPPORT_STATIC_ALLOCATION set to 1.
+#endif
+
+namespace freertos
+{
+    template< typename T, UBaseType_t N >
+    class Queue
+    {
+        static_assert( std::is_trivially_copyable< T >::value, "queue items are copied byte for byte" );
+        static_assert( N > 0U, "a queue holds at least one item" );
+
+        public:
+            Queue() noexcept
+            {
+                xHandle = xQueueCreateStatic( N, sizeof( T ), ucStorage, &xQueueBuffer );
+                configASSERT( xHandle );
+            }
+
+            Queue( const Queue & ) = delete;
+            Queue & operator=( const Queue & ) = delete;
+
+            ~Queue()
+            {
+                vQueueDelete( xHandle );
+            }
+
+            /* For the parts of the C API that have no method, such as
+             * xWaiterAddQueue(). */
+            QueueHandle_t getHandle() const noexcept
+            {
+                return xHandle;
+            }
+
+            BaseType_t send( const T & xItem,
+                             TickType_t xTicksToWait ) noexcept
+            {
+                return xQueueSend( xHandle, &xItem, xTicksToWait );
+            }
+
+            BaseType_t sendToFront( const T & xItem,
+                                    TickType_t xTicksToWait ) noexcept
+            {
+                return xQueueSendToFront( xHandle, &xItem, xTicksToWait );
+            }
+
+            /* Only for a queue one item long, as for xQueueOverwrite(). */
+            BaseType_t overwrite( const T & xItem ) noexcept
+            {
+                static_assert( N == 1U, "overwrite() is only for a queue one item long" );
+
+                return xQueueOverwrite( xHandle, &xItem );
+            }
+
+            BaseType_t receive( T & xItem,
+                                TickType_t xTicksToWait ) noexcept
+            {
+                return xQueueReceive( xHandle, &xItem, xTicksToWait );
+            }
+
+            BaseType_t peek( T & xItem,
+                             TickType_t xTicksToWait ) noexcept
+            {
+                return xQueuePeek( xHandle, &xItem, xTicksToWait );
+            }
+
+            BaseType_t sendFromISR( const T & xItem,
+                                    BaseType_t * pxHigherPriorityTaskWoken ) noexcept
+            {
+                return xQueueSendFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken );
+            }
+
+            BaseType_t receiveFromISR( T & xItem,
+                                       BaseType_t * pxHigherPriorityTaskWoken ) noexcept
+            {
+                return xQueueReceiveFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken );
+            }
+
+            UBaseType_t getMessagesWaiting() const noexcept
+            {
+                return uxQueueMessagesWaiting( xHandle );
+            }
+
+            UBaseType_t getSpacesAvailable() const noexcept
+            {
+                return uxQueueSpacesAvailable( xHandle );
+            }
+
+            BaseType_t reset() noexcept
+            {
+                return xQueueReset( xHandle );
+            }
+
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+                /* Like send(), with the item copied into the queue storage by
+                 * the caller.  Only for a queue with a single writer, as while
+                 * the item is copied the queue is full to other writers. */
+                BaseType_t sendInPlace( const T & xItem,
+                                        TickType_t xTicksToWait ) noexcept
+                {
+                    void * pvSlot;
+                    BaseType_t xReturn;
+
+                    xReturn = xQueueReserve( xHandle, &pvSlot, xTicksToWait );
+
+                    if( xReturn == pdPASS )
+                    {
+                        std::memcpy( pvSlot, &xItem, sizeof( T ) );
+                        ( void ) xQueueCommit( xHandle );
+                    }
+
+                    return xReturn;
+                }
+
+                /* Like receive(), with the item copied out of the queue storage
+                 * by the caller.  Only for a queue with a single reader, as
+                 * xQueuePeekRef() hands out one item at a time. */
+                BaseType_t receiveInPlace( T & xItem,
+                                           TickType_t xTicksToWait ) noexcept
+                {
+                    void * pvSlot;
+                    BaseType_t xReturn;
+
+                    xReturn = xQueuePeekRef( xHandle, &pvSlot, xTicksToWait );
+
+                    if( xReturn == pdPASS )
+                    {
+                        std::memcpy( &xItem, pvSlot, sizeof( T ) );
+                        ( void ) xQueueRelease( xHandle );
+                    }
+
+                    return xReturn;
+                }
+
+            #endif /* configUSE_QUEUE_ZERO_COPY */
+
+        private:
+            QueueHandle_t xHandle;
+            StaticQueue_t xQueueBuffer;
+
+            /* Every slot starts at a multiple of sizeof( T ) from here, so is
+             * aligned for a T. */
+            alignas( T ) uint8_t ucStorage[ N * sizeof( T ) ];
+    };
+}
+
+#endif /* FREERTOS_QUEUE_HPP */
@@ -0,0 +1,153 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A stream buffer that holds N bytes, in static storage.
+ *
+ * StreamBuffer<N> holds the stream buffer structure and its storage, so
+ * declaring one creates the stream buffer with xStreamBufferCreateStatic()
+ * without touching the FreeRTOS heap.  The storage is one byte longer than N,
+ * as the kernel keeps one byte free to tell a full buffer from an empty one,
+ * so N bytes can be written before the buffer is full, as with
+ * xStreamBufferCreate( N, ... ).
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h.  As
+ * with the C API, only one task or interrupt may write and only one read.
+ *
+ * Example:
+ * @code{cpp}
+ *  static freertos::StreamBuffer< 128 > xUartRx;
+ *
+ *  void USART1_IRQHandler( void )
+ *  {
+ *      BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *      uint8_t ucByte = ( uint8_t ) USART_ReceiveData( USART1 );
+ *
+ *      ( void ) xUartRx.sendFromISR( &ucByte, 1, &xHigherPriorityTaskWoken );
+ *      portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ *  }
+ * @endcode
+ */
+
+#ifndef FREERTOS_STREAM_BUFFER_HPP
+#define FREERTOS_STREAM_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error freertos/stream_buffer.hpp creates stream buffers with xStreamBufferCreateStatic() and needs configSUPPORT_STATIC_ALLOCATION set to 1.
+#endif
+
+namespace freertos
+{
+    template< size_t N >
+    class StreamBuffer
+    {
+        static_assert( N > 0U, "a stream buffer holds at least one byte" );
+
+        public:
+            /* A task blocked in receive() is unblocked once xTriggerLevelBytes
+             * bytes are in the buffer, as for xStreamBufferCreate(). */
+            explicit StreamBuffer( size_t xTriggerLevelBytes = 1U ) noexcept
+            {
+                configASSERT( xTriggerLevelBytes <= N );
+
+                xHandle = xStreamBufferCreateStatic( sizeof( ucStorage ), xTriggerLevelBytes, ucStorage, &xStreamBufferBuffer );
+                configASSERT( xHandle );
+            }
+
+            StreamBuffer( const StreamBuffer & ) = delete;
+            StreamBuffer & operator=( const StreamBuffer & ) = delete;
+
+            ~StreamBuffer()
+            {
+                vStreamBufferDelete( xHandle );
+            }
+
+            /* For the parts of the C API that have no method, such as
+             * xWaiterAddStreamBuffer(). */
+            StreamBufferHandle_t getHandle() const noexcept
+            {
+                return xHandle;
+            }
+
+            size_t send( const void * pvTxData,
+                         size_t xDataLengthBytes,
+                         TickType_t xTicksToWait ) noexcept
+            {
+                return xStreamBufferSend( xHandle, pvTxData, xDataLengthBytes, xTicksToWait );
+            }
+
+            size_t receive( void * pvRxData,
+                            size_t xBufferLengthBytes,
+                            TickType_t xTicksToWait ) noexcept
+            {
+                return xStreamBufferReceive( xHandle, pvRxData, xBufferLengthBytes, xTicksToWait );
+            }
+
+            size_t sendFromISR( const void * pvTxData,
+                                size_t xDataLengthBytes,
+                                BaseType_t * pxHigherPriorityTaskWoken ) noexcept
+            {
+                return xStreamBufferSendFromISR( xHandle, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
+            }
+
+            size_t receiveFromISR( void * pvRxData,
+                                   size_t xBufferLengthBytes,
+                                   BaseType_t * pxHigherPriorityTaskWoken ) noexcept
+            {
+                return xStreamBufferReceiveFromISR( xHandle, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken );
+            }
+
+            size_t getBytesAvailable() const noexcept
+            {
+                return xStreamBufferBytesAvailable( xHandle );
+            }
+
+            size_t getSpacesAvailable() const noexcept
+            {
+                return xStreamBufferSpacesAvailable( xHandle );
+            }
+
+            BaseType_t reset() noexcept
+            {
+                return xStreamBufferReset( xHandle );
+            }
+
+        private:
+            StreamBufferHandle_t xHandle;
+            StaticStreamBuffer_t xStreamBufferBuffer;
+            uint8_t ucStorage[ N + 1U ];
+    };
+}
+
+#endif /* FREERTOS_STREAM_BUFFER_HPP */
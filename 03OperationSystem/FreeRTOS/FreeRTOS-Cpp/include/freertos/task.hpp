@@ -0,0 +1,109 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A task with its TCB and a stack StackWords words deep in static storage.
+ *
+ * StaticTask<StackWords> reserves the memory of a task where it is declared,
+ * so the task is created with xTaskCreateStatic() without touching the
+ * FreeRTOS heap, and its RAM shows up in the .bss size at link time rather
+ * than in the heap at run time.  The task is not created until start() is
+ * called, so a StaticTask can be a global constructed before main().
+ *
+ * A StaticTask does not delete its task when it goes out of scope, as its
+ * storage normally lives for the whole program.  One that does not - on the
+ * stack of another task, say - must have its task deleted first.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h.
+ *
+ * Example:
+ * @code{cpp}
+ *  static freertos::StaticTask< 256 > xSensorTask;
+ *
+ *  int main( void )
+ *  {
+ *      ( void ) xSensorTask.start( vSensorTask, "sensor", NULL, tskIDLE_PRIORITY + 2 );
+ *      vTaskStartScheduler();
+ *  }
+ * @endcode
+ */
+
+#ifndef FREERTOS_TASK_HPP
+#define FREERTOS_TASK_HPP
+
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error freertos/task.hpp creates tasks with xTaskCreateStatic() and needs configSUPPORT_STATIC_ALLOCATION set to 1.
+#endif
+
+namespace freertos
+{
+    template< uint32_t StackWords >
+    class StaticTask
+    {
+        static_assert( StackWords >= configMINIMAL_STACK_SIZE, "the stack is smaller than configMINIMAL_STACK_SIZE" );
+
+        public:
+            StaticTask() noexcept = default;
+            StaticTask( const StaticTask & ) = delete;
+            StaticTask & operator=( const StaticTask & ) = delete;
+
+            /* Creates the task, as xTaskCreateStatic() would.  Can be called
+             * again once another task has deleted it; a task that deleted
+             * itself is only done with its storage once the idle task has
+             * run. */
+            TaskHandle_t start( TaskFunction_t pxTaskCode,
+                                const char * pcName,
+                                void * pvParameters,
+                                UBaseType_t uxPriority ) noexcept
+            {
+                xHandle = xTaskCreateStatic( pxTaskCode, pcName, StackWords, pvParameters, uxPriority, uxStack, &xTaskBuffer );
+                configASSERT( xHandle );
+
+                return xHandle;
+            }
+
+            /* The handle returned by the last start(), or NULL before the
+             * first. */
+            TaskHandle_t getHandle() const noexcept
+            {
+                return xHandle;
+            }
+
+        private:
+            TaskHandle_t xHandle = nullptr;
+            StaticTask_t xTaskBuffer;
+            StackType_t uxStack[ StackWords ];
+    };
+}
+
+#endif /* FREERTOS_TASK_HPP */
@@ -40,6 +40,10 @@
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_WAITERS == 1 )
+    #include "waiter.h"
+#endif
+
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -70,11 +74,30 @@ typedef struct EventGroupDef_t
         UBaseType_t uxEventGroupNumber;
     #endif
 
+    #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+        EventBits_t uxPendingBits;              /*< Bits set from an interrupt while the scheduler was suspended.  Non-zero while the event group is on the pending list. */
+        struct EventGroupDef_t * pxNextPending; /*< Next event group on the pending list. */
+    #endif
+
+    #if ( configUSE_WAITERS == 1 )
+        struct WaiterDef_t * pxWaiter; /*< The waiter the event group was added to, or NULL. */
+        EventBits_t uxWaiterEventBits; /*< Setting any of these bits makes the event group ready in pxWaiter. */
+        uint32_t ulWaiterBits;         /*< The ready bits the event group sets in pxWaiter. */
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
 } EventGroup_t;
 
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+/* Event groups with bits set from an interrupt while the scheduler was
+ * suspended, most recent first.  Only accessed with interrupts masked. */
+    PRIVILEGED_DATA static EventGroup_t * pxPendingEventGroups = NULL;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -89,6 +112,20 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+/*
+ * Set uxBitsToSet in pxEventBits and make ready every task whose wait
+ * condition is then met.  Called with interrupts masked and the scheduler not
+ * suspended, so the event list and the ready lists can be updated directly.
+ * Returns pdTRUE if a task with a priority above the running task was
+ * unblocked.
+ */
+    static BaseType_t prvSetBitsFromISR( EventGroup_t * pxEventBits,
+                                         const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -118,6 +155,21 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+            {
+                pxEventBits->uxPendingBits = 0;
+                pxEventBits->pxNextPending = NULL;
+            }
+            #endif
+
+            #if ( configUSE_WAITERS == 1 )
+            {
+                pxEventBits->pxWaiter = NULL;
+                pxEventBits->uxWaiterEventBits = 0;
+                pxEventBits->ulWaiterBits = 0U;
+            }
+            #endif
+
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note that
@@ -169,6 +221,21 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+            {
+                pxEventBits->uxPendingBits = 0;
+                pxEventBits->pxNextPending = NULL;
+            }
+            #endif
+
+            #if ( configUSE_WAITERS == 1 )
+            {
+                pxEventBits->pxWaiter = NULL;
+                pxEventBits->uxWaiterEventBits = 0;
+                pxEventBits->ulWaiterBits = 0U;
+            }
+            #endif
+
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note this
@@ -619,6 +686,19 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
         /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
          * bit was set in the control word. */
         pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+        #if ( configUSE_WAITERS == 1 )
+        {
+            if( ( pxEventBits->pxWaiter != NULL ) && ( ( uxBitsToSet & pxEventBits->uxWaiterEventBits ) != ( EventBits_t ) 0 ) )
+            {
+                vWaiterNotify( pxEventBits->pxWaiter, pxEventBits->ulWaiterBits );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_WAITERS */
     }
     ( void ) xTaskResumeAll();
 
@@ -633,6 +713,13 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 
     configASSERT( pxEventBits );
 
+    #if ( configUSE_WAITERS == 1 )
+    {
+        /* Remove the event group from its waiter first. */
+        configASSERT( pxEventBits->pxWaiter == NULL );
+    }
+    #endif
+
     pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 
     vTaskSuspendAll();
@@ -649,6 +736,36 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     }
     ( void ) xTaskResumeAll();
 
+    #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+    {
+        EventGroup_t ** ppxPending;
+
+        /* Bits set from an interrupt are normally applied by the
+         * xTaskResumeAll() above, but not if the caller had already suspended
+         * the scheduler. */
+        taskENTER_CRITICAL();
+        {
+            if( pxEventBits->uxPendingBits != ( EventBits_t ) 0 )
+            {
+                ppxPending = &pxPendingEventGroups;
+
+                while( *ppxPending != pxEventBits )
+                {
+                    ppxPending = &( ( *ppxPending )->pxNextPending );
+                }
+
+                *ppxPending = pxEventBits->pxNextPending;
+                pxEventBits->uxPendingBits = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* configUSE_EVENT_GROUP_ISR_FAST_PATH */
+
     #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
     {
         /* The event group can only have been allocated dynamically - free
@@ -727,7 +844,83 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+    BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                          const EventBits_t uxBitsToSet,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        /* Check the user is not attempting to set the bits used by the kernel
+         * itself. */
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED )
+            {
+                /* No task is part way through updating the event list, so
+                 * the waiting tasks can be unblocked from here. */
+                xHigherPriorityTaskWoken = prvSetBitsFromISR( pxEventBits, uxBitsToSet );
+            }
+            else if( uxBitsToSet != ( EventBits_t ) 0 )
+            {
+                /* The task that suspended the scheduler might be using the
+                 * event list, so leave the bits for xTaskResumeAll(). */
+                if( pxEventBits->uxPendingBits == ( EventBits_t ) 0 )
+                {
+                    pxEventBits->pxNextPending = pxPendingEventGroups;
+                    pxPendingEventGroups = pxEventBits;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxEventBits->uxPendingBits |= uxBitsToSet;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_WAITERS == 1 )
+            {
+                /* The waiter's task is woken straight away even if the bits
+                 * are left for xTaskResumeAll(), as it cannot run before they
+                 * are applied. */
+                if( ( pxEventBits->pxWaiter != NULL ) && ( ( uxBitsToSet & pxEventBits->uxWaiterEventBits ) != ( EventBits_t ) 0 ) )
+                {
+                    vWaiterNotifyFromISR( pxEventBits->pxWaiter, pxEventBits->ulWaiterBits, &xHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_WAITERS */
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdPASS;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
@@ -741,7 +934,102 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+    static BaseType_t prvSetBitsFromISR( EventGroup_t * pxEventBits,
+                                         const EventBits_t uxBitsToSet )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd;
+        List_t const * pxList;
+        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+        BaseType_t xWaitForAllBits, xReturn = pdFALSE;
+
+        pxList = &( pxEventBits->xTasksWaitingForBits );
+        pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        pxListItem = listGET_HEAD_ENTRY( pxList );
+
+        /* Set the bits. */
+        pxEventBits->uxEventBits |= uxBitsToSet;
+
+        /* See if the new bit value should unblock any tasks.  This is the
+         * same test xEventGroupSetBits() makes. */
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+            xWaitForAllBits = ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE;
+
+            if( prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor, xWaitForAllBits ) != pdFALSE )
+            {
+                /* The bits match.  Should the bits be cleared on exit? */
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    uxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxListItem = pxNext;
+        }
+
+        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+         * bit was set in the control word. */
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_ISR_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+    void vEventGroupProcessPendingBits( void )
+    {
+        EventGroup_t * pxEventBits;
+        EventBits_t uxBitsToSet;
+
+        /* Called from a critical section once the scheduler is no longer
+         * suspended.  Any task unblocked here with a priority above the running
+         * task sets xYieldPending, which xTaskResumeAll() then acts on. */
+        while( pxPendingEventGroups != NULL )
+        {
+            pxEventBits = pxPendingEventGroups;
+            pxPendingEventGroups = pxEventBits->pxNextPending;
+
+            uxBitsToSet = pxEventBits->uxPendingBits;
+            pxEventBits->uxPendingBits = 0;
+
+            ( void ) prvSetBitsFromISR( pxEventBits, uxBitsToSet );
+        }
+    }
+
+#endif /* configUSE_EVENT_GROUP_ISR_FAST_PATH */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -776,3 +1064,80 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITERS == 1 )
+
+    BaseType_t xEventGroupAttachWaiter( EventGroupHandle_t xEventGroup,
+                                        WaiterHandle_t xWaiter,
+                                        EventBits_t uxBitsToWaitFor,
+                                        uint32_t ulReadyBits )
+    {
+        EventGroup_t * const pxEventBits = xEventGroup;
+        BaseType_t xReturn;
+
+        configASSERT( pxEventBits );
+        configASSERT( ( uxBitsToWaitFor & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxEventBits->pxWaiter == NULL )
+            {
+                pxEventBits->pxWaiter = xWaiter;
+                pxEventBits->uxWaiterEventBits = uxBitsToWaitFor;
+                pxEventBits->ulWaiterBits = ulReadyBits;
+
+                /* Bits set before the event group was added did not notify
+                 * the waiter. */
+                if( ( pxEventBits->uxEventBits & uxBitsToWaitFor ) != ( EventBits_t ) 0 )
+                {
+                    vWaiterNotify( xWaiter, ulReadyBits );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITERS == 1 )
+
+    BaseType_t xEventGroupDetachWaiter( EventGroupHandle_t xEventGroup,
+                                        WaiterHandle_t xWaiter )
+    {
+        EventGroup_t * const pxEventBits = xEventGroup;
+        BaseType_t xReturn;
+
+        configASSERT( pxEventBits );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxEventBits->pxWaiter == xWaiter )
+            {
+                pxEventBits->pxWaiter = NULL;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITERS */
+/*-----------------------------------------------------------*/
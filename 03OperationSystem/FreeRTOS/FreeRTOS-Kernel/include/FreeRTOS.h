@@ -393,6 +393,16 @@
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+#ifndef configUSE_TRACE_RECORDER
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+    /* Define the trace macros to record into the binary trace buffer of
+     * trace_recorder.c. */
+    #include "trace_recorder.h"
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -415,6 +425,26 @@
     #define traceTASK_SWITCHED_IN()
 #endif
 
+#ifndef traceISR_ENTER
+
+/* Called on entry to the tick interrupt, before the tick count is
+ * incremented. */
+    #define traceISR_ENTER()
+#endif
+
+#ifndef traceISR_EXIT
+
+/* Called on exit from the tick interrupt when it does not cause a context
+ * switch. */
+    #define traceISR_EXIT()
+#endif
+
+#ifndef traceISR_EXIT_TO_SCHEDULER
+
+/* Called on exit from the tick interrupt when it causes a context switch. */
+    #define traceISR_EXIT_TO_SCHEDULER()
+#endif
+
 #ifndef traceINCREASE_TICK_COUNT
 
 /* Called before stepping the tick count after waking from tickless idle
@@ -539,6 +569,16 @@
     #define traceTAKE_MUTEX_RECURSIVE_FAILED( pxMutex )
 #endif
 
+/* A take or give of a mutex on the configUSE_MUTEX_FAST_PATH lock word, which
+ * leaves uxMessagesWaiting at 0. */
+#ifndef traceTAKE_MUTEX
+    #define traceTAKE_MUTEX( pxMutex )    traceQUEUE_RECEIVE( pxMutex )
+#endif
+
+#ifndef traceGIVE_MUTEX
+    #define traceGIVE_MUTEX( pxMutex )    traceQUEUE_SEND( pxMutex )
+#endif
+
 #ifndef traceCREATE_COUNTING_SEMAPHORE
     #define traceCREATE_COUNTING_SEMAPHORE()
 #endif
@@ -599,6 +639,23 @@
     #define traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue )
 #endif
 
+/* The batch functions of configUSE_QUEUE_BATCH move uxCount items at once. */
+#ifndef traceQUEUE_SEND_MULTIPLE
+    #define traceQUEUE_SEND_MULTIPLE( pxQueue, uxCount )    traceQUEUE_SEND( pxQueue )
+#endif
+
+#ifndef traceQUEUE_SEND_MULTIPLE_FROM_ISR
+    #define traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxCount )    traceQUEUE_SEND_FROM_ISR( pxQueue )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE
+    #define traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxCount )    traceQUEUE_RECEIVE( pxQueue )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR
+    #define traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxCount )    traceQUEUE_RECEIVE_FROM_ISR( pxQueue )
+#endif
+
 #ifndef traceQUEUE_DELETE
     #define traceQUEUE_DELETE( pxQueue )
 #endif
@@ -619,6 +676,10 @@
     #define traceTASK_DELAY_UNTIL( x )
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
     #define traceTASK_DELAY()
 #endif
@@ -807,6 +868,78 @@
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceMEM_POOL_CREATE
+    #define traceMEM_POOL_CREATE( pxMemPool )
+#endif
+
+#ifndef traceMEM_POOL_ALLOC
+    #define traceMEM_POOL_ALLOC( pxMemPool, pvBlock )
+#endif
+
+#ifndef traceMEM_POOL_ALLOC_FAILED
+    #define traceMEM_POOL_ALLOC_FAILED( pxMemPool )
+#endif
+
+#ifndef traceMEM_POOL_FREE
+    #define traceMEM_POOL_FREE( pxMemPool, pvBlock )
+#endif
+
+#ifndef traceRW_LOCK_CREATE
+    #define traceRW_LOCK_CREATE( pxRWLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RW_LOCK_READ
+    #define traceBLOCKING_ON_RW_LOCK_READ( pxRWLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RW_LOCK_WRITE
+    #define traceBLOCKING_ON_RW_LOCK_WRITE( pxRWLock )
+#endif
+
+#ifndef traceRW_LOCK_TAKE_FAILED
+    #define traceRW_LOCK_TAKE_FAILED( pxRWLock )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE
+    #define traceWORK_QUEUE_CREATE( pxWorkQueue )
+#endif
+
+#ifndef traceWORK_QUEUE_SUBMIT
+    #define traceWORK_QUEUE_SUBMIT( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceWORK_QUEUE_COALESCE
+    #define traceWORK_QUEUE_COALESCE( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceWORK_ITEM_RUN
+    #define traceWORK_ITEM_RUN( pxWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceMSG_BUS_CREATE
+    #define traceMSG_BUS_CREATE( pxMsgBus )
+#endif
+
+#ifndef traceMSG_BUS_PUBLISH
+    #define traceMSG_BUS_PUBLISH( pxMsgTopic, pvMessage, uxDelivered )
+#endif
+
+#ifndef traceMSG_BUS_DROP
+    #define traceMSG_BUS_DROP( pxMsgSubscriber, pvMessage )
+#endif
+
+#ifndef traceWAITER_CREATE
+    #define traceWAITER_CREATE( pxWaiter )
+#endif
+
+#ifndef traceBLOCKING_ON_WAITER
+    #define traceBLOCKING_ON_WAITER( pxWaiter )
+#endif
+
+#ifndef traceWAITER_READY
+    #define traceWAITER_READY( pxWaiter, ulReadyBits )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -889,6 +1022,104 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+#ifndef configUSE_DELAYED_TASK_HEAP
+    #define configUSE_DELAYED_TASK_HEAP    0
+#endif
+
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_QUEUE_BATCH
+    #define configUSE_QUEUE_BATCH    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+    #define configUSE_STREAM_BUFFER_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_ISR_FAST_PATH
+    #define configUSE_EVENT_GROUP_ISR_FAST_PATH    0
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 ) && ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+    #error configUSE_EVENT_GROUP_ISR_FAST_PATH needs xTaskGetSchedulerState().  Set INCLUDE_xTaskGetSchedulerState to 1 in FreeRTOSConfig.h.
+#endif
+
+#ifndef configUSE_EDF_SCHEDULER
+    #define configUSE_EDF_SCHEDULER    0
+#endif
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    #ifndef configEDF_TASK_PRIORITY
+        #error configUSE_EDF_SCHEDULER is 1, so configEDF_TASK_PRIORITY must be defined in FreeRTOSConfig.h as the priority the earliest deadline first tasks run at.
+    #endif
+
+    #if ( configEDF_TASK_PRIORITY >= configMAX_PRIORITIES ) || ( configEDF_TASK_PRIORITY == 0 )
+        #error configEDF_TASK_PRIORITY must be above the idle priority and below configMAX_PRIORITIES.
+    #endif
+
+    #if ( INCLUDE_xTaskDelayUntil != 1 )
+        #error configUSE_EDF_SCHEDULER needs xTaskDelayUntil() to release the jobs of EDF tasks.  Set INCLUDE_xTaskDelayUntil to 1 in FreeRTOSConfig.h.
+    #endif
+#endif
+
+#ifndef configUSE_EVENT_LIST_INDEX
+    #define configUSE_EVENT_LIST_INDEX    0
+#endif
+
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+/* The index of an event list keeps a bit and a list item pointer for each of
+ * at most 32 slots.  Up to 32 priorities each priority has a slot of its own.
+ * Above that each slot covers a group of adjacent priorities, so the index
+ * never costs more than 32 pointers per event list. */
+    #define tskEVENT_LIST_PRIORITIES_PER_SLOT    ( ( configMAX_PRIORITIES + 31 ) / 32 )
+    #define tskEVENT_LIST_SLOTS                  ( ( configMAX_PRIORITIES + tskEVENT_LIST_PRIORITIES_PER_SLOT - 1 ) / tskEVENT_LIST_PRIORITIES_PER_SLOT )
+#endif
+
+#ifndef configUSE_MUTEX_FAST_PATH
+    #define configUSE_MUTEX_FAST_PATH    0
+#endif
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+    #if ( configUSE_MUTEXES != 1 )
+        #error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_FAST_PATH.
+    #endif
+
+    #ifndef portCOMPARE_AND_SWAP_POINTER
+        #error configUSE_MUTEX_FAST_PATH needs portCOMPARE_AND_SWAP_POINTER(), which this port does not provide.
+    #endif
+#endif
+
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+    #define configUSE_MUTEX_PRIORITY_CEILING    0
+#endif
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_PRIORITY_CEILING.
+#endif
+
+#ifndef configUSE_WAITERS
+    #define configUSE_WAITERS    0
+#endif
+
+#if ( ( configUSE_WAITERS == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) )
+    #error configUSE_WAITERS needs xTaskGetCurrentTaskHandle().  Set INCLUDE_xTaskGetCurrentTaskHandle to 1 in FreeRTOSConfig.h.
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    5
+#endif
+
+#ifndef configTIMER_WHEEL_LEVELS
+    #define configTIMER_WHEEL_LEVELS    3
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -921,6 +1152,16 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+/* Ports whose optimised task selection holds the ready priorities in more
+ * than one word define their own bit map type. */
+#ifndef portREADY_PRIORITIES_TYPE
+    #define portREADY_PRIORITIES_TYPE    UBaseType_t
+#endif
+
+#ifndef portHAS_READY_PRIORITY_ABOVE_IDLE
+    #define portHAS_READY_PRIORITY_ABOVE_IDLE( uxReadyPriorities )    ( ( uxReadyPriorities ) > ( UBaseType_t ) 0x01 )
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -986,6 +1227,18 @@
     #define configRUN_TIME_COUNTER_TYPE    uint32_t
 #endif
 
+#ifndef configRUN_TIME_STATS_ISR_ATTRIBUTION
+
+/* Set to 1 to take the time spent in interrupts that call
+ * taskRUN_TIME_ISR_ENTER()/taskRUN_TIME_ISR_EXIT() out of the run time of the
+ * task they interrupted and count it separately. */
+    #define configRUN_TIME_STATS_ISR_ATTRIBUTION    0
+#endif
+
+#if ( ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configRUN_TIME_STATS_ISR_ATTRIBUTION is 1 but configGENERATE_RUN_TIME_STATS is not.  Set configGENERATE_RUN_TIME_STATS to 1 in FreeRTOSConfig.h.
+#endif
+
 #ifndef configMESSAGE_BUFFER_LENGTH_TYPE
 
 /* Defaults to size_t for backward compatibility, but can be overridden
@@ -1240,6 +1493,16 @@ typedef struct xSTATIC_LIST
     #endif
 } StaticList_t;
 
+/* See the comments above the struct xSTATIC_LIST_ITEM definition. */
+typedef struct xSTATIC_EVENT_LIST
+{
+    StaticList_t xDummy1;
+    #if ( configUSE_EVENT_LIST_INDEX == 1 )
+        uint32_t ulDummy2;
+        void * pvDummy3[ tskEVENT_LIST_SLOTS ];
+    #endif
+} StaticEventList_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1282,7 +1545,10 @@ typedef struct xSTATIC_TCB
         void * pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        configRUN_TIME_COUNTER_TYPE ulDummy16;
+        configRUN_TIME_COUNTER_TYPE ulDummy16[ 2 ];
+        #if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+            configRUN_TIME_COUNTER_TYPE ulDummy24[ 2 ];
+        #endif
     #endif
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xDummy17;
@@ -1301,6 +1567,13 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        void * pxDummy23[ 3 ];
+    #endif
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        TickType_t xDummy25[ 3 ];
+        UBaseType_t uxDummy26;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1327,10 +1600,19 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy2;
     } u;
 
-    StaticList_t xDummy3[ 2 ];
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxDummy12[ 2 ];
+    #endif
+
+    StaticEventList_t xDummy3[ 2 ];
     UBaseType_t uxDummy4[ 3 ];
     uint8_t ucDummy5[ 2 ];
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy10;
+        void * pvDummy11;
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy6;
     #endif
@@ -1339,6 +1621,11 @@ typedef struct xSTATIC_QUEUE
         void * pvDummy7;
     #endif
 
+    #if ( configUSE_WAITERS == 1 )
+        void * pvDummy12;
+        uint32_t ulDummy13;
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
@@ -1369,6 +1656,17 @@ typedef struct xSTATIC_EVENT_GROUP
         UBaseType_t uxDummy3;
     #endif
 
+    #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+        TickType_t xDummy5;
+        void * pvDummy6;
+    #endif
+
+    #if ( configUSE_WAITERS == 1 )
+        void * pvDummy7;
+        TickType_t xDummy8;
+        uint32_t ulDummy9;
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
@@ -1426,11 +1724,96 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_WAITERS == 1 )
+        void * pvDummy6;
+        uint32_t ulDummy7;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real single-producer/single-consumer ring
+ * structure is not accessible to the application.  The StaticSpscRing_t
+ * structure below is provided so the memory for a ring can be allocated
+ * statically.  Its size and alignment requirements match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_SPSC_RING
+{
+    UBaseType_t uxDummy1[ 4 ];
+    void * pvDummy2[ 2 ];
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+} StaticSpscRing_t;
+
+/*
+ * The StaticMemPool_t structure below has the same size and alignment as the
+ * memory pool structure used internally by mem_pool.c, so the memory for a
+ * pool can be allocated statically without exposing the real structure.
+ */
+typedef struct xSTATIC_MEM_POOL
+{
+    void * pvDummy1[ 4 ];
+    size_t xDummy2;
+    UBaseType_t uxDummy3[ 3 ];
+    size_t xDummy4[ 2 ];
+    uint8_t ucDummy5;
+} StaticMemPool_t;
+
+/*
+ * The StaticRWLock_t structure below has the same size and alignment as the
+ * reader-writer lock structure used internally by rw_lock.c, so the memory for
+ * a lock can be allocated statically without exposing the real structure.
+ */
+typedef struct xSTATIC_RW_LOCK
+{
+    void * pvDummy1;
+    StaticEventList_t xDummy2[ 2 ];
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+} StaticRWLock_t;
+
+/*
+ * The StaticWorkQueue_t and StaticWorkItem_t structures below have the same
+ * size and alignment as the work queue and work item structures used
+ * internally by work_queue.c, so both can be allocated statically without
+ * exposing the real structures.
+ */
+typedef struct xSTATIC_WORK_QUEUE
+{
+    void * pvDummy1[ 3 ];
+    UBaseType_t uxDummy2;
+    uint32_t ulDummy3[ 3 ];
+    UBaseType_t uxDummy4;
+    configRUN_TIME_COUNTER_TYPE ulDummy5[ 3 ];
+    uint8_t ucDummy6;
+} StaticWorkQueue_t;
+
+typedef struct xSTATIC_WORK_ITEM
+{
+    void * pvDummy1[ 3 ];
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy2;
+    #endif
+    uint8_t ucDummy3;
+} StaticWorkItem_t;
+
+/*
+ * The StaticWaiter_t structure below has the same size and alignment as the
+ * waiter structure used internally by waiter.c, so the memory for a waiter can
+ * be allocated statically without exposing the real structure.
+ */
+typedef struct xSTATIC_WAITER
+{
+    uint32_t ulDummy1;
+    void * pvDummy2;
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+} StaticWaiter_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
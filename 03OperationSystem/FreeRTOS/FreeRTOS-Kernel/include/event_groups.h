@@ -391,6 +391,9 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * @return If the request to execute the function was posted successfully then
  * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
  * if the timer service queue was full.
+ * With configUSE_EVENT_GROUP_ISR_FAST_PATH set to 1 pdPASS is always
+ * returned, and *pxHigherPriorityTaskWoken is set to pdTRUE if a task with a
+ * priority above that of the interrupted task was unblocked.
  *
  * Example usage:
  * @code{c}
@@ -517,6 +520,15 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_ISR_FAST_PATH is set to 1 in FreeRTOSConfig.h the
+ * timer task is not used.  The bits are set and the tasks they unblock are
+ * made ready from within the interrupt, which takes time proportional to the
+ * number of tasks waiting on the event group.  If the interrupt occurs while
+ * the scheduler is suspended the bits are held pending in the event group and
+ * applied, the same way, when the scheduler is resumed.  Either way the
+ * unblocked task can run as soon as the interrupt exits, instead of after the
+ * timer task has run.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -573,7 +585,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
@@ -767,6 +779,13 @@ void vEventGroupSetBitsCallback( void * pvEventGroup,
 void vEventGroupClearBitsCallback( void * pvEventGroup,
                                    const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+/* For internal use only - called by xTaskResumeAll() from a critical section to
+ * apply the bits set by interrupts while the scheduler was suspended. */
+    void vEventGroupProcessPendingBits( void ) PRIVILEGED_FUNCTION;
+#endif
+
 
 #if ( configUSE_TRACE_FACILITY == 1 )
     UBaseType_t uxEventGroupGetNumber( void * xEventGroup ) PRIVILEGED_FUNCTION;
@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Memory pools hand out fixed size blocks from a storage area reserved when
+ * the pool is created.  Allocating and freeing a block takes constant time in
+ * a short critical section, without suspending the scheduler, so unlike
+ * pvPortMalloc() and vPortFree() they can be used from interrupts through
+ * pvMemPoolAllocFromISR() and vMemPoolFreeFromISR().  Create one pool per
+ * message size the application uses.
+ *
+ * A pool created with xMemPoolCreate() takes its structure and storage from
+ * the FreeRTOS heap in one pvPortMalloc() call, so it is counted by
+ * xPortGetFreeHeapSize() and vPortGetHeapStats() as a single allocated block.
+ * vMemPoolGetHeapStats() reports the use of the blocks inside a pool in the
+ * same HeapStats_t form.
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mem_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemPoolCreate() returns an MemPoolHandle_t variable that can then be used
+ * as a parameter to pvMemPoolAlloc(), vMemPoolFree(), etc.
+ */
+struct MemPoolDef_t;
+typedef struct MemPoolDef_t * MemPoolHandle_t;
+
+/**
+ * The size each block of a pool really takes: xBlockSize rounded up to a
+ * multiple of portBYTE_ALIGNMENT, and never less than a pointer.
+ */
+#define memPOOL_BLOCK_SIZE( xBlockSize ) \
+    ( ( ( ( ( size_t ) ( xBlockSize ) ) < sizeof( void * ) ? sizeof( void * ) : ( ( size_t ) ( xBlockSize ) ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * The size of the storage area xMemPoolCreateStatic() needs for uxBlockCount
+ * blocks of xBlockSize bytes.
+ */
+#define memPOOL_STORAGE_SIZE( xBlockSize, uxBlockCount ) \
+    ( memPOOL_BLOCK_SIZE( xBlockSize ) * ( size_t ) ( uxBlockCount ) )
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * MemPoolHandle_t xMemPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount );
+ * @endcode
+ *
+ * Creates a new memory pool using dynamically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xMemPoolCreate() to be available.
+ *
+ * @param xBlockSize The size, in bytes, of each block.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @return The handle of the created pool, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * \defgroup xMemPoolCreate xMemPoolCreate
+ * \ingroup MemPoolManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MemPoolHandle_t xMemPoolCreate( size_t xBlockSize,
+                                    UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize,
+ *                                       UBaseType_t uxBlockCount,
+ *                                       uint8_t * const pucPoolStorageArea,
+ *                                       StaticMemPool_t * const pxStaticMemPool );
+ * @endcode
+ *
+ * Creates a new memory pool using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xMemPoolCreateStatic() to be available.
+ *
+ * @param xBlockSize The size, in bytes, of each block.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @param pucPoolStorageArea Must point to a uint8_t array that is at least
+ * memPOOL_STORAGE_SIZE( xBlockSize, uxBlockCount ) bytes big, aligned to
+ * portBYTE_ALIGNMENT.
+ *
+ * @param pxStaticMemPool Must point to a variable of type StaticMemPool_t,
+ * which will be used to hold the pool's data structure.
+ *
+ * @return The handle of the created pool, or NULL if either
+ * pucPoolStorageArea or pxStaticMemPool is NULL.
+ *
+ * Example use:
+ * @code{c}
+ * #define CAN_FRAME_POOL_SIZE    16
+ *
+ * static uint8_t ucCanFrameStorage[ memPOOL_STORAGE_SIZE( sizeof( CanFrame_t ), CAN_FRAME_POOL_SIZE ) ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+ * static StaticMemPool_t xCanFramePoolStruct;
+ *
+ * xCanFramePool = xMemPoolCreateStatic( sizeof( CanFrame_t ),
+ *                                       CAN_FRAME_POOL_SIZE,
+ *                                       ucCanFrameStorage,
+ *                                       &xCanFramePoolStruct );
+ * @endcode
+ * \defgroup xMemPoolCreateStatic xMemPoolCreateStatic
+ * \ingroup MemPoolManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize,
+                                          UBaseType_t uxBlockCount,
+                                          uint8_t * const pucPoolStorageArea,
+                                          StaticMemPool_t * const pxStaticMemPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolDelete( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * Deletes a pool that was previously created using a call to xMemPoolCreate()
+ * or xMemPoolCreateStatic().  No block of the pool may be in use.
+ *
+ * @param xMemPool The handle of the pool to be deleted.
+ *
+ * \defgroup vMemPoolDelete vMemPoolDelete
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolDelete( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void * pvMemPoolAlloc( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * Takes a block from the pool.  Never blocks.  Use pvMemPoolAllocFromISR() to
+ * allocate from an interrupt service routine.
+ *
+ * @param xMemPool The handle of the pool.
+ *
+ * @return A pointer to a block of at least the block size the pool was created
+ * with, aligned to portBYTE_ALIGNMENT, or NULL if every block is in use.
+ *
+ * \defgroup pvMemPoolAlloc pvMemPoolAlloc
+ * \ingroup MemPoolManagement
+ */
+void * pvMemPoolAlloc( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void * pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * A version of pvMemPoolAlloc() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xMemPool The handle of the pool.
+ *
+ * @return A pointer to a block, or NULL if every block is in use.
+ *
+ * Example use:
+ * @code{c}
+ * void vCAN1_RX0_IRQHandler( void )
+ * {
+ * CanFrame_t * pxFrame = pvMemPoolAllocFromISR( xCanFramePool );
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  if( pxFrame != NULL )
+ *  {
+ *      vReadFrame( pxFrame );
+ *
+ *      // The receiving task frees the block with vMemPoolFree().
+ *      xQueueSendFromISR( xFrameQueue, &pxFrame, &xHigherPriorityTaskWoken );
+ *  }
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup pvMemPoolAllocFromISR pvMemPoolAllocFromISR
+ * \ingroup MemPoolManagement
+ */
+void * pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolFree( MemPoolHandle_t xMemPool, void * pvBlock );
+ * @endcode
+ *
+ * Returns a block to the pool it was allocated from.  Use
+ * vMemPoolFreeFromISR() to free from an interrupt service routine.
+ *
+ * @param xMemPool The handle of the pool.
+ *
+ * @param pvBlock The block, as returned by pvMemPoolAlloc() or
+ * pvMemPoolAllocFromISR().  NULL is ignored.
+ *
+ * \defgroup vMemPoolFree vMemPoolFree
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolFree( MemPoolHandle_t xMemPool,
+                   void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool, void * pvBlock );
+ * @endcode
+ *
+ * A version of vMemPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * \defgroup vMemPoolFreeFromISR vMemPoolFreeFromISR
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool,
+                          void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * UBaseType_t uxMemPoolGetFreeBlockCount( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * @return The number of blocks in the pool that are not in use.
+ *
+ * \defgroup uxMemPoolGetFreeBlockCount uxMemPoolGetFreeBlockCount
+ * \ingroup MemPoolManagement
+ */
+UBaseType_t uxMemPoolGetFreeBlockCount( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * UBaseType_t uxMemPoolGetMinimumEverFreeBlockCount( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * @return The lowest number of free blocks the pool has had since it was
+ * created - the high water mark of the pool.  A value of 0 means allocations
+ * may have failed, and the pool should be made larger.
+ *
+ * \defgroup uxMemPoolGetMinimumEverFreeBlockCount uxMemPoolGetMinimumEverFreeBlockCount
+ * \ingroup MemPoolManagement
+ */
+UBaseType_t uxMemPoolGetMinimumEverFreeBlockCount( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * size_t xMemPoolGetBlockSize( MemPoolHandle_t xMemPool );
+ * @endcode
+ *
+ * @return The size of each block, which is memPOOL_BLOCK_SIZE() of the size
+ * the pool was created with.
+ *
+ * \defgroup xMemPoolGetBlockSize xMemPoolGetBlockSize
+ * \ingroup MemPoolManagement
+ */
+size_t xMemPoolGetBlockSize( MemPoolHandle_t xMemPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mem_pool.h
+ *
+ * @code{c}
+ * void vMemPoolGetHeapStats( MemPoolHandle_t xMemPool, HeapStats_t * pxHeapStats );
+ * @endcode
+ *
+ * Fills a HeapStats_t structure with the state of the pool, the way
+ * vPortGetHeapStats() does for the heap, so the same reporting code can be
+ * used for both.  The free space, free block count and minimum ever free
+ * bytes are in units of whole blocks.
+ *
+ * \defgroup vMemPoolGetHeapStats vMemPoolGetHeapStats
+ * \ingroup MemPoolManagement
+ */
+void vMemPoolGetHeapStats( MemPoolHandle_t xMemPool,
+                           HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MEM_POOL_H ) */
@@ -0,0 +1,388 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A message bus passes messages from publishers to every task subscribed to
+ * the message's topic without copying them.  A publisher takes a message
+ * buffer from the bus with pvMsgBusAlloc(), writes the message in place, and
+ * hands it to uxMsgBusPublish().  Each subscriber of the topic receives a
+ * pointer to the same buffer from pvMsgBusReceive() and gives it back with
+ * vMsgBusRelease() once it has finished with it.  The buffer returns to the
+ * bus when the last subscriber releases it.
+ *
+ * The buffers come from a memory pool (mem_pool.h) created with the bus, so
+ * allocating one takes constant time and can be done from an interrupt.  Each
+ * buffer starts with a small header holding its reference count.
+ *
+ * Each subscription has a queue of message pointers whose length, given when
+ * subscribing, bounds how far that subscriber can fall behind.  A message
+ * published while a subscriber's queue is full is dropped for that subscriber
+ * only, and counted, so a slow subscriber never holds up the publisher or the
+ * other subscribers, and never holds more than its backlog of buffers.
+ *
+ * The bus, its topics and subscriptions are allocated from the FreeRTOS heap,
+ * so configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h.
+ */
+
+#ifndef MSG_BUS_H
+#define MSG_BUS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include msg_bus.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Types by which buses, topics and subscriptions are referenced.
+ */
+struct MsgBusDef_t;
+typedef struct MsgBusDef_t * MsgBusHandle_t;
+
+struct MsgTopicDef_t;
+typedef struct MsgTopicDef_t * MsgTopicHandle_t;
+
+struct MsgSubscriberDef_t;
+typedef struct MsgSubscriberDef_t * MsgSubscriberHandle_t;
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * MsgBusHandle_t xMsgBusCreate( size_t xMaxMessageSize, UBaseType_t uxMessageCount );
+ * @endcode
+ *
+ * Creates a message bus and the pool its message buffers come from.
+ *
+ * @param xMaxMessageSize The size, in bytes, of the largest message that will
+ * be published on the bus.
+ *
+ * @param uxMessageCount The number of message buffers.  Messages are in use
+ * from allocation until every subscriber has released them, so allow for the
+ * backlog of every subscription.
+ *
+ * @return The handle of the created bus, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * Example use:
+ * @code{c}
+ * MsgTopicHandle_t xImuTopic;
+ *
+ * void vImuDmaCompleteISR( void )
+ * {
+ * ImuFrame_t * pxFrame = pvMsgBusAllocFromISR( xSensorBus );
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  if( pxFrame != NULL )
+ *  {
+ *      vCopyImuSample( pxFrame );
+ *      uxMsgBusPublishFromISR( xImuTopic, pxFrame, sizeof( ImuFrame_t ), &xHigherPriorityTaskWoken );
+ *  }
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vControlTask( void * pvParameters )
+ * {
+ * MsgSubscriberHandle_t xImu = xMsgBusSubscribe( xImuTopic, 2 );
+ * ImuFrame_t * pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      pxFrame = pvMsgBusReceive( xImu, portMAX_DELAY );
+ *      vUpdateAttitude( pxFrame );
+ *      vMsgBusRelease( pxFrame );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMsgBusCreate xMsgBusCreate
+ * \ingroup MsgBus
+ */
+    MsgBusHandle_t xMsgBusCreate( size_t xMaxMessageSize,
+                                  UBaseType_t uxMessageCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * void vMsgBusDelete( MsgBusHandle_t xBus );
+ * @endcode
+ *
+ * Deletes a bus.  Its topics must have been deleted and every message
+ * released.
+ *
+ * \defgroup vMsgBusDelete vMsgBusDelete
+ * \ingroup MsgBus
+ */
+    void vMsgBusDelete( MsgBusHandle_t xBus ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * MsgTopicHandle_t xMsgBusCreateTopic( MsgBusHandle_t xBus );
+ * @endcode
+ *
+ * Creates a topic on a bus.
+ *
+ * @return The handle of the created topic, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * \defgroup xMsgBusCreateTopic xMsgBusCreateTopic
+ * \ingroup MsgBus
+ */
+    MsgTopicHandle_t xMsgBusCreateTopic( MsgBusHandle_t xBus ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * void vMsgBusDeleteTopic( MsgTopicHandle_t xTopic );
+ * @endcode
+ *
+ * Deletes a topic that has no subscribers left.
+ *
+ * \defgroup vMsgBusDeleteTopic vMsgBusDeleteTopic
+ * \ingroup MsgBus
+ */
+    void vMsgBusDeleteTopic( MsgTopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * MsgSubscriberHandle_t xMsgBusSubscribe( MsgTopicHandle_t xTopic, UBaseType_t uxBacklog );
+ * @endcode
+ *
+ * Subscribes to a topic.  Messages published from now on are delivered to
+ * the subscription until vMsgBusUnsubscribe() is called.  Only one task should
+ * receive from a subscription.
+ *
+ * @param xTopic The topic.
+ *
+ * @param uxBacklog The most messages the subscription can hold before new ones
+ * are dropped for it.
+ *
+ * @return The handle of the subscription, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * \defgroup xMsgBusSubscribe xMsgBusSubscribe
+ * \ingroup MsgBus
+ */
+    MsgSubscriberHandle_t xMsgBusSubscribe( MsgTopicHandle_t xTopic,
+                                            UBaseType_t uxBacklog ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * void vMsgBusUnsubscribe( MsgSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Ends a subscription.  Messages it still holds are released.
+ *
+ * \defgroup vMsgBusUnsubscribe vMsgBusUnsubscribe
+ * \ingroup MsgBus
+ */
+    void vMsgBusUnsubscribe( MsgSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * void * pvMsgBusAlloc( MsgBusHandle_t xBus );
+ * @endcode
+ *
+ * Takes a message buffer from the bus.  Never blocks.  Use
+ * pvMsgBusAllocFromISR() from an interrupt service routine.
+ *
+ * @return A buffer of at least the xMaxMessageSize the bus was created with,
+ * aligned to portBYTE_ALIGNMENT, or NULL if every buffer is in use.  Publish
+ * it with uxMsgBusPublish(), or give it back unpublished with
+ * vMsgBusRelease().
+ *
+ * \defgroup pvMsgBusAlloc pvMsgBusAlloc
+ * \ingroup MsgBus
+ */
+    void * pvMsgBusAlloc( MsgBusHandle_t xBus ) PRIVILEGED_FUNCTION;
+    void * pvMsgBusAllocFromISR( MsgBusHandle_t xBus ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * UBaseType_t uxMsgBusPublish( MsgTopicHandle_t xTopic, void * pvMessage, size_t xLength );
+ * @endcode
+ *
+ * Delivers a message to every subscriber of a topic.  Never blocks.  The
+ * caller must not use the message after this call.  Use
+ * uxMsgBusPublishFromISR() from an interrupt service routine.
+ *
+ * @param xTopic The topic.
+ *
+ * @param pvMessage A buffer from pvMsgBusAlloc() or pvMsgBusAllocFromISR() of
+ * the bus the topic belongs to.
+ *
+ * @param xLength The number of bytes of the buffer used, returned to the
+ * subscribers by xMsgBusGetLength().
+ *
+ * @return The number of subscribers the message was delivered to.  If it is
+ * 0 the buffer has already gone back to the bus.
+ *
+ * \defgroup uxMsgBusPublish uxMsgBusPublish
+ * \ingroup MsgBus
+ */
+    UBaseType_t uxMsgBusPublish( MsgTopicHandle_t xTopic,
+                                 void * pvMessage,
+                                 size_t xLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * UBaseType_t uxMsgBusPublishFromISR( MsgTopicHandle_t xTopic,
+ *                                     void * pvMessage,
+ *                                     size_t xLength,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of uxMsgBusPublish() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the message unblocked a
+ * subscriber with a priority above the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.
+ *
+ * \defgroup uxMsgBusPublishFromISR uxMsgBusPublishFromISR
+ * \ingroup MsgBus
+ */
+    UBaseType_t uxMsgBusPublishFromISR( MsgTopicHandle_t xTopic,
+                                        void * pvMessage,
+                                        size_t xLength,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * void * pvMsgBusReceive( MsgSubscriberHandle_t xSubscriber, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the oldest message of a subscription.
+ *
+ * @param xSubscriber The subscription.
+ *
+ * @param xTicksToWait The maximum time, in ticks, to wait for a message.
+ *
+ * @return The message, which stays valid until the caller releases it with
+ * vMsgBusRelease(), or NULL if xTicksToWait expired first.  Other subscribers
+ * may be reading the same buffer, so it must not be written to.
+ *
+ * \defgroup pvMsgBusReceive pvMsgBusReceive
+ * \ingroup MsgBus
+ */
+    void * pvMsgBusReceive( MsgSubscriberHandle_t xSubscriber,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * void vMsgBusRelease( void * pvMessage );
+ * @endcode
+ *
+ * Gives up a reference to a message received with pvMsgBusReceive(), or to a
+ * buffer from pvMsgBusAlloc() that was not published.  The buffer goes back
+ * to its bus when the last reference is given up.  Use
+ * vMsgBusReleaseFromISR() from an interrupt service routine.
+ *
+ * \defgroup vMsgBusRelease vMsgBusRelease
+ * \ingroup MsgBus
+ */
+    void vMsgBusRelease( void * pvMessage ) PRIVILEGED_FUNCTION;
+    void vMsgBusReleaseFromISR( void * pvMessage ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * size_t xMsgBusGetLength( const void * pvMessage );
+ * @endcode
+ *
+ * @return The xLength the message was published with.
+ *
+ * \defgroup xMsgBusGetLength xMsgBusGetLength
+ * \ingroup MsgBus
+ */
+    size_t xMsgBusGetLength( const void * pvMessage ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * uint32_t ulMsgBusGetDropCount( MsgSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * @return The number of messages dropped for a subscription because its
+ * backlog was full.
+ *
+ * \defgroup ulMsgBusGetDropCount ulMsgBusGetDropCount
+ * \ingroup MsgBus
+ */
+    uint32_t ulMsgBusGetDropCount( MsgSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * msg_bus.h
+ *
+ * @code{c}
+ * UBaseType_t uxMsgBusGetFreeMessageCount( MsgBusHandle_t xBus );
+ * @endcode
+ *
+ * @return The number of message buffers of the bus not currently in use.
+ *
+ * \defgroup uxMsgBusGetFreeMessageCount uxMsgBusGetFreeMessageCount
+ * \ingroup MsgBus
+ */
+    UBaseType_t uxMsgBusGetFreeMessageCount( MsgBusHandle_t xBus ) PRIVILEGED_FUNCTION;
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MSG_BUS_H ) */
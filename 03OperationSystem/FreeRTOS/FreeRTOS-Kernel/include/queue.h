@@ -1426,6 +1426,354 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FU
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserve(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvItem,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Reserve the slot at the back of a queue so the item can be written in place
+ * instead of being copied in by xQueueSend().  The item does not become
+ * available to receivers until xQueueCommit() is called.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * The call blocks in the same way as xQueueSend().  While a slot is reserved
+ * the queue is full to every other writer, including a second call to
+ * xQueueReserve(), because anything written behind the reserved slot would
+ * otherwise be received before it.  Keep the time between reserving and
+ * committing short.  Cannot be used on a semaphore.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param ppvItem Set to the queue storage of the reserved slot, which is
+ * uxItemSize bytes long.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vSensorTask( void *pvParameters )
+ * {
+ * SensorFrame_t *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xQueueReserve( xFrameQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vReadSensorInto( pxFrame );
+ *          xQueueCommit( xFrameQueue );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueReserve xQueueReserve
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserveFromISR( QueueHandle_t xQueue, void **ppvItem );
+ * @endcode
+ *
+ * A version of xQueueReserve() that can be called from an interrupt service
+ * routine (ISR).  It never blocks.  The slot must be committed with
+ * xQueueCommitFromISR() before the ISR exits.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueReserveFromISR xQueueReserveFromISR
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueReserveFromISR( QueueHandle_t xQueue,
+                                     void ** const ppvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommit( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Post the item written into the slot obtained from xQueueReserve().  A task
+ * blocked waiting to receive is unblocked exactly as by xQueueSend().
+ *
+ * @param xQueue The handle of the queue that holds the reserved slot.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueCommit() that can be called from an ISR.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if committing the item
+ * unblocked a task with a priority higher than the interrupted task, in which
+ * case a context switch should be requested before the ISR exits.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueCommitFromISR xQueueCommitFromISR
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeekRef(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvItem,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Receive an item from a queue by reference instead of by copy.  The item is
+ * removed from the queue, as with xQueueReceive(), but its slot is not
+ * reused until xQueueRelease() is called, so it can be read (or modified) in
+ * place until then.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * The call blocks in the same way as xQueueReceive().  Only one item per
+ * queue can be referenced at a time.  While it is, its slot stays in use, items
+ * cannot be sent to the front of the queue, and slots freed by other receives
+ * only become writable again once it has been released.  Cannot be used on a
+ * semaphore.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param ppvItem Set to the queue storage holding the item.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty.
+ *
+ * @return pdPASS if an item was referenced, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueuePeekRef xQueuePeekRef
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueuePeekRef( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeekRefFromISR( QueueHandle_t xQueue, void **ppvItem );
+ * @endcode
+ *
+ * A version of xQueuePeekRef() that can be called from an ISR.  It never
+ * blocks.
+ *
+ * @return pdPASS if an item was referenced, otherwise pdFAIL.
+ *
+ * \defgroup xQueuePeekRefFromISR xQueuePeekRefFromISR
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueuePeekRefFromISR( QueueHandle_t xQueue,
+                                     void ** const ppvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueRelease( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Return the slot of the item obtained from xQueuePeekRef() to the queue.  A
+ * task blocked waiting to send is unblocked exactly as by xQueueReceive().
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueRelease() that can be called from an ISR.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueReleaseFromISR xQueueReleaseFromISR
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+ *                                 const void *pvItems,
+ *                                 UBaseType_t uxItemCount,
+ *                                 TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Post uxItemCount items, stored back to back at pvItems, to the back of a
+ * queue.  Each time there is space the call copies as many items as fit under
+ * one critical section and wakes the waiting receivers once for the whole
+ * group, instead of once per item as a loop around xQueueSend() would.  Items
+ * from one call are queued in order, but items sent by other tasks or
+ * interrupts may be interleaved between the groups copied.
+ *
+ * configUSE_QUEUE_BATCH must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  Cannot be used on a semaphore or mutex.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the items, each the item size the queue was
+ * created with.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time, in total, the task should
+ * block waiting for space for all the items.
+ *
+ * @return The number of items posted, which is less than uxItemCount only if
+ * the queue stayed full for xTicksToWait ticks.
+ *
+ * Example usage:
+ * @code{c}
+ * void vTelemetryTask( void *pvParameters )
+ * {
+ * Sample_t xBurst[ 32 ];
+ *
+ *  for( ;; )
+ *  {
+ *      vCollectSamples( xBurst, 32 );
+ *
+ *      if( xQueueSendMultiple( xTelemetryQueue, xBurst, 32, pdMS_TO_TICKS( 10 ) ) != 32 )
+ *      {
+ *          // Some samples were dropped.
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+    UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                    const void * const pvItems,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+ *                                        const void *pvItems,
+ *                                        UBaseType_t uxItemCount,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be called from an ISR.  It posts
+ * as many of the items as there is space for and never blocks.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+    UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                           const void * const pvItems,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+ *                                    void *pvBuffer,
+ *                                    UBaseType_t uxMaxItems,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from a queue under one critical section.  The
+ * call blocks in the same way as xQueueReceive() until at least one item is
+ * available, then returns every item available up to uxMaxItems.  Tasks
+ * waiting for space are woken once for the whole group.
+ *
+ * configUSE_QUEUE_BATCH must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  Cannot be used on a semaphore or mutex.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty.
+ *
+ * @return The number of items received, 0 if the queue stayed empty for
+ * xTicksToWait ticks.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+    UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                       void * const pvBuffer,
+                                       const UBaseType_t uxMaxItems,
+                                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+ *                                           void *pvBuffer,
+ *                                           UBaseType_t uxMaxItems,
+ *                                           BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an ISR.  It
+ * never blocks.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+    UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                              void * const pvBuffer,
+                                              const UBaseType_t uxMaxItems,
+                                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_BATCH */
+
 /*
  * The functions defined above are for passing data to and from tasks.  The
  * functions below are the equivalents for passing data to and from
@@ -1450,12 +1798,15 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
 
 /*
  * For internal use only.  Use xSemaphoreCreateMutex(),
- * xSemaphoreCreateCounting() or xSemaphoreGetMutexHolder() instead of calling
- * these functions directly.
+ * xSemaphoreCreateMutexWithCeiling(), xSemaphoreCreateCounting() or
+ * xSemaphoreGetMutexHolder() instead of calling these functions directly.
  */
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                              const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -0,0 +1,268 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Reader-writer locks let any number of tasks hold a lock for reading at the
+ * same time, or one task hold it for writing.  Use one in place of a mutex
+ * where many tasks read a shared structure, such as a configuration or
+ * calibration table, and writes are rare.
+ *
+ * Writers take precedence: once a writer waits for the lock, tasks that ask
+ * for it to read wait too, until no writer holds or waits for the lock.  So
+ * a steady stream of readers cannot keep a writer out.  Waiting tasks are
+ * woken in priority order.  When the lock becomes free, the highest priority
+ * waiting writer is woken if there is one; otherwise every waiting reader is.
+ *
+ * Taking and giving a lock nobody waits for is a compare and swap on the lock
+ * state on ports that define portCOMPARE_AND_SWAP_POINTER(), and a short
+ * critical section on others.  The scheduler is only suspended when a task
+ * has to block or wake another.
+ *
+ * Reader-writer locks do not use priority inheritance, and cannot be used
+ * from interrupts.  A task must not take a lock for reading a second time, or
+ * take it for writing, while it already holds it: a waiting writer would make
+ * the second take wait for the task itself.
+ */
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include rw_lock.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRWLockCreate() returns an RWLockHandle_t variable that can then be used as
+ * a parameter to xRWLockTakeRead(), xRWLockGiveRead(), etc.
+ */
+struct RWLockDef_t;
+typedef struct RWLockDef_t * RWLockHandle_t;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * RWLockHandle_t xRWLockCreate( void );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using dynamically allocated memory.  The
+ * lock is created free.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xRWLockCreate() to be available.
+ *
+ * @return The handle of the created lock, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLocks
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxStaticRWLock );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xRWLockCreateStatic() to be available.
+ *
+ * @param pxStaticRWLock Must point to a variable of type StaticRWLock_t, which
+ * will be used to hold the lock's data structure.
+ *
+ * @return The handle of the created lock, or NULL if pxStaticRWLock was NULL.
+ *
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLocks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * const pxStaticRWLock ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * void vRWLockDelete( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Deletes a lock created with xRWLockCreate() or xRWLockCreateStatic().  The
+ * lock must be free and no task may be waiting for it.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLocks
+ */
+void vRWLockDelete( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a lock for reading.  Succeeds at once while no writer holds the lock
+ * or waits for it, however many other tasks hold it for reading.
+ *
+ * @param xRWLock The handle of the lock.
+ *
+ * @param xTicksToWait The maximum time, in ticks, to wait for the lock.  Zero
+ * returns at once.  portMAX_DELAY waits indefinitely when INCLUDE_vTaskSuspend
+ * is set to 1.
+ *
+ * @return pdPASS if the lock was taken for reading, pdFAIL if xTicksToWait
+ * expired first.  Give it back with xRWLockGiveRead().
+ *
+ * Example use:
+ * @code{c}
+ * RWLockHandle_t xCalibrationLock;
+ * Calibration_t xCalibration;
+ *
+ * int32_t lApplyGain( uint32_t ulChannel, int32_t lRaw )
+ * {
+ * int32_t lResult;
+ *
+ *  xRWLockTakeRead( xCalibrationLock, portMAX_DELAY );
+ *  lResult = ( lRaw * xCalibration.lGain[ ulChannel ] ) >> 16;
+ *  xRWLockGiveRead( xCalibrationLock );
+ *
+ *  return lResult;
+ * }
+ *
+ * void vStoreCalibration( const Calibration_t * pxNew )
+ * {
+ *  xRWLockTakeWrite( xCalibrationLock, portMAX_DELAY );
+ *  xCalibration = *pxNew;
+ *  xRWLockGiveWrite( xCalibrationLock );
+ * }
+ * @endcode
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Gives back a lock taken with xRWLockTakeRead().  The last reader to give the
+ * lock back wakes the highest priority writer waiting for it.
+ *
+ * @param xRWLock The handle of the lock.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a lock for writing.  Waits until no other task holds the lock.  While
+ * the task waits, tasks that ask for the lock to read wait as well.
+ *
+ * @param xRWLock The handle of the lock.
+ *
+ * @param xTicksToWait The maximum time, in ticks, to wait for the lock.  Zero
+ * returns at once.  portMAX_DELAY waits indefinitely when INCLUDE_vTaskSuspend
+ * is set to 1.
+ *
+ * @return pdPASS if the lock was taken for writing, pdFAIL if xTicksToWait
+ * expired first.  Give it back with xRWLockGiveWrite().
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Gives back a lock taken with xRWLockTakeWrite().  Wakes the highest priority
+ * writer waiting for the lock, or every waiting reader if no writer waits.
+ *
+ * @param xRWLock The handle of the lock.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * @param xRWLock The handle of the lock.
+ *
+ * @return The number of tasks holding the lock for reading.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLocks
+ */
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( RW_LOCK_H ) */
@@ -798,6 +798,73 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+ *                                                          StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol instead of
+ * priority inheritance.  configUSE_MUTEX_PRIORITY_CEILING must be set to 1 in
+ * FreeRTOSConfig.h for these macros to be available.
+ *
+ * A task that takes the mutex runs at uxCeilingPriority until it gives the
+ * mutex back, then returns to the priority it had before.  The ceiling must be
+ * at least the priority of the highest priority task that takes the mutex.  No
+ * task that takes the mutex can then pre-empt the holder, so a task waits for
+ * at most one critical section of a lower priority task, priority inheritance
+ * never chains, and the holder is not switched out to a task that would only
+ * block on the mutex again.
+ *
+ * Mutexes created using these macros are accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros, and as with xSemaphoreCreateMutex() must always
+ * be given back by the task that took them.  When several are held they are
+ * expected to be given back in the opposite order to which they were taken.
+ * The holder should not block while it holds the mutex, as the ceiling does
+ * not then keep other tasks from taking it, and tasks whose own priority is
+ * the ceiling can still share the CPU with the holder through time slicing.
+ *
+ * @param uxCeilingPriority The priority the holder runs at.  Must be above
+ * tskIDLE_PRIORITY and below configMAX_PRIORITIES.
+ *
+ * @param pxMutexBuffer As for xSemaphoreCreateMutexStatic().
+ *
+ * @return A handle to the created mutex, or NULL if there was not enough heap
+ * to allocate it (xSemaphoreCreateMutexWithCeiling()) or pxMutexBuffer was NULL
+ * (xSemaphoreCreateMutexWithCeilingStatic()).
+ *
+ * Example usage:
+ * @code{c}
+ * // The SPI bus is used by tasks of priorities 1 to 3.
+ * SemaphoreHandle_t xSpiBusLock;
+ *
+ * void vInitSpi( void )
+ * {
+ *  xSpiBusLock = xSemaphoreCreateMutexWithCeiling( 3 );
+ * }
+ *
+ * void vSpiTransfer( void )
+ * {
+ *  if( xSemaphoreTake( xSpiBusLock, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      // Runs at priority 3 until the mutex is given.
+ *      xSemaphoreGive( xSpiBusLock );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( ( uxCeilingPriority ) )
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
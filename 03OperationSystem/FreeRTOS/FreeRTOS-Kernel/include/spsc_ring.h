@@ -0,0 +1,362 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A single-producer/single-consumer ring passes fixed size items from one task
+ * or interrupt to one other task or interrupt without entering a critical
+ * section.  The producer only ever writes the head index and the consumer only
+ * ever writes the tail index, so the two sides never contend for the same
+ * variable and neither has to mask interrupts.  That keeps the ring off the
+ * interrupt latency path, unlike a queue or stream buffer, at the cost of
+ * supporting just one writer and one reader and of only the registered
+ * consumer task being able to block.
+ *
+ * ***NOTE***:  As with stream buffers, it is not safe to have more than one
+ * writer or more than one reader.  Unlike stream buffers, there is no way to
+ * make it safe by wrapping the calls in critical sections and setting the block
+ * time to 0 - use a queue if there are several producers.
+ *
+ * The consumer can block in xSpscRingReceive() once it has been registered with
+ * vSpscRingSetNotification().  The producer gives that task a direct to task
+ * notification only when the item it pushes is the first one in an otherwise
+ * empty ring, so a burst of items costs a single notification.
+ *
+ * spsc_ring.c uses direct to task notifications, so configUSE_TASK_NOTIFICATIONS
+ * must be set to 1 in FreeRTOSConfig.h.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_ring.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which rings are referenced.  For example, a call to xSpscRingCreate()
+ * returns an SpscRingHandle_t variable that can then be used as a parameter to
+ * xSpscRingPush(), xSpscRingPop(), etc.
+ */
+struct SpscRingDef_t;
+typedef struct SpscRingDef_t * SpscRingHandle_t;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new ring using dynamically allocated memory.  The ring structure
+ * and the storage area are allocated with a single call to pvPortMalloc().
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xSpscRingCreate() to be available.
+ *
+ * @param uxLength The maximum number of items the ring can hold at any one
+ * time.  Must be a power of two, as the free running indices are masked to
+ * find a slot.  All uxLength slots are usable.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return The handle of the created ring, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * Example use:
+ * @code{c}
+ * // 64 received bytes, filled by the USART interrupt and drained by a task.
+ * xRxRing = xSpscRingCreate( 64, sizeof( uint8_t ) );
+ * @endcode
+ * \defgroup xSpscRingCreate xSpscRingCreate
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+ *                                         UBaseType_t uxItemSize,
+ *                                         uint8_t * const pucRingStorageArea,
+ *                                         StaticSpscRing_t * const pxStaticRing );
+ * @endcode
+ *
+ * Creates a new ring using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSpscRingCreateStatic() to be available.
+ *
+ * @param uxLength The maximum number of items the ring can hold.  Must be a
+ * power of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pucRingStorageArea Must point to a uint8_t array that is at least
+ * ( uxLength * uxItemSize ) bytes big.
+ *
+ * @param pxStaticRing Must point to a variable of type StaticSpscRing_t, which
+ * will be used to hold the ring's data structure.
+ *
+ * @return The handle of the created ring, or NULL if either pucRingStorageArea
+ * or pxStaticRing is NULL.
+ *
+ * Example use:
+ * @code{c}
+ * static uint8_t ucRxStorage[ 64 ];
+ * static StaticSpscRing_t xRxRingStruct;
+ *
+ * xRxRing = xSpscRingCreateStatic( sizeof( ucRxStorage ), 1, ucRxStorage, &xRxRingStruct );
+ * @endcode
+ * \defgroup xSpscRingCreateStatic xSpscRingCreateStatic
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+                                            UBaseType_t uxItemSize,
+                                            uint8_t * const pucRingStorageArea,
+                                            StaticSpscRing_t * const pxStaticRing ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * void vSpscRingDelete( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Deletes a ring that was previously created using a call to
+ * xSpscRingCreate() or xSpscRingCreateStatic().  Neither side may be using
+ * the ring when it is deleted.
+ *
+ * @param xRing The handle of the ring to be deleted.
+ *
+ * \defgroup vSpscRingDelete vSpscRingDelete
+ * \ingroup SpscRingManagement
+ */
+void vSpscRingDelete( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * void vSpscRingSetNotification( SpscRingHandle_t xRing,
+ *                                TaskHandle_t xTaskToNotify,
+ *                                UBaseType_t uxIndexToNotify );
+ * @endcode
+ *
+ * Registers the consumer task that is notified when an item is pushed into an
+ * empty ring, allowing that task to block in xSpscRingReceive().  Pass NULL as
+ * xTaskToNotify to stop notifying.  Call it before the producer starts, or
+ * while the consumer is not blocked on the ring.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param xTaskToNotify The consumer task, or NULL.
+ *
+ * @param uxIndexToNotify The index within the task's array of notification
+ * values used to signal it.  The index must not be used for anything else, and
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * \defgroup vSpscRingSetNotification vSpscRingSetNotification
+ * \ingroup SpscRingManagement
+ */
+void vSpscRingSetNotification( SpscRingHandle_t xRing,
+                               TaskHandle_t xTaskToNotify,
+                               UBaseType_t uxIndexToNotify ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingPush( SpscRingHandle_t xRing, const void * pvItem );
+ * @endcode
+ *
+ * Copies an item into the ring from a task.  Never blocks and never enters a
+ * critical section, except for the notification given when the ring was empty.
+ * Use xSpscRingPushFromISR() to push from an interrupt service routine.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pvItem A pointer to the item to copy into the ring.
+ *
+ * @return pdPASS if the item was pushed, or errQUEUE_FULL if the ring was
+ * full.
+ *
+ * \defgroup xSpscRingPush xSpscRingPush
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+                          const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+ *                                  const void * pvItem,
+ *                                  BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xSpscRingPush() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pvItem A pointer to the item to copy into the ring.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if notifying the consumer task
+ * unblocked a task that has a priority above the currently running task, in
+ * which case a context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the item was pushed, or errQUEUE_FULL if the ring was
+ * full.
+ *
+ * Example use:
+ * @code{c}
+ * void vUSART1_IRQHandler( void )
+ * {
+ * uint8_t ucByte = USART1->DR;
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  ( void ) xSpscRingPushFromISR( xRxRing, &ucByte, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xSpscRingPushFromISR xSpscRingPushFromISR
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingPop( SpscRingHandle_t xRing, void * pvBuffer );
+ * @endcode
+ *
+ * Copies the oldest item out of the ring without blocking.  Can be called from
+ * a task or from an interrupt service routine.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @return pdPASS if an item was popped, or errQUEUE_EMPTY if the ring was
+ * empty.
+ *
+ * \defgroup xSpscRingPop xSpscRingPop
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+                         void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+ *                              void * pvBuffer,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest item out of the ring, waiting for one to arrive if the ring
+ * is empty.  Only the task registered with vSpscRingSetNotification() can use
+ * a non zero block time.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for an item.
+ *
+ * @return pdPASS if an item was received, or errQUEUE_EMPTY if the block time
+ * expired first.
+ *
+ * Example use:
+ * @code{c}
+ * void vRxTask( void * pvParameters )
+ * {
+ * uint8_t ucByte;
+ *
+ *  vSpscRingSetNotification( xRxRing, xTaskGetCurrentTaskHandle(), 0 );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xSpscRingReceive( xRxRing, &ucByte, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vProcessByte( ucByte );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSpscRingReceive xSpscRingReceive
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvBuffer,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Returns the number of items in the ring.  The value is a snapshot that either
+ * side may change as soon as it has been read.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @return The number of items in the ring.
+ *
+ * \defgroup uxSpscRingItemsWaiting uxSpscRingItemsWaiting
+ * \ingroup SpscRingManagement
+ */
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_RING_H ) */
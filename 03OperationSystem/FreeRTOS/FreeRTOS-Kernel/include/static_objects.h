@@ -0,0 +1,256 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A compile time table of the tasks, queues, semaphores and timers an
+ * application starts with.  The application lists them once, with their
+ * sizes, in X-macro tables, and staticDEFINE_OBJECTS() turns the tables into
+ * the TCBs, stacks, queue storage and object structures they need - all as
+ * static variables, so their RAM is fixed at link time - and into a function
+ * that creates every object in them with the ...CreateStatic() API.  Called
+ * before vTaskStartScheduler(), that function never calls pvPortMalloc(), so
+ * the heap is not fragmented by objects that live for the whole program and
+ * nothing at boot waits on the allocator.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h.  Each
+ * table is a function-like macro taking the name of another macro, X, and
+ * invoking X once per object:
+ *
+ *   Tasks:       X( xHandle, pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority )
+ *   Queues:      X( xHandle, uxQueueLength, uxItemSize )
+ *   Semaphores:  X( xHandle, Kind, uxParameter1, uxParameter2 ) where Kind is
+ *                one of the following.  Unused parameters are 0.
+ *                  BINARY
+ *                  COUNTING            uxParameter1 the maximum count and
+ *                                      uxParameter2 the initial count, needs
+ *                                      configUSE_COUNTING_SEMAPHORES.
+ *                  MUTEX               needs configUSE_MUTEXES.
+ *                  RECURSIVE_MUTEX     needs configUSE_RECURSIVE_MUTEXES.
+ *                  MUTEX_WITH_CEILING  uxParameter1 the ceiling priority,
+ *                                      needs configUSE_MUTEX_PRIORITY_CEILING.
+ *   Timers:      X( xHandle, pcName, xPeriod, xAutoReload, pvTimerID, pxCallback, xStart )
+ *                where xStart is pdTRUE for a timer started as soon as the
+ *                scheduler is.  Needs configUSE_TIMERS.
+ *
+ * An entry whose option is not set to 1 fails to compile with an undeclared
+ * identifier that names the option, for example
+ * staticRECURSIVE_MUTEX_needs_configUSE_RECURSIVE_MUTEXES.
+ *
+ * A table with nothing in it is a macro that expands to nothing.  Every
+ * xHandle becomes a global handle of the matching type, declared for other
+ * source files by staticDECLARE_OBJECTS().  Queues are created before
+ * semaphores, semaphores before timers and timers before tasks, in table order
+ * within each.  A timer started at creation only queues a start command until
+ * the timer task runs, so at most configTIMER_QUEUE_LENGTH timers in the table
+ * can have xStart set to pdTRUE; a start that does not fit fails configASSERT().
+ *
+ * Example:
+ * @code{c}
+ * // system_objects.h
+ * #define mainTASKS( X ) \
+ *     X( xSensorTask, vSensorTask, "sensor", 256, NULL, tskIDLE_PRIORITY + 2 ) \
+ *     X( xCommandTask, vCommandTask, "command", 384, NULL, tskIDLE_PRIORITY + 1 )
+ *
+ * #define mainQUEUES( X ) \
+ *     X( xFrameQueue, 8, sizeof( SensorFrame_t ) )
+ *
+ * #define mainSEMAPHORES( X ) \
+ *     X( xSpiBusLock, MUTEX, 0, 0 ) \
+ *     X( xDmaDone, BINARY, 0, 0 )
+ *
+ * #define mainTIMERS( X ) \
+ *     X( xWatchdogTimer, "watchdog", pdMS_TO_TICKS( 100 ), pdTRUE, NULL, prvKickWatchdog, pdTRUE )
+ *
+ * staticDECLARE_OBJECTS( mainTASKS, mainQUEUES, mainSEMAPHORES, mainTIMERS )
+ *
+ * // main.c
+ * staticDEFINE_OBJECTS( vCreateSystemObjects, mainTASKS, mainQUEUES, mainSEMAPHORES, mainTIMERS )
+ *
+ * int main( void )
+ * {
+ *     vCreateSystemObjects();
+ *     vTaskStartScheduler();
+ * }
+ * @endcode
+ */
+
+#ifndef STATIC_OBJECTS_H
+#define STATIC_OBJECTS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include static_objects.h"
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error static_objects.h creates every object with the ...CreateStatic() API and needs configSUPPORT_STATIC_ALLOCATION set to 1.
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/*
+ * Declarations of the handles of every object in the tables, for a header
+ * included wherever the objects are used.
+ */
+#define staticDECLARE_OBJECTS( TASKS, QUEUES, SEMAPHORES, TIMERS ) \
+    TASKS( staticTASK_DECLARE )                                    \
+    QUEUES( staticQUEUE_DECLARE )                                  \
+    SEMAPHORES( staticSEMAPHORE_DECLARE )                          \
+    TIMERS( staticTIMER_DECLARE )
+
+/*
+ * The storage and handles of every object in the tables, and
+ * void vCreateFunction( void ), which creates them.  Use once, in one source
+ * file.
+ */
+#define staticDEFINE_OBJECTS( vCreateFunction, TASKS, QUEUES, SEMAPHORES, TIMERS ) \
+    TASKS( staticTASK_DEFINE )                                                     \
+    QUEUES( staticQUEUE_DEFINE )                                                   \
+    SEMAPHORES( staticSEMAPHORE_DEFINE )                                           \
+    TIMERS( staticTIMER_DEFINE )                                                   \
+                                                                                   \
+    void vCreateFunction( void )                                                   \
+    {                                                                              \
+        QUEUES( staticQUEUE_CREATE )                                               \
+        SEMAPHORES( staticSEMAPHORE_CREATE )                                       \
+        TIMERS( staticTIMER_CREATE )                                               \
+        TASKS( staticTASK_CREATE )                                                 \
+    }
+
+/* The entries of the tables, expanded by the two macros above. */
+
+#define staticTASK_DECLARE( xHandle, pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority ) \
+    extern TaskHandle_t xHandle;
+
+#define staticTASK_DEFINE( xHandle, pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority ) \
+    TaskHandle_t xHandle = NULL;                                                                  \
+    static StaticTask_t xHandle##Buffer;                                                          \
+    static StackType_t xHandle##Stack[ usStackDepth ];
+
+#define staticTASK_CREATE( xHandle, pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority )                                 \
+    xHandle = xTaskCreateStatic( ( pxTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), xHandle##Stack, \
+                                 &( xHandle##Buffer ) );                                                                         \
+    configASSERT( xHandle );
+
+#define staticQUEUE_DECLARE( xHandle, uxQueueLength, uxItemSize ) \
+    extern QueueHandle_t xHandle;
+
+/* The storage is an array of size_t so the items start word aligned, as they
+ * do in a queue created with xQueueCreate().  It is at least one word long, as
+ * an array cannot be empty, but a queue of zero sized items has no storage and
+ * is created with NULL in its place. */
+#define staticQUEUE_STORAGE_WORDS( uxQueueLength, uxItemSize ) \
+    configMAX( ( ( ( ( size_t ) ( uxQueueLength ) * ( size_t ) ( uxItemSize ) ) + sizeof( size_t ) - 1U ) / sizeof( size_t ) ), 1U )
+
+#define staticQUEUE_DEFINE( xHandle, uxQueueLength, uxItemSize ) \
+    QueueHandle_t xHandle = NULL;                                 \
+    static StaticQueue_t xHandle##Buffer;                         \
+    static size_t xHandle##Storage[ staticQUEUE_STORAGE_WORDS( uxQueueLength, uxItemSize ) ];
+
+#define staticQUEUE_CREATE( xHandle, uxQueueLength, uxItemSize )                                      \
+    xHandle = xQueueCreateStatic( ( uxQueueLength ), ( uxItemSize ),                                  \
+                                  ( ( uxItemSize ) == 0U ) ? NULL : ( uint8_t * ) xHandle##Storage, \
+                                  &( xHandle##Buffer ) );                                             \
+    configASSERT( xHandle );
+
+#define staticSEMAPHORE_DECLARE( xHandle, Kind, uxParameter1, uxParameter2 ) \
+    extern SemaphoreHandle_t xHandle;
+
+#define staticSEMAPHORE_DEFINE( xHandle, Kind, uxParameter1, uxParameter2 ) \
+    SemaphoreHandle_t xHandle = NULL;                                        \
+    static StaticSemaphore_t xHandle##Buffer;
+
+#define staticSEMAPHORE_CREATE( xHandle, Kind, uxParameter1, uxParameter2 )                        \
+    xHandle = staticSEMAPHORE_CREATE_##Kind( ( uxParameter1 ), ( uxParameter2 ), &( xHandle##Buffer ) ); \
+    configASSERT( xHandle );
+
+#define staticSEMAPHORE_CREATE_BINARY( uxParameter1, uxParameter2, pxBuffer ) \
+    xSemaphoreCreateBinaryStatic( pxBuffer )
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+    #define staticSEMAPHORE_CREATE_COUNTING( uxMaxCount, uxInitialCount, pxBuffer ) \
+    xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxBuffer )
+#else
+    #define staticSEMAPHORE_CREATE_COUNTING( uxMaxCount, uxInitialCount, pxBuffer ) \
+    staticCOUNTING_needs_configUSE_COUNTING_SEMAPHORES
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+    #define staticSEMAPHORE_CREATE_MUTEX( uxParameter1, uxParameter2, pxBuffer ) \
+    xSemaphoreCreateMutexStatic( pxBuffer )
+#else
+    #define staticSEMAPHORE_CREATE_MUTEX( uxParameter1, uxParameter2, pxBuffer ) \
+    staticMUTEX_needs_configUSE_MUTEXES
+#endif
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+    #define staticSEMAPHORE_CREATE_RECURSIVE_MUTEX( uxParameter1, uxParameter2, pxBuffer ) \
+    xSemaphoreCreateRecursiveMutexStatic( pxBuffer )
+#else
+    #define staticSEMAPHORE_CREATE_RECURSIVE_MUTEX( uxParameter1, uxParameter2, pxBuffer ) \
+    staticRECURSIVE_MUTEX_needs_configUSE_RECURSIVE_MUTEXES
+#endif
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    #define staticSEMAPHORE_CREATE_MUTEX_WITH_CEILING( uxCeilingPriority, uxParameter2, pxBuffer ) \
+    xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxBuffer )
+#else
+    #define staticSEMAPHORE_CREATE_MUTEX_WITH_CEILING( uxCeilingPriority, uxParameter2, pxBuffer ) \
+    staticMUTEX_WITH_CEILING_needs_configUSE_MUTEX_PRIORITY_CEILING
+#endif
+
+#define staticTIMER_DECLARE( xHandle, pcName, xPeriod, xAutoReload, pvTimerID, pxCallback, xStart ) \
+    extern TimerHandle_t xHandle;
+
+#define staticTIMER_DEFINE( xHandle, pcName, xPeriod, xAutoReload, pvTimerID, pxCallback, xStart ) \
+    TimerHandle_t xHandle = NULL;                                                                  \
+    static StaticTimer_t xHandle##Buffer;
+
+/* A timer started here only goes on the timer command queue, so is not
+ * running until the scheduler has started the timer task.  The start fails
+ * once the table has started configTIMER_QUEUE_LENGTH timers. */
+#if ( configUSE_TIMERS == 1 )
+    #define staticTIMER_CREATE( xHandle, pcName, xPeriod, xAutoReload, pvTimerID, pxCallback, xStart )                  \
+    xHandle = xTimerCreateStatic( ( pcName ), ( xPeriod ), ( xAutoReload ), ( pvTimerID ), ( pxCallback ), &( xHandle##Buffer ) ); \
+    configASSERT( xHandle );                                                                                         \
+                                                                                                                     \
+    if( ( xStart ) != pdFALSE )                                                                                      \
+    {                                                                                                                \
+        BaseType_t xStarted = xTimerStart( xHandle, 0 );                                                             \
+                                                                                                                     \
+        configASSERT( xStarted == pdPASS );                                                                          \
+        ( void ) xStarted;                                                                                           \
+    }
+#else
+    #define staticTIMER_CREATE( xHandle, pcName, xPeriod, xAutoReload, pvTimerID, pxCallback, xStart ) \
+    xHandle = staticTIMER_needs_configUSE_TIMERS;
+#endif
+
+#endif /* STATIC_OBJECTS_H */
@@ -879,6 +879,305 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+ *                                   void **ppvData,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains a pointer to the free space inside a stream buffer's storage area so
+ * the data can be written in place - for example by a DMA engine - instead of
+ * being copied in by xStreamBufferSend().  The written bytes only become
+ * visible to the reader when xStreamBufferCommitWrite() or
+ * xStreamBufferCommitWriteFromISR() is called.
+ *
+ * The region returned is the largest one that does not wrap around the end of
+ * the storage area.  When the free space wraps, commit the first region and
+ * acquire again to obtain the remainder at the start of the buffer.
+ *
+ * Only stream buffers can be written in place, not message buffers.  As with
+ * xStreamBufferSend(), a stream buffer must only have one writer.
+ *
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferAcquireWrite() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to point to the first free byte in the storage area.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for at least one byte of space to become free.
+ *
+ * @return The number of bytes that can be written contiguously at *ppvData,
+ * which is 0 if the stream buffer remained full for xTicksToWait ticks.
+ *
+ * Example use:
+ * @code{c}
+ * void vUARTRxTask( void * pvParameters )
+ * {
+ * StreamBufferHandle_t xStreamBuffer = ( StreamBufferHandle_t ) pvParameters;
+ * void *pvRegion;
+ * size_t xLength;
+ *
+ *  for( ;; )
+ *  {
+ *      // Let the DMA engine fill the next contiguous free region.
+ *      xLength = xStreamBufferAcquireWrite( xStreamBuffer, &pvRegion, portMAX_DELAY );
+ *
+ *      if( xLength > 0 )
+ *      {
+ *          vStartUARTDMA( pvRegion, xLength );
+ *
+ *          // The DMA complete interrupt calls xStreamBufferCommitWriteFromISR()
+ *          // with the number of bytes received and notifies this task.
+ *          ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                      void ** ppvData,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                          void **ppvData );
+ * @endcode
+ *
+ * A version of xStreamBufferAcquireWrite() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to point to the first free byte in the storage area.
+ *
+ * @return The number of bytes that can be written contiguously at *ppvData.
+ *
+ * \defgroup xStreamBufferAcquireWriteFromISR xStreamBufferAcquireWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                             void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xBytesWritten );
+ * @endcode
+ *
+ * Makes xBytesWritten bytes written in place at the pointer returned by the
+ * last xStreamBufferAcquireWrite() visible to the reader, and unblocks the
+ * reader if the trigger level has been reached.  xBytesWritten must not be
+ * greater than the length that was acquired, and may be 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written.
+ *
+ * @return The number of bytes now available to be read.
+ *
+ * \defgroup xStreamBufferCommitWrite xStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                         size_t xBytesWritten,
+ *                                         BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferCommitWrite() that can be called from an
+ * interrupt service routine (ISR), typically a DMA complete or UART idle line
+ * interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the bytes
+ * unblocked a task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the ISR exits.
+ *
+ * @return The number of bytes now available to be read.
+ *
+ * Example use:
+ * @code{c}
+ * void vUARTIdleLineISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * void *pvRegion;
+ * size_t xLength;
+ *
+ *  // Publish what the DMA engine has written so far, then restart it on the
+ *  // next free region.
+ *  xStreamBufferCommitWriteFromISR( xStreamBuffer, xDMABytesReceived(), &xHigherPriorityTaskWoken );
+ *  xLength = xStreamBufferAcquireWriteFromISR( xStreamBuffer, &pvRegion );
+ *  vStartUARTDMA( pvRegion, xLength );
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferCommitWriteFromISR xStreamBufferCommitWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesWritten,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+ *                                  void **ppvData,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains a pointer to the oldest unread bytes inside a stream buffer's
+ * storage area so they can be parsed in place instead of being copied out by
+ * xStreamBufferReceive().  The bytes stay in the buffer until
+ * xStreamBufferReleaseRead() or xStreamBufferReleaseReadFromISR() is called.
+ *
+ * The region returned is the largest one that does not wrap around the end of
+ * the storage area.  When the data wraps, release the first region and
+ * acquire again to obtain the remainder at the start of the buffer.
+ *
+ * Only stream buffers can be read in place, not message buffers.  As with
+ * xStreamBufferReceive(), a stream buffer must only have one reader.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to point to the oldest unread byte.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data to become available.
+ *
+ * @return The number of bytes that can be read contiguously at *ppvData, which
+ * is 0 if no data arrived within xTicksToWait ticks.
+ *
+ * Example use:
+ * @code{c}
+ * void vParserTask( void * pvParameters )
+ * {
+ * StreamBufferHandle_t xStreamBuffer = ( StreamBufferHandle_t ) pvParameters;
+ * void *pvData;
+ * size_t xLength;
+ *
+ *  for( ;; )
+ *  {
+ *      xLength = xStreamBufferAcquireRead( xStreamBuffer, &pvData, portMAX_DELAY );
+ *
+ *      // Parse as many bytes as possible directly from the buffer, then give
+ *      // back only the ones that were consumed.
+ *      xStreamBufferReleaseRead( xStreamBuffer, xParse( pvData, xLength ) );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferAcquireRead xStreamBufferAcquireRead
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvData,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                         void **ppvData );
+ * @endcode
+ *
+ * A version of xStreamBufferAcquireRead() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to point to the oldest unread byte.
+ *
+ * @return The number of bytes that can be read contiguously at *ppvData.
+ *
+ * \defgroup xStreamBufferAcquireReadFromISR xStreamBufferAcquireReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xBytesRead );
+ * @endcode
+ *
+ * Removes xBytesRead bytes, starting at the pointer returned by the last
+ * xStreamBufferAcquireRead(), from the stream buffer and unblocks the writer
+ * if it was waiting for space.  xBytesRead must not be greater than the length
+ * that was acquired, and may be 0 to leave all the data in the buffer.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes consumed.
+ *
+ * @return The number of bytes of free space now in the stream buffer.
+ *
+ * \defgroup xStreamBufferReleaseRead xStreamBufferReleaseRead
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                         size_t xBytesRead,
+ *                                         BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferReleaseRead() that can be called from an interrupt
+ * service routine (ISR), for example when a DMA transmit of the acquired
+ * region completes.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes consumed.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the bytes
+ * unblocked a task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the ISR exits.
+ *
+ * @return The number of bytes of free space now in the stream buffer.
+ *
+ * \defgroup xStreamBufferReleaseReadFromISR xStreamBufferReleaseReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesRead,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
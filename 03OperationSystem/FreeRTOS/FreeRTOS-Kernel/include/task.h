@@ -168,6 +168,36 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetRunTimeSnapshot() function to return the run time each
+ * task has used since the previous call. */
+typedef struct xTASK_RUN_TIME_SNAPSHOT
+{
+    TaskHandle_t xHandle;                  /* The handle of the task to which the rest of the information in the structure relates. */
+    const char * pcTaskName;               /* A pointer to the task's name.  This value will be invalid if the task was deleted since the structure was populated! */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    configRUN_TIME_COUNTER_TYPE ulRunTime; /* Time the task spent in the Running state since the previous snapshot, not counting interrupts. */
+    configRUN_TIME_COUNTER_TYPE ulISRTime; /* Time spent in interrupts taken while the task was running since the previous snapshot.  Only valid when configRUN_TIME_STATS_ISR_ATTRIBUTION is defined as 1 in FreeRTOSConfig.h. */
+    uint16_t usCPUUsage;                   /* ulRunTime in hundredths of a percent of the time since the previous snapshot. */
+    uint16_t usISRUsage;                   /* ulISRTime in hundredths of a percent of the time since the previous snapshot. */
+} TaskRunTimeSnapshot_t;
+
+/* The list of tasks blocked on a kernel object, kept in task priority order.
+ * With configUSE_EVENT_LIST_INDEX set to 1 it also records which slots have a
+ * waiting task and the last waiting task of each, so a task blocks and unblocks
+ * in constant time however many tasks wait on the object.  A slot is one
+ * priority up to 32 priorities and a group of priorities above that (see
+ * tskEVENT_LIST_SLOTS), within which a blocking task walks past the waiting
+ * tasks of its group.  The index adds a word and tskEVENT_LIST_SLOTS pointers
+ * to each event list, and queues and semaphores have two.  Only the kernel
+ * accesses the members. */
+typedef struct xEVENT_LIST
+{
+    List_t xList;                                          /* The waiting tasks.  Must be the first member, see vTaskPlaceOnEventList(). */
+    #if ( configUSE_EVENT_LIST_INDEX == 1 )
+        uint32_t ulWaitingSlots;                           /* Bit n is set while a task of a priority in slot n is in xList, slot 0 holding the highest priorities. */
+        ListItem_t * pxLastOfSlot[ tskEVENT_LIST_SLOTS ];  /* The last item in xList of each slot set in ulWaitingSlots. */
+    #endif
+} EventList_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -245,6 +275,27 @@ typedef enum
  */
 #define taskENABLE_INTERRUPTS()            portENABLE_INTERRUPTS()
 
+/**
+ * task. h
+ *
+ * Macros to call at the start and end of an interrupt handler so the time
+ * spent in the handler is counted against the interrupt rather than the task
+ * it interrupted.  Only has an effect when configGENERATE_RUN_TIME_STATS and
+ * configRUN_TIME_STATS_ISR_ATTRIBUTION are both 1, and must only be used from
+ * interrupts that are allowed to call interrupt safe FreeRTOS API functions.
+ * The kernel tick interrupt already calls them.
+ *
+ * \defgroup taskRUN_TIME_ISR_ENTER taskRUN_TIME_ISR_ENTER
+ * \ingroup InterruptControl
+ */
+#if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+    #define taskRUN_TIME_ISR_ENTER()    vTaskRunTimeISREnter()
+    #define taskRUN_TIME_ISR_EXIT()     vTaskRunTimeISRExit()
+#else
+    #define taskRUN_TIME_ISR_ENTER()
+    #define taskRUN_TIME_ISR_EXIT()
+#endif
+
 /* Definitions returned by xTaskGetSchedulerState().  taskSCHEDULER_SUSPENDED is
  * 0 to generate more optimal code when configASSERT() is defined as the constant
  * is used in assert() statements. */
@@ -870,6 +921,101 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
         ( void ) xTaskDelayUntil( ( pxPreviousWakeTime ), ( xTimeIncrement ) ); \
     } while( 0 )
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetEDFParameters( TaskHandle_t xTask, TickType_t xPeriod, TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULER must be defined as 1 for this function to be
+ * available.
+ *
+ * Makes xTask a periodic earliest deadline first task.  Tasks at
+ * configEDF_TASK_PRIORITY that have EDF parameters run in the order of the
+ * absolute deadlines of their current jobs rather than round robin.  Tasks at
+ * other priorities are scheduled as before, so fixed priority tasks above
+ * configEDF_TASK_PRIORITY pre-empt every EDF task and tasks below it run when
+ * no EDF task is ready.
+ *
+ * The first job is taken to be released when this function is called.  Each
+ * call to xTaskDelayUntil() by the task then completes the current job and
+ * releases the next one at the new wake time, with a deadline
+ * xRelativeDeadline ticks after its release.  A job that completes after its
+ * deadline is counted, see uxTaskGetEDFDeadlineMisses().
+ *
+ * @param xTask The task to set the parameters of.  Passing NULL sets the
+ * parameters of the calling task.  The task should have been created at
+ * configEDF_TASK_PRIORITY.
+ *
+ * @param xPeriod The period of the task, which is the time increment it passes
+ * to xTaskDelayUntil().  xTaskDelayUntil() asserts that an EDF task passes
+ * this value.
+ *
+ * @param xRelativeDeadline The deadline of each job, in ticks after its
+ * release.  It cannot be longer than xPeriod.  Zero sets it to xPeriod.
+ *
+ * Example usage:
+ * @code{c}
+ * void vControlLoop( void * pvParameters )
+ * {
+ * TickType_t xRelease;
+ * const TickType_t xPeriod = pdMS_TO_TICKS( 10 );
+ *
+ *   vTaskSetEDFParameters( NULL, xPeriod, pdMS_TO_TICKS( 8 ) );
+ *   xRelease = xTaskGetTickCount();
+ *
+ *   for( ;; )
+ *   {
+ *       // Run one job, then wait for the release of the next.
+ *       vControlStep();
+ *       xTaskDelayUntil( &xRelease, xPeriod );
+ *   }
+ * }
+ * @endcode
+ * \defgroup vTaskSetEDFParameters vTaskSetEDFParameters
+ * \ingroup TaskCtrl
+ */
+void vTaskSetEDFParameters( TaskHandle_t xTask,
+                            TickType_t xPeriod,
+                            TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetEDFDeadline( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULER must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The task to query.  Passing NULL queries the calling task.
+ *
+ * @return The absolute deadline, in ticks, of the current job of xTask.
+ *
+ * \defgroup xTaskGetEDFDeadline xTaskGetEDFDeadline
+ * \ingroup TaskCtrl
+ */
+TickType_t xTaskGetEDFDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetEDFDeadlineMisses( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULER must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The task to query.  Passing NULL queries the calling task.
+ *
+ * @return The number of jobs of xTask that completed, by calling
+ * xTaskDelayUntil(), after their deadline.
+ *
+ * \defgroup uxTaskGetEDFDeadlineMisses uxTaskGetEDFDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetEDFDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 
 /**
  * task. h
@@ -1957,6 +2103,47 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTimeSnapshot_t * const pxSnapshotArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulElapsedTime );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Populates a TaskRunTimeSnapshot_t structure for each task in the system
+ * with the run time the task has used since the previous call, and its share
+ * of the elapsed time in hundredths of a percent.  Unlike
+ * uxTaskGetSystemState() it does not measure stack high water marks, and
+ * unlike vTaskGetRunTimeStats() it does not format any strings, so it is cheap
+ * enough to call periodically to plot CPU load.  The time of the running task
+ * is brought up to date first, so the deltas of all tasks add up to the
+ * elapsed time.
+ *
+ * The previous call is remembered by the kernel, so only one part of the
+ * application should use this function.  The first call reports the time
+ * since the run time counter started.
+ *
+ * @param pxSnapshotArray An array of TaskRunTimeSnapshot_t structures with at
+ * least uxTaskGetNumberOfTasks() entries.
+ *
+ * @param uxArraySize The size of the array pointed to by pxSnapshotArray.
+ *
+ * @param pulElapsedTime Set to the run time counter ticks that passed since
+ * the previous call.  Can be NULL.
+ *
+ * @return The number of TaskRunTimeSnapshot_t structures that were populated,
+ * or zero if the array was too small, in which case the previous snapshot is
+ * kept.
+ *
+ * \defgroup uxTaskGetRunTimeSnapshot uxTaskGetRunTimeSnapshot
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTimeSnapshot_t * const pxSnapshotArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulElapsedTime ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -2923,6 +3110,14 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Initialises the list of tasks waiting on a kernel object.
+ */
+void vTaskEventListInitialise( EventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -2941,7 +3136,8 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  *
  * The 'ordered' version uses the existing event list item value (which is the
  * owning task's priority) to insert the list item into the event list in task
- * priority order.
+ * priority order.  Its pxEventList must be the xList member of an EventList_t
+ * initialised by vTaskEventListInitialise().
  *
  * @param pxEventList The list containing tasks that are blocked waiting
  * for the event to occur.
@@ -2968,7 +3164,8 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
  *
  * This function performs nearly the same function as vTaskPlaceOnEventList().
  * The difference being that this function does not permit tasks to block
- * indefinitely, whereas vTaskPlaceOnEventList() does.
+ * indefinitely, whereas vTaskPlaceOnEventList() does.  pxEventList must be the
+ * xList member of an EventList_t.
  *
  */
 void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
@@ -3003,6 +3200,20 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE EVENT BITS MODULE.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that is called from a
+ * critical section, including from an interrupt, while the scheduler is not
+ * suspended.  Only available when configUSE_EVENT_GROUP_ISR_FAST_PATH is 1.
+ *
+ * @return pdTRUE if the unblocked task has a higher priority than the running
+ * task, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                     const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3013,6 +3224,17 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  */
 portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  USE
+ * taskRUN_TIME_ISR_ENTER() AND taskRUN_TIME_ISR_EXIT() INSTEAD.
+ *
+ * Mark the start and end of an interrupt handler for the run time stats.
+ * Nested interrupts are counted once, from the outermost entry to the
+ * outermost exit.
+ */
+void vTaskRunTimeISREnter( void ) PRIVILEGED_FUNCTION;
+void vTaskRunTimeISRExit( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
  * THE EVENT BITS MODULE.
@@ -3103,6 +3325,41 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/*
+ * For internal use only.  Undo pvTaskIncrementMutexHeldCount() when the
+ * compare and swap on a mutex fails, or after a mutex has been given back
+ * without going through xTaskPriorityDisinherit().
+ */
+    void vTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Returns pdTRUE if the calling task is running
+ * above its base priority, in which case giving a mutex has to go through
+ * xTaskPriorityDisinherit().
+ */
+    BaseType_t xTaskPriorityIsInherited( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+/*
+ * For internal use only.  Raise the calling task, which has just taken a
+ * priority ceiling mutex, to the ceiling of that mutex.  Returns the priority
+ * the task ran at before, which is handed back to
+ * xTaskPriorityRestoreFromCeiling() when the mutex is given.
+ */
+    UBaseType_t uxTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Drop the calling task from the ceiling of a mutex
+ * it is giving back.  Returns pdTRUE if a context switch is required.
+ */
+    BaseType_t xTaskPriorityRestoreFromCeiling( UBaseType_t uxCeilingPriority,
+                                                UBaseType_t uxPriorityBeforeCeiling ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A binary recorder for the kernel trace macros.  Setting
+ * configUSE_TRACE_RECORDER to 1 in FreeRTOSConfig.h makes FreeRTOS.h include
+ * this file, which defines the trace*() macros the kernel calls at every
+ * scheduling decision and kernel object operation.  Each event is written as a
+ * 12 byte record - a timestamp, the handle of the object and an event ID with
+ * a 24 bit parameter - into a ring buffer in RAM, overwriting the oldest
+ * record once the buffer is full.  Recording an event is a few loads and
+ * stores with interrupts masked, so the trace can stay on in a running system.
+ *
+ * The recorder is a single static structure that starts with a header holding
+ * recorderMAGIC, so it can be found in a RAM dump taken by a debugger at any
+ * time, for example with:
+ *
+ *     (gdb) dump binary memory trace.bin 0x20000000 0x20018000
+ *
+ * or written out by the application from pvTraceRecorderGetBuffer().
+ * Tools/trace_decode converts the dump to Chrome trace event JSON that
+ * https://ui.perfetto.dev and chrome://tracing display as a timeline of task
+ * states, interrupts and queue fill levels.
+ *
+ * Timestamps come from configTRACE_RECORDER_TIMESTAMP(), which must return a
+ * free running 32 bit counter incrementing configTRACE_RECORDER_TIMESTAMP_HZ
+ * times a second - the DWT cycle counter on a Cortex-M3.  The decoder handles
+ * the counter wrapping as long as consecutive events are less than one wrap
+ * apart.
+ *
+ * Layout of the buffer, all fields little endian 32 bit words unless stated:
+ *
+ *     header   magic, version, timestamp frequency, event capacity, symbol
+ *              capacity, symbol name length, events written (total, not
+ *              modulo the capacity), symbols written, recording flag.
+ *     symbols  symbol capacity entries of { object, first event, name[ name
+ *              length ] }, where first event is the events written count
+ *              when the name was given.  An address can have several
+ *              entries, as a new object may reuse the memory of a deleted
+ *              one, and each name applies from its first event on.
+ *     events   event capacity entries of { timestamp, object,
+ *              ( parameter << 8 ) | event ID }, the oldest at index
+ *              ( events written % event capacity ) once the buffer has
+ *              wrapped.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include trace_recorder.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The number of events the ring buffer holds.  Must be a power of two. */
+#ifndef configTRACE_RECORDER_EVENTS
+    #define configTRACE_RECORDER_EVENTS    1024
+#endif
+
+/* The number of task, queue and other object names that can be recorded. */
+#ifndef configTRACE_RECORDER_SYMBOLS
+    #define configTRACE_RECORDER_SYMBOLS    32
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP
+    #error configTRACE_RECORDER_TIMESTAMP() must be defined in FreeRTOSConfig.h to return a free running 32 bit counter when configUSE_TRACE_RECORDER is 1.
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP_HZ
+    #error configTRACE_RECORDER_TIMESTAMP_HZ must be defined in FreeRTOSConfig.h to the frequency of configTRACE_RECORDER_TIMESTAMP() when configUSE_TRACE_RECORDER is 1.
+#endif
+
+#define recorderMAGIC          0x52545246UL /* "FRTR" as little endian bytes. */
+#define recorderVERSION        1UL
+#define recorderNAME_LENGTH    16
+
+/* The ISR number vTraceRecorderISREnter() is called with by the tick
+ * interrupt, SysTick_IRQn in CMSIS. */
+#define recorderTICK_ISR       ( ( uint32_t ) -1 )
+
+/* Event IDs.  The values are part of the dump format, so are never reused. */
+#define recorderEVENT_TASK_CREATE                          0x01U /* Parameter is the priority. */
+#define recorderEVENT_TASK_DELETE                          0x02U
+#define recorderEVENT_TASK_SWITCHED_IN                     0x03U /* Parameter is the priority. */
+#define recorderEVENT_TASK_READY                           0x04U /* Parameter is the priority. */
+#define recorderEVENT_TASK_DELAY                           0x05U /* Parameter is the number of ticks. */
+#define recorderEVENT_TASK_DELAY_UNTIL                     0x06U /* Parameter is the wake time. */
+#define recorderEVENT_TASK_SUSPEND                         0x07U
+#define recorderEVENT_TASK_RESUME                          0x08U
+#define recorderEVENT_TASK_RESUME_FROM_ISR                 0x09U
+#define recorderEVENT_TASK_PRIORITY_SET                    0x0AU /* Parameter is the new priority. */
+#define recorderEVENT_TASK_PRIORITY_INHERIT                0x0BU /* Parameter is the inherited priority. */
+#define recorderEVENT_TASK_PRIORITY_DISINHERIT             0x0CU /* Parameter is the restored priority. */
+#define recorderEVENT_TASK_NOTIFY                          0x0DU /* Object is the notified task, parameter the index. */
+#define recorderEVENT_TASK_NOTIFY_FROM_ISR                 0x0EU
+#define recorderEVENT_TASK_NOTIFY_GIVE_FROM_ISR            0x0FU
+#define recorderEVENT_TASK_NOTIFY_TAKE_BLOCK               0x10U /* Object is the blocking task, parameter the index. */
+#define recorderEVENT_TASK_NOTIFY_WAIT_BLOCK               0x11U
+
+#define recorderEVENT_QUEUE_CREATE                         0x20U /* Parameter is the queueQUEUE_TYPE_* value. */
+#define recorderEVENT_QUEUE_DELETE                         0x21U
+#define recorderEVENT_QUEUE_SEND                           0x22U /* Parameter of the queue events is the number of items before the call. */
+#define recorderEVENT_QUEUE_SEND_FAILED                    0x23U
+#define recorderEVENT_QUEUE_SEND_FROM_ISR                  0x24U
+#define recorderEVENT_QUEUE_SEND_FROM_ISR_FAILED           0x25U
+#define recorderEVENT_QUEUE_RECEIVE                        0x26U
+#define recorderEVENT_QUEUE_RECEIVE_FAILED                 0x27U
+#define recorderEVENT_QUEUE_RECEIVE_FROM_ISR               0x28U
+#define recorderEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED        0x29U
+#define recorderEVENT_QUEUE_PEEK                           0x2AU
+#define recorderEVENT_BLOCKING_ON_QUEUE_SEND               0x2BU
+#define recorderEVENT_BLOCKING_ON_QUEUE_RECEIVE            0x2CU
+#define recorderEVENT_BLOCKING_ON_QUEUE_PEEK               0x2DU
+#define recorderEVENT_QUEUE_SEND_MULTIPLE                  0x2EU /* Parameter is the number of items sent by the batch. */
+#define recorderEVENT_QUEUE_RECEIVE_MULTIPLE               0x2FU /* Parameter is the number of items received by the batch. */
+
+#define recorderEVENT_EVENT_GROUP_CREATE                   0x30U
+#define recorderEVENT_EVENT_GROUP_DELETE                   0x31U
+#define recorderEVENT_EVENT_GROUP_SET_BITS                 0x32U /* Parameter of the event group events is the bits. */
+#define recorderEVENT_EVENT_GROUP_SET_BITS_FROM_ISR        0x33U
+#define recorderEVENT_EVENT_GROUP_CLEAR_BITS               0x34U
+#define recorderEVENT_EVENT_GROUP_WAIT_BITS_BLOCK          0x35U
+#define recorderEVENT_EVENT_GROUP_SYNC_BLOCK               0x36U
+
+#define recorderEVENT_MUTEX_TAKE                           0x38U /* A mutex on the lock word of configUSE_MUTEX_FAST_PATH. */
+#define recorderEVENT_MUTEX_GIVE                           0x39U
+
+#define recorderEVENT_STREAM_BUFFER_CREATE                 0x40U /* Parameter is pdTRUE for a message buffer. */
+#define recorderEVENT_STREAM_BUFFER_DELETE                 0x41U
+#define recorderEVENT_STREAM_BUFFER_SEND                   0x42U /* Parameter is the number of bytes. */
+#define recorderEVENT_STREAM_BUFFER_SEND_FROM_ISR          0x43U
+#define recorderEVENT_STREAM_BUFFER_RECEIVE                0x44U
+#define recorderEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR       0x45U
+#define recorderEVENT_BLOCKING_ON_STREAM_BUFFER_SEND       0x46U
+#define recorderEVENT_BLOCKING_ON_STREAM_BUFFER_RECEIVE    0x47U
+
+#define recorderEVENT_MEM_POOL_CREATE                      0x50U
+#define recorderEVENT_MEM_POOL_ALLOC                       0x51U /* Parameter is the number of free blocks after the call. */
+#define recorderEVENT_MEM_POOL_ALLOC_FAILED                0x52U
+#define recorderEVENT_MEM_POOL_FREE                        0x53U
+
+#define recorderEVENT_TIMER_CREATE                         0x58U
+#define recorderEVENT_TIMER_EXPIRED                        0x59U
+
+#define recorderEVENT_ISR_ENTER                            0x60U /* Object is the ISR number. */
+#define recorderEVENT_ISR_EXIT                             0x61U
+
+#define recorderEVENT_USER                                 0x70U /* Object is the channel, parameter the value. */
+
+/*
+ * The parameter is truncated to 24 bits.  Objects are recorded as the low 32
+ * bits of their address.
+ */
+void vTraceRecorderEvent( uint32_t ulEventID,
+                          const void * pvObject,
+                          uint32_t ulParameter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record the name of a task, queue, timer or any other object the application
+ * wants to see by name in the decoded trace.  Names are kept in a table
+ * separate from the event ring, so they are not lost when the ring wraps.
+ * The name applies to the events recorded from then on, so an object created
+ * in the memory of a deleted one can have a different name.  Tasks, timers
+ * and registered queues are named automatically.
+ */
+void vTraceRecorderSetName( const void * pvObject,
+                            const char * pcName ) PRIVILEGED_FUNCTION;
+
+/*
+ * Bracket an interrupt handler to see it on the timeline.  ulISRNumber is
+ * any number that identifies the interrupt, normally its IRQn_Type value, and
+ * can be given a name with vTraceRecorderSetISRName().  The kernel's tick
+ * interrupt is recorded as recorderTICK_ISR.
+ */
+void vTraceRecorderISREnter( uint32_t ulISRNumber ) PRIVILEGED_FUNCTION;
+void vTraceRecorderISRExit( uint32_t ulISRNumber ) PRIVILEGED_FUNCTION;
+void vTraceRecorderSetISRName( uint32_t ulISRNumber,
+                               const char * pcName ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record an application defined value, shown by the decoder as a counter
+ * track named after pvChannel (see vTraceRecorderSetName()).
+ */
+#define vTraceRecorderUserEvent( pvChannel, ulValue )    vTraceRecorderEvent( recorderEVENT_USER, ( pvChannel ), ( ulValue ) )
+
+/*
+ * Recording is on from reset, so objects created early in main() are seen.
+ * vTraceRecorderStart() must be called once the clocks are configured to store
+ * the timestamp frequency in the buffer, and resumes recording after
+ * vTraceRecorderStop().  vTraceRecorderStop() freezes the buffer, for example
+ * in the assert handler so the events that led to the assert survive.
+ */
+void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the start of the recorder buffer and sets *pxBufferSize to its size
+ * in bytes, so the application can write it to a file or a serial port.
+ * Stop the recorder first to get a consistent snapshot.
+ */
+const void * pvTraceRecorderGetBuffer( size_t * pxBufferSize ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+* Kernel trace macros
+*----------------------------------------------------------*/
+
+/* Cast handles and counts to what vTraceRecorderEvent() takes. */
+#define recorderRECORD( ulEventID, pvObject, xParameter ) \
+    vTraceRecorderEvent( ( ulEventID ), ( const void * ) ( pvObject ), ( uint32_t ) ( xParameter ) )
+
+#define traceISR_ENTER()                vTraceRecorderISREnter( recorderTICK_ISR )
+#define traceISR_EXIT()                 vTraceRecorderISRExit( recorderTICK_ISR )
+#define traceISR_EXIT_TO_SCHEDULER()    vTraceRecorderISRExit( recorderTICK_ISR )
+
+/* The task macros are expanded inside tasks.c, where pxCurrentTCB and the
+ * TCB_t members are visible. */
+#define traceTASK_CREATE( pxNewTCB )                                                               \
+    do {                                                                                           \
+        vTraceRecorderSetName( ( pxNewTCB ), &( ( pxNewTCB )->pcTaskName[ 0 ] ) );                 \
+        recorderRECORD( recorderEVENT_TASK_CREATE, ( pxNewTCB ), ( pxNewTCB )->uxPriority );       \
+    } while( 0 )
+#define traceTASK_DELETE( pxTCB )                                        recorderRECORD( recorderEVENT_TASK_DELETE, ( pxTCB ), 0 )
+#define traceTASK_SWITCHED_IN()                                          recorderRECORD( recorderEVENT_TASK_SWITCHED_IN, pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )                          recorderRECORD( recorderEVENT_TASK_READY, ( pxTCB ), ( pxTCB )->uxPriority )
+#define traceTASK_DELAY()                                                recorderRECORD( recorderEVENT_TASK_DELAY, pxCurrentTCB, xTicksToDelay )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )                             recorderRECORD( recorderEVENT_TASK_DELAY_UNTIL, pxCurrentTCB, ( xTimeToWake ) )
+#define traceTASK_SUSPEND( pxTCB )                                       recorderRECORD( recorderEVENT_TASK_SUSPEND, ( pxTCB ), 0 )
+#define traceTASK_RESUME( pxTCB )                                        recorderRECORD( recorderEVENT_TASK_RESUME, ( pxTCB ), 0 )
+#define traceTASK_RESUME_FROM_ISR( pxTCB )                               recorderRECORD( recorderEVENT_TASK_RESUME_FROM_ISR, ( pxTCB ), 0 )
+#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )                  recorderRECORD( recorderEVENT_TASK_PRIORITY_SET, ( pxTask ), ( uxNewPriority ) )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxPriority )     recorderRECORD( recorderEVENT_TASK_PRIORITY_INHERIT, ( pxTCBOfMutexHolder ), ( uxPriority ) )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxPriority )  recorderRECORD( recorderEVENT_TASK_PRIORITY_DISINHERIT, ( pxTCBOfMutexHolder ), ( uxPriority ) )
+#define traceTASK_NOTIFY( uxIndexToNotify )                              recorderRECORD( recorderEVENT_TASK_NOTIFY, pxTCB, ( uxIndexToNotify ) )
+#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )                     recorderRECORD( recorderEVENT_TASK_NOTIFY_FROM_ISR, pxTCB, ( uxIndexToNotify ) )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )                recorderRECORD( recorderEVENT_TASK_NOTIFY_GIVE_FROM_ISR, pxTCB, ( uxIndexToNotify ) )
+#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )                     recorderRECORD( recorderEVENT_TASK_NOTIFY_TAKE_BLOCK, pxCurrentTCB, ( uxIndexToWait ) )
+#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )                     recorderRECORD( recorderEVENT_TASK_NOTIFY_WAIT_BLOCK, pxCurrentTCB, ( uxIndexToWait ) )
+
+/* The queue macros are expanded inside queue.c, where the Queue_t members are
+ * visible.  Semaphores and mutexes are queues, so are recorded by the same
+ * events.  The decoder plots the number of items from the parameter, so
+ * queue.c records a send or receive of one item before it changes
+ * uxMessagesWaiting.  A batch is one event with the number of items moved,
+ * which the decoder adds to or takes from the last count.  A mutex on the
+ * fast path lock word has its own take and give events, as its
+ * uxMessagesWaiting stays 0. */
+#define traceQUEUE_CREATE( pxNewQueue )                           recorderRECORD( recorderEVENT_QUEUE_CREATE, ( pxNewQueue ), ucQueueType )
+#define traceQUEUE_DELETE( pxQueue )                              recorderRECORD( recorderEVENT_QUEUE_DELETE, ( pxQueue ), 0 )
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )            vTraceRecorderSetName( ( xQueue ), ( pcQueueName ) )
+#define traceQUEUE_SEND( pxQueue )                                recorderRECORD( recorderEVENT_QUEUE_SEND, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )                         recorderRECORD( recorderEVENT_QUEUE_SEND_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )                       recorderRECORD( recorderEVENT_QUEUE_SEND_FROM_ISR, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )                recorderRECORD( recorderEVENT_QUEUE_SEND_FROM_ISR_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )                             recorderRECORD( recorderEVENT_QUEUE_RECEIVE, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )                      recorderRECORD( recorderEVENT_QUEUE_RECEIVE_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )                    recorderRECORD( recorderEVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )             recorderRECORD( recorderEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_PEEK( pxQueue )                                recorderRECORD( recorderEVENT_QUEUE_PEEK, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )                    recorderRECORD( recorderEVENT_BLOCKING_ON_QUEUE_SEND, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )                 recorderRECORD( recorderEVENT_BLOCKING_ON_QUEUE_RECEIVE, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )                    recorderRECORD( recorderEVENT_BLOCKING_ON_QUEUE_PEEK, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_MULTIPLE( pxQueue, uxCount )              recorderRECORD( recorderEVENT_QUEUE_SEND_MULTIPLE, ( pxQueue ), ( uxCount ) )
+#define traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxCount )     recorderRECORD( recorderEVENT_QUEUE_SEND_MULTIPLE, ( pxQueue ), ( uxCount ) )
+#define traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxCount )           recorderRECORD( recorderEVENT_QUEUE_RECEIVE_MULTIPLE, ( pxQueue ), ( uxCount ) )
+#define traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxCount )  recorderRECORD( recorderEVENT_QUEUE_RECEIVE_MULTIPLE, ( pxQueue ), ( uxCount ) )
+#define traceTAKE_MUTEX( pxMutex )                                recorderRECORD( recorderEVENT_MUTEX_TAKE, ( pxMutex ), 0 )
+#define traceGIVE_MUTEX( pxMutex )                                recorderRECORD( recorderEVENT_MUTEX_GIVE, ( pxMutex ), 0 )
+
+#define traceEVENT_GROUP_CREATE( xEventGroup )                                    recorderRECORD( recorderEVENT_EVENT_GROUP_CREATE, ( xEventGroup ), 0 )
+#define traceEVENT_GROUP_DELETE( xEventGroup )                                    recorderRECORD( recorderEVENT_EVENT_GROUP_DELETE, ( xEventGroup ), 0 )
+#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )                     recorderRECORD( recorderEVENT_EVENT_GROUP_SET_BITS, ( xEventGroup ), ( uxBitsToSet ) )
+#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )            recorderRECORD( recorderEVENT_EVENT_GROUP_SET_BITS_FROM_ISR, ( xEventGroup ), ( uxBitsToSet ) )
+#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )                 recorderRECORD( recorderEVENT_EVENT_GROUP_CLEAR_BITS, ( xEventGroup ), ( uxBitsToClear ) )
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )          recorderRECORD( recorderEVENT_EVENT_GROUP_WAIT_BITS_BLOCK, ( xEventGroup ), ( uxBitsToWaitFor ) )
+#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )  recorderRECORD( recorderEVENT_EVENT_GROUP_SYNC_BLOCK, ( xEventGroup ), ( uxBitsToWaitFor ) )
+
+#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer )         recorderRECORD( recorderEVENT_STREAM_BUFFER_CREATE, ( pxStreamBuffer ), ( xIsMessageBuffer ) )
+#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )                            recorderRECORD( recorderEVENT_STREAM_BUFFER_DELETE, ( xStreamBuffer ), 0 )
+#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )                  recorderRECORD( recorderEVENT_STREAM_BUFFER_SEND, ( xStreamBuffer ), ( xBytesSent ) )
+#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )         recorderRECORD( recorderEVENT_STREAM_BUFFER_SEND_FROM_ISR, ( xStreamBuffer ), ( xBytesSent ) )
+#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )          recorderRECORD( recorderEVENT_STREAM_BUFFER_RECEIVE, ( xStreamBuffer ), ( xReceivedLength ) )
+#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength ) recorderRECORD( recorderEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR, ( xStreamBuffer ), ( xReceivedLength ) )
+#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )                  recorderRECORD( recorderEVENT_BLOCKING_ON_STREAM_BUFFER_SEND, ( xStreamBuffer ), 0 )
+#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )               recorderRECORD( recorderEVENT_BLOCKING_ON_STREAM_BUFFER_RECEIVE, ( xStreamBuffer ), 0 )
+
+#define traceMEM_POOL_CREATE( pxMemPool )              recorderRECORD( recorderEVENT_MEM_POOL_CREATE, ( pxMemPool ), ( pxMemPool )->uxBlockCount )
+#define traceMEM_POOL_ALLOC( pxMemPool, pvBlock )      recorderRECORD( recorderEVENT_MEM_POOL_ALLOC, ( pxMemPool ), ( pxMemPool )->uxFreeBlocks )
+#define traceMEM_POOL_ALLOC_FAILED( pxMemPool )        recorderRECORD( recorderEVENT_MEM_POOL_ALLOC_FAILED, ( pxMemPool ), 0 )
+#define traceMEM_POOL_FREE( pxMemPool, pvBlock )       recorderRECORD( recorderEVENT_MEM_POOL_FREE, ( pxMemPool ), ( pxMemPool )->uxFreeBlocks )
+
+#define traceTIMER_CREATE( pxNewTimer )                                                                      \
+    do {                                                                                                     \
+        if( ( pxNewTimer )->pcTimerName != NULL )                                                            \
+        {                                                                                                    \
+            vTraceRecorderSetName( ( pxNewTimer ), ( pxNewTimer )->pcTimerName );                            \
+        }                                                                                                    \
+        recorderRECORD( recorderEVENT_TIMER_CREATE, ( pxNewTimer ), ( pxNewTimer )->xTimerPeriodInTicks );   \
+    } while( 0 )
+#define traceTIMER_EXPIRED( pxTimer )    recorderRECORD( recorderEVENT_TIMER_EXPIRED, ( pxTimer ), 0 )
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* TRACE_RECORDER_H */
@@ -0,0 +1,454 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A waiter lets one task block until any of a set of queues, semaphores,
+ * stream buffers and event groups - its sources - has something for it, in the
+ * way epoll() does for file descriptors.  Each source is added to the waiter
+ * with a mask of ready bits of the task's choosing.  When a source becomes
+ * ready its bits are ORed into the waiter, and the first of them since the
+ * task last looked wakes it; xWaitAny() returns every bit set since then in
+ * one go.
+ *
+ * A source is ready when:
+ *  - a queue has an item written to it, or a semaphore or mutex is given;
+ *  - a stream or message buffer reaches its trigger level;
+ *  - one of the bits an event group was added for is set.
+ *
+ * Becoming ready costs the writer an OR and, at most once per xWaitAny(), a
+ * task notification, however many sources are added.  Unlike a queue set
+ * nothing is posted to a second queue, the sources can be written to from
+ * anywhere without having to be read through the waiter, and no queue has to
+ * be sized to hold every item of every source.
+ *
+ * Readiness is edge triggered.  The bits returned by xWaitAny() are cleared,
+ * so the task should read each returned source until it is empty before
+ * waiting again - a source that is still not empty does not set its bits a
+ * second time.  A source that is already not empty when it is added is ready
+ * straight away.  A bit may also be returned for a source that another task
+ * has since emptied, so sources are read without blocking.
+ *
+ * The waiting task is woken with a task notification, as tasks waiting on a
+ * stream buffer are, so it must not wait for direct to task notifications
+ * while it uses the waiter.  Only one task may wait on a waiter at a time.
+ * configUSE_WAITERS must be set to 1 in FreeRTOSConfig.h for waiters to be
+ * available.
+ */
+
+#ifndef WAITER_H
+#define WAITER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include waiter.h"
+#endif
+
+#include "queue.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which waiters are referenced.  For example, a call to
+ * xWaiterCreate() returns a WaiterHandle_t variable that can then be used as a
+ * parameter to xWaiterAddQueue(), xWaitAny(), etc.
+ */
+struct WaiterDef_t;
+typedef struct WaiterDef_t * WaiterHandle_t;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * WaiterHandle_t xWaiterCreate( void );
+ * @endcode
+ *
+ * Creates a new waiter, with no sources, using dynamically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xWaiterCreate() to be available.
+ *
+ * @return The handle of the created waiter, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * \defgroup xWaiterCreate xWaiterCreate
+ * \ingroup Waiters
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WaiterHandle_t xWaiterCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * WaiterHandle_t xWaiterCreateStatic( StaticWaiter_t * pxStaticWaiter );
+ * @endcode
+ *
+ * Creates a new waiter, with no sources, using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xWaiterCreateStatic() to be available.
+ *
+ * @param pxStaticWaiter Must point to a variable of type StaticWaiter_t, which
+ * will be used to hold the waiter's data structure.
+ *
+ * @return The handle of the created waiter, or NULL if pxStaticWaiter was
+ * NULL.
+ *
+ * \defgroup xWaiterCreateStatic xWaiterCreateStatic
+ * \ingroup Waiters
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    WaiterHandle_t xWaiterCreateStatic( StaticWaiter_t * const pxStaticWaiter ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * void vWaiterDelete( WaiterHandle_t xWaiter );
+ * @endcode
+ *
+ * Deletes a waiter created with xWaiterCreate() or xWaiterCreateStatic().
+ * Every source must have been removed from it first, and no task may be
+ * waiting on it.
+ *
+ * \defgroup vWaiterDelete vWaiterDelete
+ * \ingroup Waiters
+ */
+void vWaiterDelete( WaiterHandle_t xWaiter ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaiterAddQueue( WaiterHandle_t xWaiter,
+ *                             QueueHandle_t xQueueOrSemaphore,
+ *                             uint32_t ulReadyBits );
+ * @endcode
+ *
+ * Adds a queue, semaphore or mutex to a waiter.  It can also be in a queue
+ * set.
+ *
+ * @param xWaiter The handle of the waiter.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore.  A source can
+ * be added to one waiter at a time.
+ *
+ * @param ulReadyBits The bits xWaitAny() returns once the source is ready.  Not
+ * 0.  Sources may share bits, in which case the task has to try each of them.
+ *
+ * @return pdPASS if the source was added, pdFAIL if it was already added to a
+ * waiter.
+ *
+ * Example use:
+ * @code{c}
+ * #define mainUART_READY       ( 1UL << 0 )
+ * #define mainCOMMAND_READY    ( 1UL << 1 )
+ * #define mainFAULT_READY      ( 1UL << 2 )
+ *
+ * #define mainFAULT_BITS       ( ( EventBits_t ) 0x0f )
+ *
+ * void vCommsTask( void * pvParameters )
+ * {
+ * WaiterHandle_t xWaiter = xWaiterCreate();
+ * uint32_t ulReady;
+ * Command_t xCommand;
+ * uint8_t ucBytes[ 32 ];
+ * size_t xReceived;
+ *
+ *  xWaiterAddStreamBuffer( xWaiter, xUartRxStream, mainUART_READY );
+ *  xWaiterAddQueue( xWaiter, xCommandQueue, mainCOMMAND_READY );
+ *  xWaiterAddEventGroup( xWaiter, xFaultEvents, mainFAULT_BITS, mainFAULT_READY );
+ *
+ *  for( ;; )
+ *  {
+ *      xWaitAny( xWaiter, &ulReady, portMAX_DELAY );
+ *
+ *      if( ( ulReady & mainUART_READY ) != 0 )
+ *      {
+ *          while( ( xReceived = xStreamBufferReceive( xUartRxStream, ucBytes, sizeof( ucBytes ), 0 ) ) > 0 )
+ *          {
+ *              vParse( ucBytes, xReceived );
+ *          }
+ *      }
+ *
+ *      if( ( ulReady & mainCOMMAND_READY ) != 0 )
+ *      {
+ *          while( xQueueReceive( xCommandQueue, &xCommand, 0 ) == pdPASS )
+ *          {
+ *              vExecute( &xCommand );
+ *          }
+ *      }
+ *
+ *      if( ( ulReady & mainFAULT_READY ) != 0 )
+ *      {
+ *          vHandleFaults( xEventGroupClearBits( xFaultEvents, mainFAULT_BITS ) );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xWaiterAddQueue xWaiterAddQueue
+ * \ingroup Waiters
+ */
+BaseType_t xWaiterAddQueue( WaiterHandle_t xWaiter,
+                            QueueHandle_t xQueueOrSemaphore,
+                            uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaiterRemoveQueue( WaiterHandle_t xWaiter,
+ *                                QueueHandle_t xQueueOrSemaphore );
+ * @endcode
+ *
+ * Removes a queue, semaphore or mutex from a waiter.  Sources must be removed
+ * before either they or the waiter are deleted.
+ *
+ * @return pdPASS if the source was removed, pdFAIL if it had not been added to
+ * xWaiter.
+ *
+ * \defgroup xWaiterRemoveQueue xWaiterRemoveQueue
+ * \ingroup Waiters
+ */
+BaseType_t xWaiterRemoveQueue( WaiterHandle_t xWaiter,
+                               QueueHandle_t xQueueOrSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaiterAddStreamBuffer( WaiterHandle_t xWaiter,
+ *                                    StreamBufferHandle_t xStreamBuffer,
+ *                                    uint32_t ulReadyBits );
+ * @endcode
+ *
+ * Adds a stream buffer or message buffer to a waiter.  It becomes ready when
+ * it holds at least its trigger level of bytes after a write.
+ *
+ * @return pdPASS if the source was added, pdFAIL if it was already added to a
+ * waiter.
+ *
+ * \defgroup xWaiterAddStreamBuffer xWaiterAddStreamBuffer
+ * \ingroup Waiters
+ */
+BaseType_t xWaiterAddStreamBuffer( WaiterHandle_t xWaiter,
+                                   StreamBufferHandle_t xStreamBuffer,
+                                   uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaiterRemoveStreamBuffer( WaiterHandle_t xWaiter,
+ *                                       StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Removes a stream buffer or message buffer from a waiter.
+ *
+ * @return pdPASS if the source was removed, pdFAIL if it had not been added to
+ * xWaiter.
+ *
+ * \defgroup xWaiterRemoveStreamBuffer xWaiterRemoveStreamBuffer
+ * \ingroup Waiters
+ */
+BaseType_t xWaiterRemoveStreamBuffer( WaiterHandle_t xWaiter,
+                                      StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaiterAddEventGroup( WaiterHandle_t xWaiter,
+ *                                  EventGroupHandle_t xEventGroup,
+ *                                  EventBits_t uxBitsToWaitFor,
+ *                                  uint32_t ulReadyBits );
+ * @endcode
+ *
+ * Adds an event group to a waiter.  It becomes ready whenever any of
+ * uxBitsToWaitFor is set.  The waiter does not clear event bits.
+ *
+ * @return pdPASS if the source was added, pdFAIL if it was already added to a
+ * waiter.
+ *
+ * \defgroup xWaiterAddEventGroup xWaiterAddEventGroup
+ * \ingroup Waiters
+ */
+BaseType_t xWaiterAddEventGroup( WaiterHandle_t xWaiter,
+                                 EventGroupHandle_t xEventGroup,
+                                 EventBits_t uxBitsToWaitFor,
+                                 uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaiterRemoveEventGroup( WaiterHandle_t xWaiter,
+ *                                     EventGroupHandle_t xEventGroup );
+ * @endcode
+ *
+ * Removes an event group from a waiter.
+ *
+ * @return pdPASS if the source was removed, pdFAIL if it had not been added to
+ * xWaiter.
+ *
+ * \defgroup xWaiterRemoveEventGroup xWaiterRemoveEventGroup
+ * \ingroup Waiters
+ */
+BaseType_t xWaiterRemoveEventGroup( WaiterHandle_t xWaiter,
+                                    EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * void vWaiterSignal( WaiterHandle_t xWaiter, uint32_t ulReadyBits );
+ * @endcode
+ *
+ * Sets ready bits in a waiter as if a source had become ready, and wakes the
+ * task waiting on it.  Lets the waiting task be woken for things that are not
+ * kernel objects, for example work handed to it through a list of its own.
+ * vWaiterSignalFromISR() is the version that can be called from an interrupt.
+ *
+ * @param xWaiter The handle of the waiter.
+ *
+ * @param ulReadyBits The bits to set.  Not 0.
+ *
+ * \defgroup vWaiterSignal vWaiterSignal
+ * \ingroup Waiters
+ */
+void vWaiterSignal( WaiterHandle_t xWaiter,
+                    uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * void vWaiterSignalFromISR( WaiterHandle_t xWaiter,
+ *                            uint32_t ulReadyBits,
+ *                            BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vWaiterSignal() that can be called from an interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the waiting task was
+ * woken and has a priority above the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.
+ *
+ * \defgroup vWaiterSignalFromISR vWaiterSignalFromISR
+ * \ingroup Waiters
+ */
+void vWaiterSignalFromISR( WaiterHandle_t xWaiter,
+                           uint32_t ulReadyBits,
+                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * waiter.h
+ *
+ * @code{c}
+ * BaseType_t xWaitAny( WaiterHandle_t xWaiter,
+ *                      uint32_t * pulReadyBits,
+ *                      TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Waits for any source of a waiter to become ready, and returns the ready
+ * bits of every source that has become ready since the last call.  The bits
+ * are cleared in the waiter.
+ *
+ * @param xWaiter The handle of the waiter.
+ *
+ * @param pulReadyBits Set to the ready bits, or to 0 if xTicksToWait expired
+ * first.
+ *
+ * @param xTicksToWait The maximum time, in ticks, to wait.  Zero returns at
+ * once.  portMAX_DELAY waits indefinitely when INCLUDE_vTaskSuspend is set
+ * to 1.
+ *
+ * @return pdPASS if any source was ready, pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xWaitAny xWaitAny
+ * \ingroup Waiters
+ */
+BaseType_t xWaitAny( WaiterHandle_t xWaiter,
+                     uint32_t * const pulReadyBits,
+                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FUNCTIONS BELOW ARE FOR USE BY THE KERNEL ONLY, AND MUST NOT BE CALLED
+ * FROM APPLICATION CODE.
+ *
+ * vWaiterNotify() and vWaiterNotifyFromISR() are called by a source that has
+ * become ready, from a task and from an interrupt respectively.  Either may be
+ * called with interrupts masked or the scheduler suspended.
+ *
+ * The attach and detach functions link a source to its waiter, and are
+ * implemented in the source's own file as they need its private structure.
+ */
+void vWaiterNotify( WaiterHandle_t xWaiter,
+                    uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+void vWaiterNotifyFromISR( WaiterHandle_t xWaiter,
+                           uint32_t ulReadyBits,
+                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+BaseType_t xQueueAttachWaiter( QueueHandle_t xQueue,
+                               WaiterHandle_t xWaiter,
+                               uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+BaseType_t xQueueDetachWaiter( QueueHandle_t xQueue,
+                               WaiterHandle_t xWaiter ) PRIVILEGED_FUNCTION;
+
+BaseType_t xStreamBufferAttachWaiter( StreamBufferHandle_t xStreamBuffer,
+                                      WaiterHandle_t xWaiter,
+                                      uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+BaseType_t xStreamBufferDetachWaiter( StreamBufferHandle_t xStreamBuffer,
+                                      WaiterHandle_t xWaiter ) PRIVILEGED_FUNCTION;
+
+BaseType_t xEventGroupAttachWaiter( EventGroupHandle_t xEventGroup,
+                                    WaiterHandle_t xWaiter,
+                                    EventBits_t uxBitsToWaitFor,
+                                    uint32_t ulReadyBits ) PRIVILEGED_FUNCTION;
+
+BaseType_t xEventGroupDetachWaiter( EventGroupHandle_t xEventGroup,
+                                    WaiterHandle_t xWaiter ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( WAITER_H ) */
@@ -0,0 +1,382 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Work queues run functions deferred from interrupts, or from other tasks, in
+ * a worker task of their own.  Each work queue has one worker task, created
+ * with the queue at the priority given, so an application that needs deferred
+ * work at several priorities creates one queue per priority - for example a
+ * high priority queue for the bottom halves of communication interrupts and a
+ * low priority one for housekeeping.
+ *
+ * The work itself is described by a work item, created once with the function
+ * to run and its parameter.  Submitting an item links the item itself into
+ * the queue, so xWorkQueueSubmitFromISR() copies nothing and takes constant
+ * time in a short critical section.  An item is pending from the time it is
+ * submitted until the worker starts running it.  Submitting an item that is
+ * already pending does nothing more - the item runs once for both
+ * submissions.  An item can be submitted again from its own function, or
+ * while its function runs, and will then run again.
+ *
+ * Each queue counts the items submitted, coalesced and run, and, when
+ * configGENERATE_RUN_TIME_STATS is set to 1, the time from submission to the
+ * start of each item's function in run time counter units.  Read them with
+ * vWorkQueueGetStats().
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include work_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which work queues are referenced.  For example, a call to
+ * xWorkQueueCreate() returns a WorkQueueHandle_t variable that can then be
+ * used as a parameter to xWorkQueueSubmit(), vWorkQueueGetStats(), etc.
+ */
+struct WorkQueueDef_t;
+typedef struct WorkQueueDef_t * WorkQueueHandle_t;
+
+/**
+ * Type by which work items are referenced.
+ */
+struct WorkItemDef_t;
+typedef struct WorkItemDef_t * WorkItemHandle_t;
+
+/**
+ * Defines the prototype to which work item functions must conform.
+ */
+typedef void (* WorkFunction_t)( void * pvParameter );
+
+/**
+ * Used with vWorkQueueGetStats().
+ */
+typedef struct xWORK_QUEUE_STATS
+{
+    uint32_t ulSubmitted;                          /* Submissions that added an item to the queue. */
+    uint32_t ulCoalesced;                          /* Submissions of an item that was already pending. */
+    uint32_t ulRun;                                /* Items the worker task has run. */
+    UBaseType_t uxMaxPending;                      /* The most items that have been pending at once. */
+    configRUN_TIME_COUNTER_TYPE ulMinLatency;      /* The shortest time from submission to the start of the item's function. */
+    configRUN_TIME_COUNTER_TYPE ulMaxLatency;      /* The longest such time. */
+    configRUN_TIME_COUNTER_TYPE ulTotalLatency;    /* The sum of the ulRun times, so divide by ulRun for the mean.  The latency members stay 0 unless configGENERATE_RUN_TIME_STATS is set to 1. */
+} WorkQueueStats_t;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * WorkQueueHandle_t xWorkQueueCreate( const char * pcName,
+ *                                     UBaseType_t uxPriority,
+ *                                     configSTACK_DEPTH_TYPE usStackDepth );
+ * @endcode
+ *
+ * Creates a new work queue, and its worker task, using dynamically allocated
+ * memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xWorkQueueCreate() to be available.
+ *
+ * @param pcName The name of the worker task.
+ *
+ * @param uxPriority The priority of the worker task.  The functions of the
+ * items submitted to the queue run at this priority.
+ *
+ * @param usStackDepth The stack size of the worker task, in words, which must
+ * be enough for the deepest work item function.
+ *
+ * @return The handle of the created queue, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * Example use:
+ * @code{c}
+ * WorkQueueHandle_t xCommsWork;
+ * WorkItemHandle_t xUartRxWork;
+ *
+ * void vSetupDeferredWork( void )
+ * {
+ *  xCommsWork = xWorkQueueCreate( "comms", configMAX_PRIORITIES - 2, 256 );
+ *  xUartRxWork = xWorkItemCreate( vParseUartFrames, NULL );
+ * }
+ *
+ * void USART1_IRQHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  vAcknowledgeUartInterrupt();
+ *
+ *  // A burst of interrupts before the worker runs parses the frames once.
+ *  xWorkQueueSubmitFromISR( xCommsWork, xUartRxWork, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xWorkQueueCreate xWorkQueueCreate
+ * \ingroup WorkQueues
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        UBaseType_t uxPriority,
+                                        const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * WorkQueueHandle_t xWorkQueueCreateStatic( const char * pcName,
+ *                                           UBaseType_t uxPriority,
+ *                                           uint32_t ulStackDepth,
+ *                                           StackType_t * puxStackBuffer,
+ *                                           StaticTask_t * pxTaskBuffer,
+ *                                           StaticWorkQueue_t * pxWorkQueueBuffer );
+ * @endcode
+ *
+ * Creates a new work queue, and its worker task, using statically allocated
+ * memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xWorkQueueCreateStatic() to be available.
+ *
+ * @param pcName, uxPriority As for xWorkQueueCreate().
+ *
+ * @param ulStackDepth The number of StackType_t in puxStackBuffer.
+ *
+ * @param puxStackBuffer The stack of the worker task.
+ *
+ * @param pxTaskBuffer Holds the worker task's data structure.
+ *
+ * @param pxWorkQueueBuffer Holds the queue's data structure.
+ *
+ * @return The handle of the created queue, or NULL if a buffer was NULL.
+ *
+ * \defgroup xWorkQueueCreateStatic xWorkQueueCreateStatic
+ * \ingroup WorkQueues
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                              UBaseType_t uxPriority,
+                                              const uint32_t ulStackDepth,
+                                              StackType_t * const puxStackBuffer,
+                                              StaticTask_t * const pxTaskBuffer,
+                                              StaticWorkQueue_t * const pxWorkQueueBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * void vWorkQueueDelete( WorkQueueHandle_t xWorkQueue );
+ * @endcode
+ *
+ * Deletes the worker task and the queue.  Items still pending on the queue
+ * are dropped without running and can be submitted again.  Must not be called
+ * from a work item function of the queue itself.
+ *
+ * \defgroup vWorkQueueDelete vWorkQueueDelete
+ * \ingroup WorkQueues
+ */
+void vWorkQueueDelete( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * WorkItemHandle_t xWorkItemCreate( WorkFunction_t pxWorkFunction, void * pvParameter );
+ * @endcode
+ *
+ * Creates a work item using dynamically allocated memory.  Create the items
+ * before the interrupts that submit them are enabled.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xWorkItemCreate() to be available.
+ *
+ * @param pxWorkFunction The function the worker task calls each time the item
+ * runs.
+ *
+ * @param pvParameter Passed to pxWorkFunction.
+ *
+ * @return The handle of the created item, or NULL if there was insufficient
+ * heap memory available.
+ *
+ * \defgroup xWorkItemCreate xWorkItemCreate
+ * \ingroup WorkQueues
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WorkItemHandle_t xWorkItemCreate( WorkFunction_t pxWorkFunction,
+                                      void * pvParameter ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxWorkFunction,
+ *                                         void * pvParameter,
+ *                                         StaticWorkItem_t * pxWorkItemBuffer );
+ * @endcode
+ *
+ * Creates a work item in a variable of type StaticWorkItem_t.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xWorkItemCreateStatic() to be available.
+ *
+ * @return The handle of the created item, or NULL if pxWorkItemBuffer was
+ * NULL.
+ *
+ * \defgroup xWorkItemCreateStatic xWorkItemCreateStatic
+ * \ingroup WorkQueues
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxWorkFunction,
+                                            void * pvParameter,
+                                            StaticWorkItem_t * const pxWorkItemBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * void vWorkItemDelete( WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * Deletes a work item.  The item must not be pending.
+ *
+ * \defgroup vWorkItemDelete vWorkItemDelete
+ * \ingroup WorkQueues
+ */
+void vWorkItemDelete( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * @return pdTRUE if the item has been submitted and its function has not yet
+ * started, otherwise pdFALSE.
+ *
+ * \defgroup xWorkItemIsPending xWorkItemIsPending
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue, WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * Submits an item to a queue from a task.  Use xWorkQueueSubmitFromISR() from
+ * an interrupt service routine.
+ *
+ * @param xWorkQueue The handle of the queue whose worker will run the item.
+ *
+ * @param xWorkItem The item.
+ *
+ * @return pdPASS if the item was added to the queue, or pdFAIL if it was
+ * already pending, in which case it runs only once.
+ *
+ * \defgroup xWorkQueueSubmit xWorkQueueSubmit
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+ *                                     WorkItemHandle_t xWorkItem,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xWorkQueueSubmit() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the submission unblocked
+ * the worker task and it has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the item was added to the queue, or pdFAIL if it was
+ * already pending.
+ *
+ * \defgroup xWorkQueueSubmitFromISR xWorkQueueSubmitFromISR
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItemHandle_t xWorkItem,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue, WorkQueueStats_t * pxStats );
+ * @endcode
+ *
+ * Copies the statistics of a queue, counted since it was created or since the
+ * last call to vWorkQueueResetStats().
+ *
+ * \defgroup vWorkQueueGetStats vWorkQueueGetStats
+ * \ingroup WorkQueues
+ */
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                         WorkQueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ *
+ * @code{c}
+ * void vWorkQueueResetStats( WorkQueueHandle_t xWorkQueue );
+ * @endcode
+ *
+ * Zeroes the statistics of a queue.
+ *
+ * \defgroup vWorkQueueResetStats vWorkQueueResetStats
+ * \ingroup WorkQueues
+ */
+void vWorkQueueResetStats( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( WORK_QUEUE_H ) */
@@ -0,0 +1,461 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mem_pool.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*
+ * Free blocks are kept on a singly linked list threaded through their first
+ * word, so allocating and freeing a block is a pointer swap inside a short
+ * critical section - never a scheduler suspension, which is why the FromISR
+ * versions exist at all.  Blocks that have never been handed out are taken
+ * from the top of the unused part of the storage area instead of being linked
+ * at creation time, so creating a pool is O(1) too.
+ */
+
+/* Bits stored in the ucFlags field of the pool. */
+#define memFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the pool. */
+typedef struct MemPoolDef_t         /*lint !e9058 Style convention uses tag. */
+{
+    void * pvFreeList;              /* The most recently freed block, whose first word points to the next free block. */
+    uint8_t * pucNextUnused;        /* Blocks from here to pucStorageEnd have never been allocated. */
+    uint8_t * pucStorage;           /* Points to the first block. */
+    uint8_t * pucStorageEnd;        /* Points one past the last block. */
+    size_t xBlockSize;              /* The size of each block, rounded up to portBYTE_ALIGNMENT. */
+    UBaseType_t uxBlockCount;       /* The number of blocks in the pool. */
+    UBaseType_t uxFreeBlocks;       /* The number of blocks not currently allocated. */
+    UBaseType_t uxMinimumEverFreeBlocks; /* The lowest value uxFreeBlocks has had. */
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+    uint8_t ucFlags;
+} MemPool_t;
+
+/*
+ * Called by both xMemPoolCreate() and xMemPoolCreateStatic() to initialise the
+ * members of the newly created pool structure.
+ */
+static void prvInitialiseNewMemPool( MemPool_t * const pxPool,
+                                     uint8_t * const pucStorage,
+                                     size_t xBlockSize,
+                                     UBaseType_t uxBlockCount,
+                                     uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take a block off the pool, or return NULL if there is none.  Must be called
+ * from inside a critical section.
+ */
+static void * prvAllocateBlock( MemPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a block to the pool.  Must be called from inside a critical
+ * section.
+ */
+static void prvFreeBlock( MemPool_t * const pxPool,
+                          void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    MemPoolHandle_t xMemPoolCreate( size_t xBlockSize,
+                                    UBaseType_t uxBlockCount )
+    {
+        uint8_t * pucAllocatedMemory = NULL;
+        size_t xStructSize, xStorageBytes;
+
+        configASSERT( xBlockSize > ( size_t ) 0 );
+        configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+        /* The structure and the storage area are allocated in a single call to
+         * pvPortMalloc(), with the storage area immediately after the
+         * structure, so the pool shows up in the heap statistics as one
+         * allocated block.  The structure size is rounded up so the first
+         * block is aligned. */
+        xStructSize = ( sizeof( MemPool_t ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+        xStorageBytes = memPOOL_STORAGE_SIZE( xBlockSize, uxBlockCount );
+
+        if( ( ( xStorageBytes / memPOOL_BLOCK_SIZE( xBlockSize ) ) == ( size_t ) uxBlockCount ) &&
+            ( xStorageBytes <= ( ( ~( size_t ) 0 ) - xStructSize ) ) )
+        {
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xStructSize + xStorageBytes ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewMemPool( ( MemPool_t * ) pucAllocatedMemory, /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                     pucAllocatedMemory + xStructSize,  /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer. */
+                                     xBlockSize,
+                                     uxBlockCount,
+                                     0 );
+
+            traceMEM_POOL_CREATE( ( ( MemPool_t * ) pucAllocatedMemory ) ); /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ( MemPoolHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize,
+                                          UBaseType_t uxBlockCount,
+                                          uint8_t * const pucPoolStorageArea,
+                                          StaticMemPool_t * const pxStaticMemPool )
+    {
+        MemPool_t * const pxPool = ( MemPool_t * ) pxStaticMemPool; /*lint !e740 !e9087 Safe cast as StaticMemPool_t is opaque MemPool_t. */
+        MemPoolHandle_t xReturn;
+
+        configASSERT( pucPoolStorageArea );
+        configASSERT( pxStaticMemPool );
+        configASSERT( xBlockSize > ( size_t ) 0 );
+        configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+        /* The blocks are handed out as aligned memory, so the storage area
+         * must start aligned. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucPoolStorageArea ) & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0U );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticMemPool_t equals the size of the real pool
+             * structure. */
+            volatile size_t xSize = sizeof( StaticMemPool_t );
+            configASSERT( xSize == sizeof( MemPool_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucPoolStorageArea != NULL ) && ( pxStaticMemPool != NULL ) )
+        {
+            prvInitialiseNewMemPool( pxPool,
+                                     pucPoolStorageArea,
+                                     xBlockSize,
+                                     uxBlockCount,
+                                     memFLAGS_IS_STATICALLY_ALLOCATED );
+
+            traceMEM_POOL_CREATE( pxPool );
+
+            xReturn = ( MemPoolHandle_t ) pxStaticMemPool; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vMemPoolDelete( MemPoolHandle_t xMemPool )
+{
+    MemPool_t * pxPool = xMemPool;
+
+    configASSERT( pxPool );
+
+    /* Every block must have been returned before the pool is deleted. */
+    configASSERT( pxPool->uxFreeBlocks == pxPool->uxBlockCount );
+
+    if( ( pxPool->ucFlags & memFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the storage were allocated using a single
+             * call to pvPortMalloc(), hence only one call to vPortFree() is
+             * required. */
+            vPortFree( ( void * ) pxPool ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xMemPool == ( MemPoolHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* Scrub the structure so future use will assert. */
+        ( void ) memset( pxPool, 0x00, sizeof( MemPool_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAlloc( MemPoolHandle_t xMemPool )
+{
+    MemPool_t * const pxPool = xMemPool;
+    void * pvReturn;
+
+    configASSERT( pxPool );
+
+    taskENTER_CRITICAL();
+    {
+        pvReturn = prvAllocateBlock( pxPool );
+    }
+    taskEXIT_CRITICAL();
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAllocFromISR( MemPoolHandle_t xMemPool )
+{
+    MemPool_t * const pxPool = xMemPool;
+    void * pvReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxPool );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions. */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pvReturn = prvAllocateBlock( pxPool );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFree( MemPoolHandle_t xMemPool,
+                   void * pvBlock )
+{
+    MemPool_t * const pxPool = xMemPool;
+
+    configASSERT( pxPool );
+
+    if( pvBlock != NULL )
+    {
+        taskENTER_CRITICAL();
+        {
+            prvFreeBlock( pxPool, pvBlock );
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeFromISR( MemPoolHandle_t xMemPool,
+                          void * pvBlock )
+{
+    MemPool_t * const pxPool = xMemPool;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxPool );
+
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    if( pvBlock != NULL )
+    {
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            prvFreeBlock( pxPool, pvBlock );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemPoolGetFreeBlockCount( MemPoolHandle_t xMemPool )
+{
+    const MemPool_t * const pxPool = xMemPool;
+
+    configASSERT( pxPool );
+
+    return pxPool->uxFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemPoolGetMinimumEverFreeBlockCount( MemPoolHandle_t xMemPool )
+{
+    const MemPool_t * const pxPool = xMemPool;
+
+    configASSERT( pxPool );
+
+    return pxPool->uxMinimumEverFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+size_t xMemPoolGetBlockSize( MemPoolHandle_t xMemPool )
+{
+    const MemPool_t * const pxPool = xMemPool;
+
+    configASSERT( pxPool );
+
+    return pxPool->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolGetHeapStats( MemPoolHandle_t xMemPool,
+                           HeapStats_t * pxHeapStats )
+{
+    const MemPool_t * const pxPool = xMemPool;
+
+    configASSERT( pxPool );
+    configASSERT( pxHeapStats );
+
+    taskENTER_CRITICAL();
+    {
+        /* Every free block is the same size, so the pool never fragments and
+         * the largest and smallest free blocks are the block size. */
+        pxHeapStats->xAvailableHeapSpaceInBytes = ( size_t ) pxPool->uxFreeBlocks * pxPool->xBlockSize;
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = ( pxPool->uxFreeBlocks > ( UBaseType_t ) 0 ) ? pxPool->xBlockSize : ( size_t ) 0;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = pxHeapStats->xSizeOfLargestFreeBlockInBytes;
+        pxHeapStats->xNumberOfFreeBlocks = ( size_t ) pxPool->uxFreeBlocks;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = ( size_t ) pxPool->uxMinimumEverFreeBlocks * pxPool->xBlockSize;
+        pxHeapStats->xNumberOfSuccessfulAllocations = pxPool->xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = pxPool->xNumberOfSuccessfulFrees;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocateBlock( MemPool_t * const pxPool )
+{
+    void * pvReturn = pxPool->pvFreeList;
+
+    if( pvReturn != NULL )
+    {
+        pxPool->pvFreeList = *( ( void ** ) pvReturn );
+    }
+    else if( pxPool->pucNextUnused < pxPool->pucStorageEnd )
+    {
+        pvReturn = ( void * ) pxPool->pucNextUnused;
+        pxPool->pucNextUnused += pxPool->xBlockSize;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pvReturn != NULL )
+    {
+        pxPool->uxFreeBlocks--;
+
+        if( pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks )
+        {
+            pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxPool->xNumberOfSuccessfulAllocations++;
+        traceMEM_POOL_ALLOC( pxPool, pvReturn );
+    }
+    else
+    {
+        traceMEM_POOL_ALLOC_FAILED( pxPool );
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeBlock( MemPool_t * const pxPool,
+                          void * pvBlock )
+{
+    uint8_t * const pucBlock = ( uint8_t * ) pvBlock;
+
+    /* The block must be one this pool handed out, and the pool cannot have
+     * more free blocks than it holds. */
+    configASSERT( ( pucBlock >= pxPool->pucStorage ) && ( pucBlock < pxPool->pucNextUnused ) );
+    configASSERT( ( ( size_t ) ( pucBlock - pxPool->pucStorage ) % pxPool->xBlockSize ) == ( size_t ) 0 );
+    configASSERT( pxPool->uxFreeBlocks < pxPool->uxBlockCount );
+
+    *( ( void ** ) pvBlock ) = pxPool->pvFreeList;
+    pxPool->pvFreeList = pvBlock;
+    pxPool->uxFreeBlocks++;
+    pxPool->xNumberOfSuccessfulFrees++;
+    traceMEM_POOL_FREE( pxPool, pvBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewMemPool( MemPool_t * const pxPool,
+                                     uint8_t * const pucStorage,
+                                     size_t xBlockSize,
+                                     UBaseType_t uxBlockCount,
+                                     uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxPool, 0x00, sizeof( MemPool_t ) ); /*lint !e9087 memset() requires void *. */
+    pxPool->xBlockSize = memPOOL_BLOCK_SIZE( xBlockSize );
+    pxPool->pucStorage = pucStorage;
+    pxPool->pucNextUnused = pucStorage;
+    pxPool->pucStorageEnd = pucStorage + ( pxPool->xBlockSize * ( size_t ) uxBlockCount );
+    pxPool->uxBlockCount = uxBlockCount;
+    pxPool->uxFreeBlocks = uxBlockCount;
+    pxPool->uxMinimumEverFreeBlocks = uxBlockCount;
+    pxPool->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,614 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "mem_pool.h"
+#include "msg_bus.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include dynamic allocation, as the bus, topics and subscriptions are
+ * allocated from the FreeRTOS heap. */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/*
+ * A message is a block of the bus's memory pool: a header holding the
+ * reference count, then the message itself.  The publisher holds one
+ * reference from allocation.  Publishing takes one more for each subscriber
+ * the message is queued to, before it is queued, then gives up the
+ * publisher's, so the block goes back to the pool when the last subscriber
+ * releases it - or straight away if no subscriber took the message.  The
+ * reference count is only changed inside a critical section, as interrupts
+ * publish and release messages too.  A publish takes the references of all the
+ * subscribers at once, and gives back those of the subscribers it could not
+ * queue to together with its own, so the cost of fanning a message out is the
+ * queue sends.
+ *
+ * Each subscription is a queue of message pointers.  The subscriptions of a
+ * topic are on a singly linked list that publishers walk, from a task with the
+ * scheduler suspended and from interrupts directly, so subscribing and
+ * unsubscribing change the list inside a critical section.
+ */
+
+/* The size of the message header, rounded up so messages are aligned. */
+    #define msgHEADER_SIZE    ( ( sizeof( MsgHeader_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+    #define msgHEADER( pvMessage )     ( ( MsgHeader_t * ) ( ( ( uint8_t * ) ( pvMessage ) ) - msgHEADER_SIZE ) )
+    #define msgMESSAGE( pxHeader )     ( ( void * ) ( ( ( uint8_t * ) ( pxHeader ) ) + msgHEADER_SIZE ) )
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on a bus. */
+    typedef struct MsgBusDef_t          /*lint !e9058 Style convention uses tag. */
+    {
+        MemPoolHandle_t xPool;          /* The message buffers, with their headers. */
+        size_t xMaxMessageSize;
+        UBaseType_t uxTopics;           /* The number of topics created on the bus and not deleted. */
+    } MsgBus_t;
+
+/* Structure that holds state information on a topic. */
+    typedef struct MsgTopicDef_t        /*lint !e9058 Style convention uses tag. */
+    {
+        MsgBus_t * pxBus;
+        struct MsgSubscriberDef_t * pxSubscribers; /* The most recent subscription, whose pxNext is the one before. */
+        UBaseType_t uxSubscribers;                 /* The length of the pxSubscribers list. */
+    } MsgTopic_t;
+
+/* Structure that holds state information on a subscription. */
+    typedef struct MsgSubscriberDef_t   /*lint !e9058 Style convention uses tag. */
+    {
+        struct MsgSubscriberDef_t * pxNext;
+        MsgTopic_t * pxTopic;
+        QueueHandle_t xQueue;           /* Pointers to the messages not yet received. */
+        uint32_t ulDropped;             /* Messages dropped because xQueue was full. */
+    } MsgSubscriber_t;
+
+/* The header in front of each message. */
+    typedef struct MsgHeader
+    {
+        MsgBus_t * pxBus;
+        UBaseType_t uxReferences;
+        size_t xLength;
+    } MsgHeader_t;
+
+/*
+ * Take a reference to the message for each subscriber of the topic and queue
+ * it to them without blocking, then give up the references of the subscribers
+ * whose backlog was full and the publisher's own.  Returns the number of
+ * subscribers the message was queued to.  pxHigherPriorityTaskWoken is NULL
+ * when called from a task.
+ */
+    static UBaseType_t prvDeliver( MsgTopic_t * const pxTopic,
+                                   void * pvMessage,
+                                   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add uxCount references to a message.
+ */
+    static void prvTakeReferences( MsgHeader_t * const pxHeader,
+                                   UBaseType_t uxCount,
+                                   BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give up uxCount references to a message, and return it to the pool if they
+ * were the last.
+ */
+    static void prvRelease( void * pvMessage,
+                            UBaseType_t uxCount,
+                            BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    MsgBusHandle_t xMsgBusCreate( size_t xMaxMessageSize,
+                                  UBaseType_t uxMessageCount )
+    {
+        MsgBus_t * pxBus;
+
+        configASSERT( xMaxMessageSize > ( size_t ) 0 );
+        configASSERT( uxMessageCount > ( UBaseType_t ) 0 );
+
+        pxBus = ( MsgBus_t * ) pvPortMalloc( sizeof( MsgBus_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxBus != NULL )
+        {
+            pxBus->xPool = xMemPoolCreate( msgHEADER_SIZE + xMaxMessageSize, uxMessageCount );
+
+            if( pxBus->xPool != NULL )
+            {
+                pxBus->xMaxMessageSize = xMaxMessageSize;
+                pxBus->uxTopics = ( UBaseType_t ) 0;
+                traceMSG_BUS_CREATE( pxBus );
+            }
+            else
+            {
+                vPortFree( ( void * ) pxBus );
+                pxBus = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxBus;
+    }
+/*-----------------------------------------------------------*/
+
+    void vMsgBusDelete( MsgBusHandle_t xBus )
+    {
+        MsgBus_t * pxBus = xBus;
+
+        configASSERT( pxBus );
+        configASSERT( pxBus->uxTopics == ( UBaseType_t ) 0 );
+
+        /* Asserts if a message is still in use. */
+        vMemPoolDelete( pxBus->xPool );
+        vPortFree( ( void * ) pxBus );
+    }
+/*-----------------------------------------------------------*/
+
+    MsgTopicHandle_t xMsgBusCreateTopic( MsgBusHandle_t xBus )
+    {
+        MsgBus_t * const pxBus = xBus;
+        MsgTopic_t * pxTopic;
+
+        configASSERT( pxBus );
+
+        pxTopic = ( MsgTopic_t * ) pvPortMalloc( sizeof( MsgTopic_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxTopic != NULL )
+        {
+            pxTopic->pxBus = pxBus;
+            pxTopic->pxSubscribers = NULL;
+            pxTopic->uxSubscribers = ( UBaseType_t ) 0;
+
+            taskENTER_CRITICAL();
+            {
+                ( pxBus->uxTopics )++;
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxTopic;
+    }
+/*-----------------------------------------------------------*/
+
+    void vMsgBusDeleteTopic( MsgTopicHandle_t xTopic )
+    {
+        MsgTopic_t * pxTopic = xTopic;
+
+        configASSERT( pxTopic );
+        configASSERT( pxTopic->pxSubscribers == NULL );
+
+        taskENTER_CRITICAL();
+        {
+            ( pxTopic->pxBus->uxTopics )--;
+        }
+        taskEXIT_CRITICAL();
+
+        vPortFree( ( void * ) pxTopic );
+    }
+/*-----------------------------------------------------------*/
+
+    MsgSubscriberHandle_t xMsgBusSubscribe( MsgTopicHandle_t xTopic,
+                                            UBaseType_t uxBacklog )
+    {
+        MsgTopic_t * const pxTopic = xTopic;
+        MsgSubscriber_t * pxSubscriber;
+
+        configASSERT( pxTopic );
+        configASSERT( uxBacklog > ( UBaseType_t ) 0 );
+
+        pxSubscriber = ( MsgSubscriber_t * ) pvPortMalloc( sizeof( MsgSubscriber_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxSubscriber != NULL )
+        {
+            pxSubscriber->xQueue = xQueueCreate( uxBacklog, sizeof( void * ) );
+
+            if( pxSubscriber->xQueue != NULL )
+            {
+                pxSubscriber->pxTopic = pxTopic;
+                pxSubscriber->ulDropped = 0U;
+
+                /* Publishers see the subscription once it is fully set up. */
+                taskENTER_CRITICAL();
+                {
+                    pxSubscriber->pxNext = pxTopic->pxSubscribers;
+                    pxTopic->pxSubscribers = pxSubscriber;
+                    ( pxTopic->uxSubscribers )++;
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                vPortFree( ( void * ) pxSubscriber );
+                pxSubscriber = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSubscriber;
+    }
+/*-----------------------------------------------------------*/
+
+    void vMsgBusUnsubscribe( MsgSubscriberHandle_t xSubscriber )
+    {
+        MsgSubscriber_t * pxSubscriber = xSubscriber;
+        MsgSubscriber_t ** ppxLink;
+        void * pvMessage;
+
+        configASSERT( pxSubscriber );
+
+        /* A task walking the list has the scheduler suspended, so cannot be
+         * part way through it here.  Once the subscription is off the list no
+         * publisher queues to it. */
+        taskENTER_CRITICAL();
+        {
+            for( ppxLink = &( pxSubscriber->pxTopic->pxSubscribers ); *ppxLink != pxSubscriber; ppxLink = &( ( *ppxLink )->pxNext ) )
+            {
+                configASSERT( *ppxLink );
+            }
+
+            *ppxLink = pxSubscriber->pxNext;
+            ( pxSubscriber->pxTopic->uxSubscribers )--;
+        }
+        taskEXIT_CRITICAL();
+
+        while( xQueueReceive( pxSubscriber->xQueue, &pvMessage, 0 ) == pdPASS )
+        {
+            prvRelease( pvMessage, ( UBaseType_t ) 1, pdFALSE );
+        }
+
+        vQueueDelete( pxSubscriber->xQueue );
+        vPortFree( ( void * ) pxSubscriber );
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvMsgBusAlloc( MsgBusHandle_t xBus )
+    {
+        MsgBus_t * const pxBus = xBus;
+        MsgHeader_t * pxHeader;
+        void * pvReturn = NULL;
+
+        configASSERT( pxBus );
+
+        pxHeader = ( MsgHeader_t * ) pvMemPoolAlloc( pxBus->xPool ); /*lint !e9079 Blocks are aligned. */
+
+        if( pxHeader != NULL )
+        {
+            pxHeader->pxBus = pxBus;
+            pxHeader->uxReferences = ( UBaseType_t ) 1;
+            pxHeader->xLength = ( size_t ) 0;
+            pvReturn = msgMESSAGE( pxHeader );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvMsgBusAllocFromISR( MsgBusHandle_t xBus )
+    {
+        MsgBus_t * const pxBus = xBus;
+        MsgHeader_t * pxHeader;
+        void * pvReturn = NULL;
+
+        configASSERT( pxBus );
+
+        pxHeader = ( MsgHeader_t * ) pvMemPoolAllocFromISR( pxBus->xPool ); /*lint !e9079 Blocks are aligned. */
+
+        if( pxHeader != NULL )
+        {
+            pxHeader->pxBus = pxBus;
+            pxHeader->uxReferences = ( UBaseType_t ) 1;
+            pxHeader->xLength = ( size_t ) 0;
+            pvReturn = msgMESSAGE( pxHeader );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxMsgBusPublish( MsgTopicHandle_t xTopic,
+                                 void * pvMessage,
+                                 size_t xLength )
+    {
+        MsgTopic_t * const pxTopic = xTopic;
+        UBaseType_t uxDelivered;
+
+        configASSERT( pxTopic );
+        configASSERT( pvMessage );
+        configASSERT( msgHEADER( pvMessage )->pxBus == pxTopic->pxBus );
+        configASSERT( xLength <= pxTopic->pxBus->xMaxMessageSize );
+
+        msgHEADER( pvMessage )->xLength = xLength;
+
+        /* The scheduler is suspended so the subscription list cannot change
+         * while it is walked, and so subscribers woken by the queue sends run
+         * once the whole topic has been served. */
+        vTaskSuspendAll();
+        {
+            uxDelivered = prvDeliver( pxTopic, pvMessage, NULL );
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxDelivered;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxMsgBusPublishFromISR( MsgTopicHandle_t xTopic,
+                                        void * pvMessage,
+                                        size_t xLength,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        MsgTopic_t * const pxTopic = xTopic;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t uxDelivered;
+
+        configASSERT( pxTopic );
+        configASSERT( pvMessage );
+        configASSERT( msgHEADER( pvMessage )->pxBus == pxTopic->pxBus );
+        configASSERT( xLength <= pxTopic->pxBus->xMaxMessageSize );
+
+        msgHEADER( pvMessage )->xLength = xLength;
+
+        uxDelivered = prvDeliver( pxTopic, pvMessage, &xHigherPriorityTaskWoken );
+
+        if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxDelivered;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvMsgBusReceive( MsgSubscriberHandle_t xSubscriber,
+                            TickType_t xTicksToWait )
+    {
+        MsgSubscriber_t * const pxSubscriber = xSubscriber;
+        void * pvMessage;
+
+        configASSERT( pxSubscriber );
+
+        if( xQueueReceive( pxSubscriber->xQueue, &pvMessage, xTicksToWait ) != pdPASS )
+        {
+            pvMessage = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvMessage;
+    }
+/*-----------------------------------------------------------*/
+
+    void vMsgBusRelease( void * pvMessage )
+    {
+        configASSERT( pvMessage );
+
+        prvRelease( pvMessage, ( UBaseType_t ) 1, pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    void vMsgBusReleaseFromISR( void * pvMessage )
+    {
+        configASSERT( pvMessage );
+
+        prvRelease( pvMessage, ( UBaseType_t ) 1, pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xMsgBusGetLength( const void * pvMessage )
+    {
+        configASSERT( pvMessage );
+
+        return msgHEADER( pvMessage )->xLength;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulMsgBusGetDropCount( MsgSubscriberHandle_t xSubscriber )
+    {
+        MsgSubscriber_t * const pxSubscriber = xSubscriber;
+
+        configASSERT( pxSubscriber );
+
+        return pxSubscriber->ulDropped;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxMsgBusGetFreeMessageCount( MsgBusHandle_t xBus )
+    {
+        MsgBus_t * const pxBus = xBus;
+
+        configASSERT( pxBus );
+
+        return uxMemPoolGetFreeBlockCount( pxBus->xPool );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvDeliver( MsgTopic_t * const pxTopic,
+                                   void * pvMessage,
+                                   BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        MsgSubscriber_t * pxSubscriber;
+        UBaseType_t uxDelivered = ( UBaseType_t ) 0;
+        UBaseType_t uxUnused = ( UBaseType_t ) 1;
+        BaseType_t xQueued;
+
+        /* The references are taken before the message is queued, as a
+         * subscriber may release it as soon as it is. */
+        prvTakeReferences( msgHEADER( pvMessage ), pxTopic->uxSubscribers, ( BaseType_t ) ( pxHigherPriorityTaskWoken != NULL ) );
+
+        for( pxSubscriber = pxTopic->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+        {
+            if( pxHigherPriorityTaskWoken == NULL )
+            {
+                xQueued = xQueueSend( pxSubscriber->xQueue, &pvMessage, 0 );
+            }
+            else
+            {
+                xQueued = xQueueSendFromISR( pxSubscriber->xQueue, &pvMessage, pxHigherPriorityTaskWoken );
+            }
+
+            if( xQueued == pdPASS )
+            {
+                uxDelivered++;
+            }
+            else
+            {
+                /* The backlog is full.  Only the publisher, with the scheduler
+                 * suspended or from an interrupt, updates ulDropped. */
+                ( pxSubscriber->ulDropped )++;
+                uxUnused++;
+                traceMSG_BUS_DROP( pxSubscriber, pvMessage );
+            }
+        }
+
+        traceMSG_BUS_PUBLISH( pxTopic, pvMessage, uxDelivered );
+
+        prvRelease( pvMessage, uxUnused, ( BaseType_t ) ( pxHigherPriorityTaskWoken != NULL ) );
+
+        return uxDelivered;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTakeReferences( MsgHeader_t * const pxHeader,
+                                   UBaseType_t uxCount,
+                                   BaseType_t xFromISR )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( uxCount > ( UBaseType_t ) 0 )
+        {
+            if( xFromISR != pdFALSE )
+            {
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    pxHeader->uxReferences += uxCount;
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxHeader->uxReferences += uxCount;
+                }
+                taskEXIT_CRITICAL();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRelease( void * pvMessage,
+                            UBaseType_t uxCount,
+                            BaseType_t xFromISR )
+    {
+        MsgHeader_t * const pxHeader = msgHEADER( pvMessage );
+        UBaseType_t uxSavedInterruptStatus, uxReferences;
+
+        if( xFromISR != pdFALSE )
+        {
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                configASSERT( pxHeader->uxReferences >= uxCount );
+                pxHeader->uxReferences -= uxCount;
+                uxReferences = pxHeader->uxReferences;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                configASSERT( pxHeader->uxReferences >= uxCount );
+                pxHeader->uxReferences -= uxCount;
+                uxReferences = pxHeader->uxReferences;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( uxReferences == ( UBaseType_t ) 0 )
+        {
+            if( xFromISR != pdFALSE )
+            {
+                vMemPoolFreeFromISR( pxHeader->pxBus->xPool, ( void * ) pxHeader );
+            }
+            else
+            {
+                vMemPoolFree( pxHeader->pxBus->xPool, ( void * ) pxHeader );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
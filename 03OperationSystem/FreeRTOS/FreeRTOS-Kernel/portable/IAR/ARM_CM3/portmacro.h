@@ -101,6 +101,21 @@
 
 /*-----------------------------------------------------------*/
 
+/* Run time stats counted in CPU cycles by the DWT cycle counter, extended to
+ * 64 bits, so configRUN_TIME_COUNTER_TYPE should be uint64_t.  Must not be read
+ * from interrupts above configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+    #ifndef configUSE_DWT_RUN_TIME_COUNTER
+        #define configUSE_DWT_RUN_TIME_COUNTER    0
+    #endif
+
+    #if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+        extern void vPortConfigureRunTimeCounter( void );
+        extern uint64_t ullPortGetRunTimeCounterValue( void );
+        #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortConfigureRunTimeCounter()
+        #define portGET_RUN_TIME_COUNTER_VALUE()            ullPortGetRunTimeCounterValue()
+    #endif
+/*-----------------------------------------------------------*/
+
 /* Architecture specific optimisations. */
     #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
         #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
@@ -109,17 +124,68 @@
     #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
 
 /* Check the configuration. */
-        #if ( configMAX_PRIORITIES > 32 )
-            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+        #if ( configMAX_PRIORITIES > 1024 )
+            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
         #endif
 
+        #if ( configMAX_PRIORITIES <= 32 )
+
 /* Store/clear the ready priorities in a bit map. */
-        #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
-        #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+            #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+            #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
 
 /*-----------------------------------------------------------*/
 
-        #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ( 31UL - ( ( uint32_t ) __CLZ( ( uxReadyPriorities ) ) ) )
+            #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ( 31UL - ( ( uint32_t ) __CLZ( ( uxReadyPriorities ) ) ) )
+
+        #else /* configMAX_PRIORITIES */
+
+/* Above 32 priorities the ready priorities are kept in a two level bit map.
+ * Bit n of ulGroups is set while ulPriorities[ n ] is not zero, so the
+ * highest ready priority is found with two CLZ instructions however many
+ * priorities are in use. */
+            typedef struct xPORT_READY_PRIORITIES
+            {
+                uint32_t ulGroups;
+                uint32_t ulPriorities[ ( configMAX_PRIORITIES + 31 ) / 32 ];
+            } PortReadyPriorities_t;
+
+            #define portREADY_PRIORITIES_TYPE    PortReadyPriorities_t
+
+/* Store/clear the ready priorities in the bit map. */
+            #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )                                     \
+            {                                                                                                      \
+                ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31UL ) ); \
+                ( uxReadyPriorities ).ulGroups |= ( 1UL << ( ( uxPriority ) >> 5 ) );                              \
+            }
+
+            #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )                                       \
+            {                                                                                                       \
+                ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) ); \
+                                                                                                                    \
+                if( ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] == 0UL )                              \
+                {                                                                                                   \
+                    ( uxReadyPriorities ).ulGroups &= ~( 1UL << ( ( uxPriority ) >> 5 ) );                          \
+                }                                                                                                   \
+            }
+
+/*-----------------------------------------------------------*/
+
+            #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )                                                         \
+            {                                                                                                                            \
+                uint32_t ulTopGroup = 31UL - ( uint32_t ) __CLZ( ( uxReadyPriorities ).ulGroups );                                       \
+                                                                                                                                         \
+                uxTopPriority = ( ulTopGroup << 5 ) + ( 31UL - ( uint32_t ) __CLZ( ( uxReadyPriorities ).ulPriorities[ ulTopGroup ] ) ); \
+            }
+
+/* The highest bit set in one word of the bit map, which the index of event
+ * lists also uses. */
+            #define portGET_HIGHEST_SET_BIT( uxBit, ulBitmap )    uxBit = ( 31UL - ( ( uint32_t ) __CLZ( ( ulBitmap ) ) ) )
+
+/* The idle priority is bit 0 of the first word. */
+            #define portHAS_READY_PRIORITY_ABOVE_IDLE( uxReadyPriorities )    ( ( ( uxReadyPriorities ).ulGroups > 1UL ) || ( ( uxReadyPriorities ).ulPriorities[ 0 ] > 1UL ) )
+
+        #endif /* configMAX_PRIORITIES */
 
     #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 /*-----------------------------------------------------------*/
@@ -195,6 +261,32 @@
 
 /*-----------------------------------------------------------*/
 
+/* Atomically replace *ppvDestination with pvExchange if it still holds
+ * pvComparand.  The exclusive monitor is cleared if the compare fails, and the
+ * STREX is retried if the reservation was lost to an interrupt or a context
+ * switch. */
+    portFORCE_INLINE static BaseType_t xPortCompareAndSwapPointer( void * volatile * ppvDestination,
+                                                                   void * pvExchange,
+                                                                   void * pvComparand )
+    {
+        volatile uint32_t * pulDestination = ( volatile uint32_t * ) ppvDestination;
+
+        do
+        {
+            if( __LDREX( ( unsigned long * ) pulDestination ) != ( uint32_t ) pvComparand )
+            {
+                __CLREX();
+                return pdFALSE;
+            }
+        } while( __STREX( ( uint32_t ) pvExchange, ( unsigned long * ) pulDestination ) != 0 );
+
+        return pdTRUE;
+    }
+
+    #define portCOMPARE_AND_SWAP_POINTER( ppvDestination, pvExchange, pvComparand )    xPortCompareAndSwapPointer( ( ppvDestination ), ( pvExchange ), ( pvComparand ) )
+
+/*-----------------------------------------------------------*/
+
 /* Suppress warnings that are generated by the IAR tools, but cannot be fixed in
  * the source code because to do so would cause other compilers to generate
  * warnings. */
@@ -0,0 +1,820 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that runs in
+ * bounded time: a two-level segregated fit (TLSF) allocator.  Like heap_5.c the
+ * heap can be spread across multiple non-contiguous regions, and adjacent free
+ * blocks are combined as they are freed.
+ *
+ * heap_4.c and heap_5.c search a single address ordered free list first fit, so
+ * the time spent with the scheduler suspended grows with the number of free
+ * blocks.  heap_6.c instead keeps one free list per size class.  The first
+ * level splits sizes at powers of two and the second level splits each power
+ * of two into configTLSF_SL_INDEX_COUNT linear steps.  A bitmap per level
+ * records which lists are non-empty, so finding a block that is large enough
+ * takes two find-first-set operations, and freeing a block finds its physical
+ * neighbours through its header without any search.  The price is that a
+ * request is served from the next size class up (good fit rather than best
+ * fit), so a free block in the request's own size class that would just have
+ * fitted is passed over, and the remainder of the larger block is split off.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc(), exactly
+ * as with heap_5.c, and takes the same NULL terminated array of HeapRegion_t
+ * structures, which must appear in address order from low address to high
+ * address:
+ *
+ * HeapRegion_t xHeapRegions[] =
+ * {
+ *  { ucHeapInSram1, sizeof( ucHeapInSram1 ) },
+ *  { ucHeapInSram2, sizeof( ucHeapInSram2 ) },
+ *  { NULL, 0 }                << Terminates the array.
+ * };
+ *
+ * vPortDefineHeapRegions( xHeapRegions );
+ *
+ * No single block can be larger than 2 ^ configTLSF_FL_INDEX_MAX bytes, so a
+ * region larger than that is added to the heap as several blocks, and an
+ * allocation request larger than that fails.
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Log2 of the largest block size + 1.  Each first level index costs
+ * configTLSF_SL_INDEX_COUNT list heads, so keep it close to the heap size. */
+#ifndef configTLSF_FL_INDEX_MAX
+    #define configTLSF_FL_INDEX_MAX    20
+#endif
+
+/* Number of linear size classes each power of two is split into.  More
+ * classes waste less of each block at the cost of more list heads. */
+#ifndef configTLSF_SL_INDEX_COUNT
+    #define configTLSF_SL_INDEX_COUNT    16
+#endif
+
+#if ( configTLSF_SL_INDEX_COUNT == 32 )
+    #define heapSL_INDEX_COUNT_LOG2    5
+#elif ( configTLSF_SL_INDEX_COUNT == 16 )
+    #define heapSL_INDEX_COUNT_LOG2    4
+#elif ( configTLSF_SL_INDEX_COUNT == 8 )
+    #define heapSL_INDEX_COUNT_LOG2    3
+#elif ( configTLSF_SL_INDEX_COUNT == 4 )
+    #define heapSL_INDEX_COUNT_LOG2    2
+#else
+    #error configTLSF_SL_INDEX_COUNT must be 4, 8, 16 or 32
+#endif
+
+#if ( portBYTE_ALIGNMENT == 32 )
+    #define heapALIGNMENT_LOG2    5
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapALIGNMENT_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapALIGNMENT_LOG2    3
+#elif ( portBYTE_ALIGNMENT == 4 )
+    #define heapALIGNMENT_LOG2    2
+#else
+    #error heap_6.c requires portBYTE_ALIGNMENT to be 4, 8, 16 or 32
+#endif
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all go in first level list 0, one
+ * second level list per portBYTE_ALIGNMENT step.  Above it the first level
+ * index is the position of the most significant bit. */
+#define heapFL_INDEX_SHIFT      ( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE    ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+#define heapFL_INDEX_COUNT      ( configTLSF_FL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+
+#if ( ( heapFL_INDEX_COUNT < 1 ) || ( heapFL_INDEX_COUNT > 32 ) || ( configTLSF_FL_INDEX_MAX > 31 ) )
+    #error configTLSF_FL_INDEX_MAX is out of range for the configured alignment and configTLSF_SL_INDEX_COUNT
+#endif
+
+/* The largest block the size classes can hold. */
+#define heapMAX_BLOCK_SIZE    ( ( ( size_t ) 1 << configTLSF_FL_INDEX_MAX ) - ( size_t ) portBYTE_ALIGNMENT )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE     ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX          ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application,
+ * or is the end marker of a region.  When the bit is free the block is still
+ * part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( BlockLink_t * ) ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* Find last set and find first set, on a non-zero value. */
+#if defined( __GNUC__ )
+    #define heapFLS( ulValue )    ( ( UBaseType_t ) ( 31U - ( uint32_t ) __builtin_clz( ulValue ) ) )
+    #define heapFFS( ulValue )    ( ( UBaseType_t ) __builtin_ctz( ulValue ) )
+#else
+    #define heapFLS( ulValue )    prvFls( ulValue )
+    #define heapFFS( ulValue )    prvFls( ( ulValue ) & ( 0U - ( ulValue ) ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Every block starts with the first two members.  Free blocks also use the
+ * second two to link into the list for their size class, and in an allocated
+ * block that space is the start of the application's memory. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPrevPhysBlock; /*<< The block immediately below this one in memory, NULL for the first block of a region. */
+    size_t xBlockSize;                     /*<< The size of the block including this header.  MSB set while allocated. */
+    struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the same size class. */
+    struct A_BLOCK_LINK * pxPrevFreeBlock; /*<< The previous free block in the same size class. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a free block at the head of the list for its size class, or
+ * removes it from that list.
+ */
+static void prvInsertFreeBlock( BlockLink_t * pxBlock );
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock );
+
+/*
+ * Returns a free block of at least xWantedSize bytes, or NULL if there is
+ * none, without taking it off its list.
+ */
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize );
+
+/*
+ * Calculates the first and second level indexes of the size class that holds
+ * blocks of xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFL,
+                              UBaseType_t * puxSL );
+
+#if !defined( __GNUC__ )
+    static UBaseType_t prvFls( uint32_t ulValue );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The part of BlockLink_t that stays in front of an allocated block, rounded
+ * up so the application's memory is correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must be able to hold the whole BlockLink_t. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* One free list per size class, and the bitmaps of the non-empty ones. */
+static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ configTLSF_SL_INDEX_COUNT ];
+static uint32_t ulFLBitmap = 0U;
+static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+
+/* Set once vPortDefineHeapRegions() has added the regions. */
+static BaseType_t xHeapRegionsDefined = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory, the number
+ * of free bytes remaining and the number of free blocks. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    /* The heap must be initialised before the first call to
+     * prvPortMalloc(). */
+    configASSERT( xHeapRegionsDefined );
+
+    vTaskSuspendAll();
+    {
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes, then
+             * rounded up to keep the next block aligned. */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT_MASK;
+
+            if( ( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 ) &&
+                ( ( xWantedSize + xAdditionalRequiredSize ) <= heapMAX_BLOCK_SIZE ) )
+            {
+                xWantedSize = ( xWantedSize + xAdditionalRequiredSize ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+                if( xWantedSize < xMinimumBlockSize )
+                {
+                    xWantedSize = xMinimumBlockSize;
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvFindSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                prvRemoveFreeBlock( pxBlock );
+
+                /* If the block is larger than required the remainder is
+                 * split off and goes back on the free lists. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+                {
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxNewBlockLink->pxPrevPhysBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPrevPhysBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    prvInsertFreeBlock( pxNewBlockLink );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned by
+                 * the application.  Return the memory space pointed to -
+                 * jumping over the header at its start. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have the block header immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxLink );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+
+                /* Merge with the free block above, if any.  The end marker of
+                 * the region is always allocated so this never runs off the
+                 * end of a region. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) &&
+                    ( ( pxLink->xBlockSize + pxNeighbour->xBlockSize ) <= heapMAX_BLOCK_SIZE ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxLink->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the free block below, if any. */
+                pxNeighbour = pxLink->pxPrevPhysBlock;
+
+                if( ( pxNeighbour != NULL ) &&
+                    ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) &&
+                    ( ( pxLink->xBlockSize + pxNeighbour->xBlockSize ) <= heapMAX_BLOCK_SIZE ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxLink->xBlockSize;
+                    pxLink = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPrevPhysBlock = pxLink;
+                prvInsertFreeBlock( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFL,
+                              UBaseType_t * puxSL )
+{
+    UBaseType_t uxFL, uxSL;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        uxFL = 0;
+        uxSL = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* xBlockSize never exceeds heapMAX_BLOCK_SIZE, so fits in 32 bits. */
+        uxFL = heapFLS( ( uint32_t ) xBlockSize );
+        uxSL = ( UBaseType_t ) ( xBlockSize >> ( uxFL - heapSL_INDEX_COUNT_LOG2 ) ) ^ ( ( UBaseType_t ) 1 << heapSL_INDEX_COUNT_LOG2 );
+        uxFL -= ( heapFL_INDEX_SHIFT - 1 );
+    }
+
+    *puxFL = uxFL;
+    *puxSL = uxSL;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize )
+{
+    UBaseType_t uxFL, uxSL;
+    uint32_t ulMap;
+    BlockLink_t * pxReturn = NULL;
+
+    /* The head of the request's own size class is checked first.  It may be
+     * large enough, and taking it leaves the larger blocks unsplit. */
+    prvMappingInsert( xWantedSize, &uxFL, &uxSL );
+    pxReturn = pxFreeLists[ uxFL ][ uxSL ];
+
+    if( ( pxReturn != NULL ) && ( pxReturn->xBlockSize >= xWantedSize ) )
+    {
+        return pxReturn;
+    }
+    else
+    {
+        pxReturn = NULL;
+    }
+
+    /* Otherwise round the size up to the start of the next size class, so
+     * that any block on the list found is large enough without searching
+     * it. */
+    if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xWantedSize += ( ( size_t ) 1 << ( heapFLS( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xWantedSize, &uxFL, &uxSL );
+
+    if( uxFL < ( UBaseType_t ) heapFL_INDEX_COUNT )
+    {
+        /* A non-empty list in the same power of two at or above the second
+         * level index... */
+        ulMap = ulSLBitmap[ uxFL ] & ( ~0UL << uxSL );
+
+        if( ulMap == 0U )
+        {
+            /* ...otherwise the smallest non-empty list in a higher power of
+             * two. */
+            ulMap = ( uxFL + 1U < 32U ) ? ( ulFLBitmap & ( ~0UL << ( uxFL + 1U ) ) ) : 0U;
+
+            if( ulMap != 0U )
+            {
+                uxFL = heapFFS( ulMap );
+                ulMap = ulSLBitmap[ uxFL ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulMap != 0U )
+        {
+            uxSL = heapFFS( ulMap );
+            pxReturn = pxFreeLists[ uxFL ][ uxSL ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFL, uxSL;
+    BlockLink_t * pxHead;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFL, &uxSL );
+
+    pxHead = pxFreeLists[ uxFL ][ uxSL ];
+    pxBlock->pxNextFreeBlock = pxHead;
+    pxBlock->pxPrevFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFL ][ uxSL ] = pxBlock;
+    ulFLBitmap |= ( 1UL << uxFL );
+    ulSLBitmap[ uxFL ] |= ( 1UL << uxSL );
+    xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFL, uxSL;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFL, &uxSL );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was the head of its list. */
+        configASSERT( pxFreeLists[ uxFL ][ uxSL ] == pxBlock );
+        pxFreeLists[ uxFL ][ uxSL ] = pxBlock->pxNextFreeBlock;
+
+        if( pxFreeLists[ uxFL ][ uxSL ] == NULL )
+        {
+            ulSLBitmap[ uxFL ] &= ~( 1UL << uxSL );
+
+            if( ulSLBitmap[ uxFL ] == 0U )
+            {
+                ulFLBitmap &= ~( 1UL << uxFL );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+#if !defined( __GNUC__ )
+
+    static UBaseType_t prvFls( uint32_t ulValue )
+    {
+        UBaseType_t uxBit = 0;
+
+        while( ulValue > 1U )
+        {
+            ulValue >>= 1;
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+
+#endif /* __GNUC__ */
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxEnd = NULL;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize, xBlockSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapRegionsDefined == pdFALSE );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* Check blocks are passed in with increasing start addresses. */
+        configASSERT( ( pxEnd == NULL ) || ( xAddress > ( portPOINTER_SIZE_TYPE ) pxEnd ) );
+
+        /* The region ends with a permanently allocated, zero sized block that
+         * stops vPortFree() merging past the end of the region. */
+        xAddress = xAlignedHeap + xTotalRegionSize;
+        xAddress -= xHeapStructSize;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        if( xAddress >= ( xAlignedHeap + xMinimumBlockSize ) )
+        {
+            pxEnd = ( BlockLink_t * ) xAddress;
+            xTotalRegionSize = ( size_t ) ( xAddress - xAlignedHeap );
+
+            /* The rest of the region becomes free blocks, as few as the largest
+             * size class allows.  None is left smaller than a header. */
+            pxPreviousBlock = NULL;
+            pxBlock = ( BlockLink_t * ) xAlignedHeap;
+
+            while( xTotalRegionSize > 0 )
+            {
+                xBlockSize = xTotalRegionSize;
+
+                if( xBlockSize > heapMAX_BLOCK_SIZE )
+                {
+                    xBlockSize = heapMAX_BLOCK_SIZE;
+
+                    if( ( xTotalRegionSize - xBlockSize ) < xMinimumBlockSize )
+                    {
+                        xBlockSize -= xMinimumBlockSize;
+                    }
+                }
+
+                pxBlock->pxPrevPhysBlock = pxPreviousBlock;
+                pxBlock->xBlockSize = xBlockSize;
+                prvInsertFreeBlock( pxBlock );
+
+                xTotalHeapSize += xBlockSize;
+                xTotalRegionSize -= xBlockSize;
+                pxPreviousBlock = pxBlock;
+                pxBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+            }
+
+            pxEnd->pxPrevPhysBlock = pxPreviousBlock;
+            pxEnd->xBlockSize = 0;
+            heapALLOCATE_BLOCK( pxEnd );
+        }
+        else
+        {
+            /* Too small to hold a block. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+    xHeapRegionsDefined = pdTRUE;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFL, uxSL;
+    size_t xBlocks, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        xBlocks = xNumberOfFreeBlocks;
+
+        /* The largest free block is on the highest non-empty list and the
+         * smallest on the lowest, so only those two lists are walked. */
+        if( ulFLBitmap != 0U )
+        {
+            uxFL = heapFLS( ulFLBitmap );
+            uxSL = heapFLS( ulSLBitmap[ uxFL ] );
+
+            for( pxBlock = pxFreeLists[ uxFL ][ uxSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+            }
+
+            uxFL = heapFFS( ulFLBitmap );
+            uxSL = heapFFS( ulSLBitmap[ uxFL ] );
+
+            for( pxBlock = pxFreeLists[ uxFL ][ uxSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
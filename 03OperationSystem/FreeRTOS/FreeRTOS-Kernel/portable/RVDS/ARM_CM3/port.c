@@ -68,6 +68,13 @@
 #define portNVIC_PENDSV_PRI                   ( ( ( uint32_t ) configKERNEL_INTERRUPT_PRIORITY ) << 16UL )
 #define portNVIC_SYSTICK_PRI                  ( ( ( uint32_t ) configKERNEL_INTERRUPT_PRIORITY ) << 24UL )
 
+/* Constants required to run the DWT cycle counter. */
+#define portDEMCR_REG                         ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDWT_CTRL_REG                      ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDWT_CYCCNT_REG                    ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portDEMCR_TRCENA_BIT                  ( 1UL << 24UL )
+#define portDWT_CYCCNTENA_BIT                 ( 1UL << 0UL )
+
 /* Constants required to check the validity of an interrupt priority. */
 #define portFIRST_USER_INTERRUPT_NUMBER       ( 16 )
 #define portNVIC_IP_REGISTERS_OFFSET_16       ( 0xE000E3F0 )
@@ -161,6 +168,15 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
     static uint32_t ulStoppedTimerCompensation = 0;
 #endif /* configUSE_TICKLESS_IDLE */
 
+/*
+ * The DWT cycle counter is 32 bits wide and wraps in under a minute at typical
+ * clock rates, so the run time counter keeps the upper 32 bits in software.
+ */
+#if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+    static uint32_t ulCycleCountWraps = 0;
+    static uint32_t ulLastCycleCount = 0;
+#endif /* configUSE_DWT_RUN_TIME_COUNTER */
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -435,20 +451,81 @@ void xPortSysTickHandler( void )
      * known - therefore the slightly faster vPortRaiseBASEPRI() function is used
      * in place of portSET_INTERRUPT_MASK_FROM_ISR(). */
     vPortRaiseBASEPRI();
+    traceISR_ENTER();
+    taskRUN_TIME_ISR_ENTER();
     {
+        #if ( ( configUSE_DWT_RUN_TIME_COUNTER == 1 ) && ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 0 ) )
+        {
+            /* Read the cycle counter at least once per wrap so the upper
+             * 32 bits are kept up to date. */
+            ( void ) ullPortGetRunTimeCounterValue();
+        }
+        #endif
+
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
+            taskRUN_TIME_ISR_EXIT();
+            traceISR_EXIT_TO_SCHEDULER();
+
             /* A context switch is required.  Context switching is performed in
              * the PendSV interrupt.  Pend the PendSV interrupt. */
             portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
         }
+        else
+        {
+            taskRUN_TIME_ISR_EXIT();
+            traceISR_EXIT();
+        }
     }
 
     vPortClearBASEPRIFromISR();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+
+    void vPortConfigureRunTimeCounter( void )
+    {
+        /* The counter is not reset, so timestamps already taken from it by a
+         * debugger or trace recorder stay valid. */
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;
+        portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;
+        ulLastCycleCount = portDWT_CYCCNT_REG;
+    }
+
+#endif /* configUSE_DWT_RUN_TIME_COUNTER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+
+    uint64_t ullPortGetRunTimeCounterValue( void )
+    {
+        uint32_t ulCycleCount, ulSavedInterruptStatus;
+        uint64_t ullReturn;
+
+        /* The tick interrupt calls this at least once per wrap, so a count
+         * lower than the previous one means exactly one wrap. */
+        ulSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ulCycleCount = portDWT_CYCCNT_REG;
+
+            if( ulCycleCount < ulLastCycleCount )
+            {
+                ulCycleCountWraps++;
+            }
+
+            ulLastCycleCount = ulCycleCount;
+            ullReturn = ( ( uint64_t ) ulCycleCountWraps << 32 ) | ( uint64_t ) ulCycleCount;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( ulSavedInterruptStatus );
+
+        return ullReturn;
+    }
+
+#endif /* configUSE_DWT_RUN_TIME_COUNTER */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE == 1 )
 
     __weak void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
@@ -0,0 +1,241 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef PORTMACRO_H
+    #define PORTMACRO_H
+
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+
+    #include <limits.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+    #define portCHAR                 char
+    #define portFLOAT                float
+    #define portDOUBLE               double
+    #define portLONG                 long
+    #define portSHORT                short
+    #define portSTACK_TYPE           unsigned long
+    #define portBASE_TYPE            long
+    #define portPOINTER_SIZE_TYPE    size_t
+
+    typedef portSTACK_TYPE   StackType_t;
+    typedef long             BaseType_t;
+    typedef unsigned long    UBaseType_t;
+
+    #if ( configUSE_16_BIT_TICKS == 1 )
+        typedef uint16_t     TickType_t;
+        #define portMAX_DELAY              ( TickType_t ) 0xffff
+    #else
+        typedef unsigned long TickType_t;
+        #define portMAX_DELAY              ( TickType_t ) ULONG_MAX
+
+/* Word-sized tick type on a word-sized architecture, so reads of the tick
+ * count do not need to be guarded with a critical section. */
+        #define portTICK_TYPE_IS_ATOMIC    1
+    #endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+    #define portSTACK_GROWTH                   ( -1 )
+    #define portHAS_STACK_OVERFLOW_CHECKING    ( 1 )
+    #define portTICK_PERIOD_MS                 ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+    #define portTICK_RATE_MICROSECONDS         ( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+    #define portBYTE_ALIGNMENT                 8
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations. */
+    #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+        #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
+    #endif
+
+    #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+/* Generic helper function. */
+        __attribute__( ( always_inline ) ) static inline uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
+        {
+            return ( uint8_t ) __builtin_clz( ulBitmap );
+        }
+
+/* Check the configuration. */
+        #if ( configMAX_PRIORITIES > 1024 )
+            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
+        #endif
+
+        #if ( configMAX_PRIORITIES <= 32 )
+
+/* Store/clear the ready priorities in a bit map. */
+            #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+            #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+/*-----------------------------------------------------------*/
+
+            #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+        #else /* configMAX_PRIORITIES */
+
+/* Above 32 priorities the ready priorities are kept in a two level bit map.
+ * Bit n of ulGroups is set while ulPriorities[ n ] is not zero, so the
+ * highest ready priority is found with two CLZ instructions however many
+ * priorities are in use. */
+            typedef struct xPORT_READY_PRIORITIES
+            {
+                uint32_t ulGroups;
+                uint32_t ulPriorities[ ( configMAX_PRIORITIES + 31 ) / 32 ];
+            } PortReadyPriorities_t;
+
+            #define portREADY_PRIORITIES_TYPE    PortReadyPriorities_t
+
+/* Store/clear the ready priorities in the bit map. */
+            #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )                                     \
+            {                                                                                                      \
+                ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31UL ) ); \
+                ( uxReadyPriorities ).ulGroups |= ( 1UL << ( ( uxPriority ) >> 5 ) );                              \
+            }
+
+            #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )                                       \
+            {                                                                                                       \
+                ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) ); \
+                                                                                                                    \
+                if( ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] == 0UL )                              \
+                {                                                                                                   \
+                    ( uxReadyPriorities ).ulGroups &= ~( 1UL << ( ( uxPriority ) >> 5 ) );                          \
+                }                                                                                                   \
+            }
+
+/*-----------------------------------------------------------*/
+
+            #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )                                                                           \
+            {                                                                                                                                              \
+                uint32_t ulTopGroup = 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ).ulGroups );                                       \
+                                                                                                                                                           \
+                uxTopPriority = ( ulTopGroup << 5 ) + ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ).ulPriorities[ ulTopGroup ] ) ); \
+            }
+
+/* The highest bit set in one word of the bit map, which the index of event
+ * lists also uses. */
+            #define portGET_HIGHEST_SET_BIT( uxBit, ulBitmap )    uxBit = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( ulBitmap ) ) )
+
+/* The idle priority is bit 0 of the first word. */
+            #define portHAS_READY_PRIORITY_ABOVE_IDLE( uxReadyPriorities )    ( ( ( uxReadyPriorities ).ulGroups > 1UL ) || ( ( uxReadyPriorities ).ulPriorities[ 0 ] > 1UL ) )
+
+        #endif /* configMAX_PRIORITIES */
+
+    #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+    extern void vPortYield( void );
+
+    #define portYIELD()                                 vPortYield()
+    #define portEND_SWITCHING_ISR( xSwitchRequired )    do { if( xSwitchRequired != pdFALSE ) vPortYield(); } while( 0 )
+    #define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Only one task thread is ever runnable at a
+ * time, and the only asynchronous "interrupt" is the tick signal, so masking
+ * signals in the running thread acts as the single global kernel lock. */
+    extern void vPortDisableInterrupts( void );
+    extern void vPortEnableInterrupts( void );
+    extern BaseType_t xPortSetInterruptMask( void );
+    extern void vPortClearInterruptMask( BaseType_t xMask );
+    extern void vPortEnterCritical( void );
+    extern void vPortExitCritical( void );
+
+    #define portSET_INTERRUPT_MASK_FROM_ISR()         xPortSetInterruptMask()
+    #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
+    #define portDISABLE_INTERRUPTS()                  vPortDisableInterrupts()
+    #define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
+    #define portENTER_CRITICAL()                      vPortEnterCritical()
+    #define portEXIT_CRITICAL()                       vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Each task runs on its own pthread, which has to be torn down when the task
+ * is deleted. */
+    extern void vPortThreadDying( void * pxTaskToDelete,
+                                  volatile BaseType_t * pxPendYield );
+    extern void vPortCancelThread( void * pxTaskToDelete );
+
+    #define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield )    vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
+    #define portCLEAN_UP_TCB( pxTCB )                                  vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+ * not necessary for to use this port.  They are defined so the common demo files
+ * (which build with all the ports) will build. */
+    #define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
+    #define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
+/*-----------------------------------------------------------*/
+
+    #define portNOP()
+    #define portMEMORY_BARRIER()    __sync_synchronize()
+
+/* Compare and swap through the C11 memory model builtins, which the host
+ * compiler lowers to its native atomic instruction. */
+    __attribute__( ( always_inline ) ) static inline BaseType_t xPortCompareAndSwapPointer( void * volatile * ppvDestination,
+                                                                                            void * pvExchange,
+                                                                                            void * pvComparand )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( __atomic_compare_exchange_n( ppvDestination, &pvComparand, pvExchange, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+        {
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+
+    #define portCOMPARE_AND_SWAP_POINTER( ppvDestination, pvExchange, pvComparand )    xPortCompareAndSwapPointer( ( ppvDestination ), ( pvExchange ), ( pvComparand ) )
+
+/* The host has no cheap way to sleep until the next tick from the idle task,
+ * so tickless idle is not supported. */
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+/*-----------------------------------------------------------*/
+
+/* Run time stats use the host monotonic clock, in nanoseconds. */
+    extern unsigned long ulPortGetRunTime( void );
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
+    #define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
+
+    #ifdef __cplusplus
+        }
+    #endif
+
+#endif /* PORTMACRO_H */
@@ -42,6 +42,10 @@
     #include "croutine.h"
 #endif
 
+#if ( configUSE_WAITERS == 1 )
+    #include "waiter.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -76,6 +80,11 @@ typedef struct SemaphoreData
 {
     TaskHandle_t xMutexHolder;        /*< The handle of the task that holds the mutex. */
     UBaseType_t uxRecursiveCallCount; /*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxCeilingPriority;       /*< The priority the holder is raised to when it takes the mutex, or 0 for a priority inheritance mutex. */
+        UBaseType_t uxPriorityBeforeCeiling; /*< The priority the holder ran at before it was raised to the ceiling. */
+    #endif
 } SemaphoreData_t;
 
 /* Semaphores do not actually store or copy data, so have an item size of
@@ -83,6 +92,41 @@ typedef struct SemaphoreData
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/* With the mutex fast path xMutexHolder is the lock word itself.  It is NULL
+ * while the mutex is free and holds the owner's handle while it is taken, so an
+ * uncontended take and give are each a single compare and swap.  Bit 0, which a
+ * TCB address never has set, tells the owner that tasks may be waiting, which
+ * makes its compare and swap fail and sends the give down the slow path.
+ * uxMessagesWaiting is not used by such a mutex. */
+    #define queueMUTEX_WAITERS                 ( ( portPOINTER_SIZE_TYPE ) 1U )
+    #define queueMUTEX_HOLDER( pxQueue )       ( ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) ( pxQueue )->u.xSemaphore.xMutexHolder & ~queueMUTEX_WAITERS ) )
+    #define queueMUTEX_LOCK_WORD( pxQueue )    ( ( void * volatile * ) &( ( pxQueue )->u.xSemaphore.xMutexHolder ) )
+
+/* The item count the API reports, in which a free mutex counts as one item. */
+    #define queueMESSAGES_WAITING( pxQueue )    prvMessagesWaiting( pxQueue )
+#else
+    #define queueMUTEX_HOLDER( pxQueue )        ( ( pxQueue )->u.xSemaphore.xMutexHolder )
+    #define queueMESSAGES_WAITING( pxQueue )    ( ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+/* A mutex created with a ceiling raises its holder to the ceiling as soon as
+ * it is taken instead of inheriting the priority of the tasks that block on
+ * it, see prvRaiseToCeiling(). */
+    #define queueMUTEX_HAS_CEILING( pxQueue )    ( ( pxQueue )->u.xSemaphore.uxCeilingPriority != ( UBaseType_t ) 0 )
+    #define queueMUTEX_TAKEN( pxQueue )          prvRaiseToCeiling( pxQueue )
+    #define queueMUTEX_INHERIT( pxQueue )        prvMutexInherit( pxQueue )
+    #define queueMUTEX_DISINHERIT( pxQueue )     prvMutexDisinherit( pxQueue )
+#else
+    #define queueMUTEX_HAS_CEILING( pxQueue )    ( pdFALSE )
+    #define queueMUTEX_TAKEN( pxQueue )
+    #define queueMUTEX_INHERIT( pxQueue )        xTaskPriorityInherit( queueMUTEX_HOLDER( pxQueue ) )
+    #define queueMUTEX_DISINHERIT( pxQueue )     xTaskPriorityDisinherit( queueMUTEX_HOLDER( pxQueue ) )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -92,6 +136,21 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* Bits used in the ucZeroCopyState member of a queue. */
+    #define queueZERO_COPY_RESERVED      ( ( uint8_t ) 0x01U )
+    #define queueZERO_COPY_REFERENCED    ( ( uint8_t ) 0x02U )
+
+/* A slot handed out by xQueueReserve() or xQueuePeekRef() is still in use, so
+ * whether an item can be written depends on more than the item count. */
+    #define queueHAS_SPACE( pxQueue, xCopyPosition )    prvQueueHasSpace( ( pxQueue ), ( xCopyPosition ) )
+    #define queueFREE_SLOTS( pxQueue )                  prvQueueFreeSlots( pxQueue )
+#else
+    #define queueHAS_SPACE( pxQueue, xCopyPosition )    ( ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) || ( ( xCopyPosition ) == queueOVERWRITE ) ) ? pdTRUE : pdFALSE )
+    #define queueFREE_SLOTS( pxQueue )                  ( ( pxQueue )->uxLength - ( pxQueue )->uxMessagesWaiting )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -108,8 +167,8 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
     } u;
 
-    List_t xTasksWaitingToSend;             /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
-    List_t xTasksWaitingToReceive;          /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
+    EventList_t xTasksWaitingToSend;        /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
+    EventList_t xTasksWaitingToReceive;     /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
 
     volatile UBaseType_t uxMessagesWaiting; /*< The number of items currently in the queue. */
     UBaseType_t uxLength;                   /*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
@@ -118,6 +177,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     volatile int8_t cRxLock;                /*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
     volatile int8_t cTxLock;                /*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucZeroCopyState; /*< queueZERO_COPY_RESERVED while a slot handed out by xQueueReserve() is waiting for xQueueCommit(), queueZERO_COPY_REFERENCED while an item handed out by xQueuePeekRef() is waiting for xQueueRelease(). */
+        int8_t * pcReferenced;   /*< The slot handed out by xQueuePeekRef() while queueZERO_COPY_REFERENCED is set. */
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
     #endif
@@ -126,6 +190,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         struct QueueDefinition * pxQueueSetContainer;
     #endif
 
+    #if ( configUSE_WAITERS == 1 )
+        struct WaiterDef_t * pxWaiter; /*< The waiter the queue was added to, or NULL. */
+        uint32_t ulWaiterBits;         /*< The ready bits the queue sets in pxWaiter when an item is written to it. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
@@ -183,11 +252,53 @@ static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any space in a queue.
+ * Uses a critical section to determine if there is any space in a queue for
+ * an item written to xCopyPosition.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Determine if an item can be written to xCopyPosition now, taking into account
+ * any reserved slot or referenced item.  Must be called from a critical
+ * section.
+ */
+    static BaseType_t prvQueueHasSpace( const Queue_t * pxQueue,
+                                        const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of items that can be written to the back of the queue before
+ * pcWriteTo reaches a reserved slot or the referenced slot.  Must be called from
+ * a critical section.
+ */
+    static UBaseType_t prvQueueFreeSlots( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make the reserved slot at pcWriteTo the newest item in the queue.
+ */
+    static void prvCommitReservedItem( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take the oldest item out of the queue, leaving its slot in use until
+ * xQueueRelease() is called, and return a pointer to it.
+ */
+    static void * prvReferenceOldestItem( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks that can proceed now a reserved slot has been committed
+ * (xItemAdded is pdTRUE) or a referenced slot released.  Must be called from a
+ * critical section, and respects the queue lock when called from an ISR.
+ *
+ * @return pdTRUE if a task with a higher priority than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvNotifyZeroCopyWaiters( Queue_t * const pxQueue,
+                                                const BaseType_t xItemAdded ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -203,6 +314,35 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+/*
+ * Copies uxCount items to the back of the queue, or out of the front of it,
+ * with at most two memcpy() calls around the end of the storage area.  The
+ * caller must have checked there is enough space or data.
+ */
+    static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                     const uint8_t * pucItems,
+                                     const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+    static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                       uint8_t * pucBuffer,
+                                       const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxCount tasks waiting to receive from (or send to) the queue
+ * after uxCount items were added to (or removed from) it in one batch.  Must
+ * be called from a critical section, and respects the queue lock when called
+ * from an ISR.
+ *
+ * @return pdTRUE if a task with a higher priority than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvUnblockBatchReceivers( Queue_t * const pxQueue,
+                                                UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvUnblockBatchSenders( Queue_t * const pxQueue,
+                                              UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -242,6 +382,35 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/*
+ * Take and give a mutex with a compare and swap on its lock word, entering a
+ * critical section only when the mutex is taken or tasks are waiting for it.
+ */
+    static BaseType_t prvMutexTake( Queue_t * const pxQueue,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvMutexGive( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * uxMessagesWaiting, or for a mutex 1 if it is free and 0 if it is held, as a
+ * mutex taken and given through its lock word leaves uxMessagesWaiting at 0.
+ */
+    static UBaseType_t prvMessagesWaiting( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+/*
+ * Priority changes of the mutex holder, through the ceiling if the mutex has
+ * one and through priority inheritance otherwise.  Called from a critical
+ * section.
+ */
+    static void prvRaiseToCeiling( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvMutexInherit( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvMutexDisinherit( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -315,6 +484,14 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                /* Outstanding reservations and references are discarded. */
+                pxQueue->ucZeroCopyState = ( uint8_t ) 0U;
+                pxQueue->pcReferenced = NULL;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -322,9 +499,9 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                  * will still be empty.  If there are tasks blocked waiting to write to
                  * the queue, then one should be unblocked as after this function exits
                  * it will be possible to write to it. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -341,8 +518,8 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             else
             {
                 /* Ensure the event queues start in the correct state. */
-                vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
-                vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+                vTaskEventListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+                vTaskEventListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
             }
         }
         taskEXIT_CRITICAL();
@@ -533,6 +710,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_WAITERS == 1 )
+    {
+        pxNewQueue->pxWaiter = NULL;
+        pxNewQueue->ulWaiterBits = 0U;
+    }
+    #endif /* configUSE_WAITERS */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -553,10 +737,26 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+            {
+                pxNewQueue->u.xSemaphore.uxCeilingPriority = ( UBaseType_t ) 0;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
-            /* Start with the semaphore in the expected state. */
-            ( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+            /* Start with the semaphore in the expected state.  A NULL lock
+             * word already means the mutex is free. */
+            #if ( configUSE_MUTEX_FAST_PATH == 0 )
+            {
+                ( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+            }
+            #else
+            {
+                /* Traced as the give above would be. */
+                traceGIVE_MUTEX( pxNewQueue );
+            }
+            #endif
         }
         else
         {
@@ -604,6 +804,58 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        /* A ceiling at the idle priority would never raise anything. */
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -622,7 +874,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
         {
             if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
             {
-                pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+                pxReturn = queueMUTEX_HOLDER( pxSemaphore );
             }
             else
             {
@@ -650,7 +902,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
          * not required here. */
         if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
         {
-            pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+            pxReturn = queueMUTEX_HOLDER( ( Queue_t * ) xSemaphore );
         }
         else
         {
@@ -678,7 +930,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
          * this is the only condition we are interested in it does not matter if
          * pxMutexHolder is accessed simultaneously by another task.  Therefore no
          * mutual exclusion is required to test the pxMutexHolder variable. */
-        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+        if( queueMUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
         {
             traceGIVE_MUTEX_RECURSIVE( pxMutex );
 
@@ -733,7 +985,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 
         traceTAKE_MUTEX_RECURSIVE( pxMutex );
 
-        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+        if( queueMUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
         {
             ( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
             xReturn = pdPASS;
@@ -850,6 +1102,16 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        /* Giving a mutex never blocks. */
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            return prvMutexGive( pxQueue );
+        }
+    }
+    #endif
+
     /*lint -save -e904 This function relaxes the coding standard somewhat to
      * allow return statements within the function itself.  This is done in the
      * interest of execution time efficiency. */
@@ -861,7 +1123,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( queueHAS_SPACE( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -896,9 +1158,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     {
                         /* If there was a task waiting for data to arrive on the
                          * queue then unblock it now. */
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                             {
                                 /* The unblocked task has a priority higher than
                                  * our own so yield immediately.  Yes it is ok to
@@ -931,9 +1193,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     /* If there was a task waiting for data to arrive on the
                      * queue then unblock it now. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                         {
                             /* The unblocked task has a priority higher than
                              * our own so yield immediately.  Yes it is ok to do
@@ -961,6 +1223,19 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_QUEUE_SETS */
 
+                #if ( configUSE_WAITERS == 1 )
+                {
+                    if( pxQueue->pxWaiter != NULL )
+                    {
+                        vWaiterNotify( pxQueue->pxWaiter, pxQueue->ulWaiterBits );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_WAITERS */
+
                 taskEXIT_CRITICAL();
                 return pdPASS;
             }
@@ -1002,10 +1277,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend.xList ), xTicksToWait );
 
                 /* Unlocking the queue means queue events can effect the
                  * event list. It is possible that interrupts occurring now
@@ -1080,7 +1355,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * post). */
     uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( queueHAS_SPACE( pxQueue, xCopyPosition ) != pdFALSE )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1130,9 +1405,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1158,9 +1433,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1195,6 +1470,21 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
 
+            /* The waiter's task is woken straight away even if the queue is
+             * locked, as that does not touch the queue's event lists. */
+            #if ( configUSE_WAITERS == 1 )
+            {
+                if( pxQueue->pxWaiter != NULL )
+                {
+                    vWaiterNotifyFromISR( pxQueue->pxWaiter, pxQueue->ulWaiterBits, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_WAITERS */
+
             xReturn = pdPASS;
         }
         else
@@ -1231,7 +1521,18 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
     /* Normally a mutex would not be given from an interrupt, especially if
      * there is a mutex holder, as priority inheritance makes no sense for an
      * interrupts, only tasks. */
-    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        /* A free mutex also has a NULL holder, so no mutex can be given here,
+         * as the give would count in uxMessagesWaiting, which the lock word
+         * does not use. */
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+    }
+    #else
+    {
+        configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+    }
+    #endif
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1299,9 +1600,9 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1327,9 +1628,9 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1361,6 +1662,21 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
 
+            /* The waiter's task is woken straight away even if the queue is
+             * locked, as that does not touch the queue's event lists. */
+            #if ( configUSE_WAITERS == 1 )
+            {
+                if( pxQueue->pxWaiter != NULL )
+                {
+                    vWaiterNotifyFromISR( pxQueue->pxWaiter, pxQueue->ulWaiterBits, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_WAITERS */
+
             xReturn = pdPASS;
         }
         else
@@ -1418,9 +1734,9 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 /* There is now space in the queue, were any tasks waiting to
                  * post to the queue?  If so, unblock the highest priority waiting
                  * task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -1477,7 +1793,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1543,6 +1859,15 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            return prvMutexTake( pxQueue, xTicksToWait );
+        }
+    }
+    #endif
+
     /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
      * statements within the function itself.  This is done in the interest
      * of execution time efficiency. */
@@ -1571,6 +1896,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                        queueMUTEX_TAKEN( pxQueue );
                     }
                     else
                     {
@@ -1581,9 +1907,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 /* Check to see if other tasks are blocked waiting to give the
                  * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -1649,7 +1975,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                     {
                         taskENTER_CRITICAL();
                         {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            xInheritanceOccurred = queueMUTEX_INHERIT( pxQueue );
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1660,7 +1986,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1777,9 +2103,9 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than this task. */
                         queueYIELD_IF_USING_PREEMPTION();
@@ -1838,7 +2164,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1926,9 +2252,9 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
              * locked. */
             if( cRxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than us so
                          * force a context switch. */
@@ -2027,149 +2353,1439 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    configASSERT( xQueue );
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    taskENTER_CRITICAL();
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no storage to reserve. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Blocks exactly as xQueueSend() does.  While one slot is
+                 * reserved the queue is full to every other writer, as an item
+                 * written behind the reserved slot would be received first. */
+                if( queueHAS_SPACE( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+                {
+                    pxQueue->ucZeroCopyState |= queueZERO_COPY_RESERVED;
+                    *ppvItem = ( void * ) pxQueue->pcWriteTo;
 
-    configASSERT( pxQueue );
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend.xList ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return errQUEUE_FULL;
+            }
+        } /*lint -restore */
     }
-    taskEXIT_CRITICAL();
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+#endif /* configUSE_QUEUE_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+    BaseType_t xQueueReserveFromISR( QueueHandle_t xQueue,
+                                     void ** const ppvItem )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+        /* See the comment on interrupt priorities in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( queueHAS_SPACE( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+            {
+                pxQueue->ucZeroCopyState |= queueZERO_COPY_RESERVED;
+                *ppvItem = ( void * ) pxQueue->pcWriteTo;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-    {
-        vQueueUnregisterQueue( pxQueue );
+        return xReturn;
     }
-    #endif
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueCommit( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RESERVED ) != 0U );
+
+            traceQUEUE_SEND( pxQueue );
+            prvCommitReservedItem( pxQueue );
+
+            if( prvNotifyZeroCopyWaiters( pxQueue, pdTRUE ) != pdFALSE )
+            {
+                /* Yes it is ok to do this from within the critical section -
+                 * the kernel takes care of that. */
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RESERVED ) != 0U );
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            prvCommitReservedItem( pxQueue );
+
+            if( ( prvNotifyZeroCopyWaiters( pxQueue, pdTRUE ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueuePeekRef( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores have no items to reference. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Blocks exactly as xQueueReceive() does. */
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_RECEIVE( pxQueue );
+                    *ppvItem = prvReferenceOldestItem( pxQueue );
+
+                    /* The item's slot does not become free until the item is
+                     * released, so there is nothing to unblock yet. */
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueuePeekRefFromISR( QueueHandle_t xQueue,
+                                     void ** const ppvItem )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+                *ppvItem = prvReferenceOldestItem( pxQueue );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+                xReturn = pdFAIL;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueRelease( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_REFERENCED ) != 0U );
+
+            pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_REFERENCED;
+            pxQueue->pcReferenced = NULL;
+
+            if( prvNotifyZeroCopyWaiters( pxQueue, pdFALSE ) != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_REFERENCED ) != 0U );
+
+            pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_REFERENCED;
+            pxQueue->pcReferenced = NULL;
+
+            if( ( prvNotifyZeroCopyWaiters( pxQueue, pdFALSE ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+    UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                    const void * const pvItems,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxSent = 0, uxCount;
+        Queue_t * const pxQueue = xQueue;
+        const uint8_t * const pucItems = ( const uint8_t * ) pvItems;
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores and mutexes are given one at a time. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Copy as many of the remaining items as there is space for,
+                 * then wake the receivers once for the whole batch. */
+                uxCount = configMIN( queueFREE_SLOTS( pxQueue ), uxItemCount - uxSent );
+
+                if( uxCount > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_SEND_MULTIPLE( pxQueue, uxCount );
+                    prvCopyItemsToQueue( pxQueue, &( pucItems[ uxSent * pxQueue->uxItemSize ] ), uxCount );
+                    uxSent += uxCount;
+
+                    if( prvUnblockBatchReceivers( pxQueue, uxCount ) != pdFALSE )
+                    {
+                        /* Yes it is ok to do this from within the critical
+                         * section - the kernel takes care of that. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( uxSent == uxItemCount )
+                {
+                    taskEXIT_CRITICAL();
+                    return uxSent;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue is full and no block time is specified (or the
+                     * block time has expired), so return what was sent. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return uxSent;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend.xList ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return uxSent;
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+    UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                           const void * const pvItems,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxCount;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comment on interrupt priorities in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            uxCount = configMIN( queueFREE_SLOTS( pxQueue ), uxItemCount );
+
+            if( uxCount > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxCount );
+                prvCopyItemsToQueue( pxQueue, ( const uint8_t * ) pvItems, uxCount );
+
+                if( ( prvUnblockBatchReceivers( pxQueue, uxCount ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxCount;
+    }
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+    UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                       void * const pvBuffer,
+                                       const UBaseType_t uxMaxItems,
+                                       TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxCount;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( uxMaxItems != ( UBaseType_t ) 0U );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Take everything that is there, up to uxMaxItems, as soon as
+                 * there is anything at all. */
+                uxCount = configMIN( pxQueue->uxMessagesWaiting, uxMaxItems );
+
+                if( uxCount > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxCount );
+                    prvCopyItemsFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxCount );
+
+                    if( prvUnblockBatchSenders( pxQueue, uxCount ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return uxCount;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        return ( UBaseType_t ) 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and read
+                     * the data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+    UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                              void * const pvBuffer,
+                                              const UBaseType_t uxMaxItems,
+                                              BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxCount;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( uxMaxItems != ( UBaseType_t ) 0U );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comment on interrupt priorities in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            uxCount = configMIN( pxQueue->uxMessagesWaiting, uxMaxItems );
+
+            if( uxCount > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxCount );
+                prvCopyItemsFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxCount );
+
+                if( ( prvUnblockBatchSenders( pxQueue, uxCount ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxCount;
+    }
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = queueMESSAGES_WAITING( ( Queue_t * ) xQueue );
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        {
+            /* Slots at and beyond a reserved or referenced slot cannot be
+             * written.  Semaphores have no slots to reserve or reference. */
+            if( pxQueue->uxItemSize != ( UBaseType_t ) 0U )
+            {
+                uxReturn = prvQueueFreeSlots( pxQueue );
+            }
+            else
+            {
+                uxReturn = pxQueue->uxLength - queueMESSAGES_WAITING( pxQueue );
+            }
+        }
+        #else
+        {
+            uxReturn = pxQueue->uxLength - queueMESSAGES_WAITING( pxQueue );
+        }
+        #endif /* configUSE_QUEUE_ZERO_COPY */
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = queueMESSAGES_WAITING( pxQueue );
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configUSE_WAITERS == 1 )
+    {
+        /* Remove the queue from its waiter first. */
+        configASSERT( pxQueue->pxWaiter == NULL );
+    }
+    #endif
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
         /* The queue could have been allocated statically or dynamically, so
          * check before attempting to free the memory. */
         if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxQueue );
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive.xList ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive.xList ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+    static UBaseType_t prvMessagesWaiting( const Queue_t * pxQueue )
+    {
+        UBaseType_t uxReturn;
+
+        if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+        {
+            uxReturn = pxQueue->uxMessagesWaiting;
+        }
+        else if( queueMUTEX_HOLDER( pxQueue ) == NULL )
+        {
+            uxReturn = ( UBaseType_t ) 1;
+        }
+        else
+        {
+            uxReturn = ( UBaseType_t ) 0;
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvMutexTake( Queue_t * const pxQueue,
+                                    TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+        TimeOut_t xTimeOut;
+        TaskHandle_t xCurrentTask;
+
+        /* Uncontended take.  The held count is raised first so it is never
+         * below the number of mutexes the task owns.  A mutex with a priority
+         * ceiling always takes the critical section, which raising the
+         * priority needs anyway. */
+        if( queueMUTEX_HAS_CEILING( pxQueue ) == pdFALSE )
+        {
+            xCurrentTask = pvTaskIncrementMutexHeldCount();
+
+            if( portCOMPARE_AND_SWAP_POINTER( queueMUTEX_LOCK_WORD( pxQueue ), xCurrentTask, NULL ) != pdFALSE )
+            {
+                traceTAKE_MUTEX( pxQueue );
+                return pdPASS;
+            }
+
+            vTaskDecrementMutexHeldCount();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+         * statements within the function itself.  This is done in the interest
+         * of execution time efficiency. */
+        for( ; ; )
+        {
+            /* Tasks only change the lock word with the compare and swap or
+             * from within a critical section, and cannot run while this task
+             * is in one. */
+            taskENTER_CRITICAL();
+            {
+                if( queueMUTEX_HOLDER( pxQueue ) == NULL )
+                {
+                    traceTAKE_MUTEX( pxQueue );
+
+                    xCurrentTask = pvTaskIncrementMutexHeldCount();
+
+                    /* Keep the tag while other tasks still wait. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
+                    {
+                        pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) xCurrentTask | queueMUTEX_WAITERS );
+                    }
+                    else
+                    {
+                        pxQueue->u.xSemaphore.xMutexHolder = xCurrentTask;
+                    }
+
+                    queueMUTEX_TAKEN( pxQueue );
+
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* The owner cannot give the mutex while the scheduler is
+             * suspended, as mutexes cannot be given from an interrupt. */
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( queueMUTEX_HOLDER( pxQueue ) != NULL )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                    taskENTER_CRITICAL();
+                    {
+                        /* From now on the owner's compare and swap fails, so it
+                         * gives the mutex through prvMutexGive()'s slow path and
+                         * wakes this task. */
+                        pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) pxQueue->u.xSemaphore.xMutexHolder | queueMUTEX_WAITERS );
+                        xInheritanceOccurred = queueMUTEX_INHERIT( pxQueue );
+                    }
+                    taskEXIT_CRITICAL();
+
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The mutex was given before the scheduler was suspended,
+                     * so attempt to take it again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( queueMUTEX_HOLDER( pxQueue ) != NULL )
+                {
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            UBaseType_t uxHighestWaitingPriority;
+
+                            /* Disinherit this task's priority again, but only
+                             * as low as the highest priority task still waiting
+                             * for the mutex. */
+                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+                            vTaskPriorityDisinheritAfterTimeout( queueMUTEX_HOLDER( pxQueue ), uxHighestWaitingPriority );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvMutexGive( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+        TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+
+        /* Uncontended give.  The compare only matches the untagged handle, so
+         * it fails as soon as a task waits.  A task running at an inherited
+         * priority has to go through xTaskPriorityDisinherit(). */
+        if( xTaskPriorityIsInherited() == pdFALSE )
+        {
+            if( portCOMPARE_AND_SWAP_POINTER( queueMUTEX_LOCK_WORD( pxQueue ), NULL, xCurrentTask ) != pdFALSE )
+            {
+                vTaskDecrementMutexHeldCount();
+                traceGIVE_MUTEX( pxQueue );
+                return pdPASS;
+            }
+        }
+
+        taskENTER_CRITICAL();
+        {
+            if( queueMUTEX_HOLDER( pxQueue ) != NULL )
+            {
+                /* Only the owner can give a mutex. */
+                configASSERT( queueMUTEX_HOLDER( pxQueue ) == xCurrentTask );
+
+                traceGIVE_MUTEX( pxQueue );
+
+                /* The task may have inherited a priority, which is restored
+                 * once it has given back every mutex it holds. */
+                xYieldRequired = queueMUTEX_DISINHERIT( pxQueue );
+
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The woken task takes the mutex when it runs.  Keep the tag
+                 * for the tasks still waiting. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
+                {
+                    pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) queueMUTEX_WAITERS;
+                }
+                else
+                {
+                    pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The mutex is not taken. */
+                traceQUEUE_SEND_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    static void prvRaiseToCeiling( Queue_t * const pxQueue )
+    {
+        /* No task that takes the mutex can pre-empt the holder once it runs
+         * at the ceiling, so while the holder does not block nobody blocks on
+         * the mutex and no priority is ever inherited through it. */
+        if( queueMUTEX_HAS_CEILING( pxQueue ) != pdFALSE )
+        {
+            pxQueue->u.xSemaphore.uxPriorityBeforeCeiling = uxTaskPriorityRaiseToCeiling( pxQueue->u.xSemaphore.uxCeilingPriority );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvMutexInherit( Queue_t * const pxQueue )
     {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
+        BaseType_t xReturn = pdFALSE;
+
+        /* A task can still block on a ceiling mutex if the holder blocked
+         * while holding it.  The holder already runs at the ceiling, which is
+         * at least the priority of any task that takes the mutex. */
+        if( queueMUTEX_HAS_CEILING( pxQueue ) == pdFALSE )
+        {
+            xReturn = xTaskPriorityInherit( queueMUTEX_HOLDER( pxQueue ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
     }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    static BaseType_t prvMutexDisinherit( Queue_t * const pxQueue )
     {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+        BaseType_t xReturn;
+
+        if( queueMUTEX_HAS_CEILING( pxQueue ) != pdFALSE )
+        {
+            xReturn = xTaskPriorityRestoreFromCeiling( pxQueue->u.xSemaphore.uxCeilingPriority, pxQueue->u.xSemaphore.uxPriorityBeforeCeiling );
+        }
+        else
+        {
+            xReturn = xTaskPriorityDisinherit( queueMUTEX_HOLDER( pxQueue ) );
+        }
+
+        return xReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_QUEUE_BATCH == 1 )
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                     const uint8_t * pucItems,
+                                     const UBaseType_t uxCount )
     {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+        const size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirstLength;
+
+        /* This function is called from a critical section.  pcTail is exactly
+         * uxLength items past pcHead, so the items either fit before it or wrap
+         * once to pcHead. */
+        xFirstLength = configMIN( xBytes, ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) );
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pucItems, xFirstLength ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+
+        if( xBytes > xFirstLength )
+        {
+            ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pucItems[ xFirstLength ] ), xBytes - xFirstLength ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+            pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirstLength ); /*lint !e9016 Pointer arithmetic on char types ok. */
+        }
+        else
+        {
+            pxQueue->pcWriteTo += xBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + uxCount;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_QUEUE_BATCH */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_QUEUE_BATCH == 1 )
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                       uint8_t * pucBuffer,
+                                       const UBaseType_t uxCount )
     {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        const size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirstLength;
+        int8_t * pcReadFrom;
+
+        /* pcReadFrom points at the last item read, so the first item to read
+         * is the one after it. */
+        pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+        if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xFirstLength = configMIN( xBytes, ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ) );
+        ( void ) memcpy( ( void * ) pucBuffer, ( const void * ) pcReadFrom, xFirstLength ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        if( xBytes > xFirstLength )
+        {
+            ( void ) memcpy( ( void * ) &( pucBuffer[ xFirstLength ] ), ( const void * ) pxQueue->pcHead, xBytes - xFirstLength ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+            pcReadFrom = pxQueue->pcHead + ( xBytes - xFirstLength ); /*lint !e9016 Pointer arithmetic on char types ok. */
+        }
+        else
+        {
+            pcReadFrom += xBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+        }
+
+        /* Leave pcReadFrom pointing at the last item read, as
+         * prvCopyDataFromQueue() does. */
+        pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - uxCount;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_QUEUE_BATCH */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_QUEUE_BATCH == 1 )
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    static BaseType_t prvUnblockBatchReceivers( Queue_t * const pxQueue,
+                                                UBaseType_t uxCount )
     {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        /* A queue is only locked by a task that has also suspended the
+         * scheduler, so only an interrupt can find it locked here.
+         * prvUnlockQueue() then unblocks one receiver per item counted in
+         * cTxLock. */
+        if( pxQueue->cTxLock != queueUNLOCKED )
+        {
+            for( ; uxCount > ( UBaseType_t ) 0; uxCount-- )
+            {
+                const int8_t cTxLock = pxQueue->cTxLock;
+
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+        }
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            else if( pxQueue->pxQueueSetContainer != NULL )
+            {
+                /* The queue set holds one handle per item in its members. */
+                for( ; uxCount > ( UBaseType_t ) 0; uxCount-- )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        xHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        #endif /* configUSE_QUEUE_SETS */
+        else
+        {
+            /* Each item can satisfy one waiting receiver.  Usually there is a
+             * single receiver, so the whole batch costs one wake. */
+            while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxCount--;
+            }
+        }
+
+        #if ( configUSE_WAITERS == 1 )
+        {
+            /* One notification for the whole batch. */
+            if( pxQueue->pxWaiter != NULL )
+            {
+                vWaiterNotifyFromISR( pxQueue->pxWaiter, pxQueue->ulWaiterBits, &xHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_WAITERS */
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH == 1 )
+
+    static BaseType_t prvUnblockBatchSenders( Queue_t * const pxQueue,
+                                              UBaseType_t uxCount )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( pxQueue->cRxLock != queueUNLOCKED )
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+            for( ; uxCount > ( UBaseType_t ) 0; uxCount-- )
+            {
+                const int8_t cRxLock = pxQueue->cRxLock;
+
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxCount--;
+            }
         }
 
-        return uxHighestPriorityOfWaitingTasks;
+        return xHigherPriorityTaskWoken;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_QUEUE_BATCH */
 /*-----------------------------------------------------------*/
 
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
@@ -2190,7 +3806,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
                 /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                xReturn = queueMUTEX_DISINHERIT( pxQueue );
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
             }
             else
@@ -2314,9 +3930,9 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                     /* Tasks that are removed from the event list will get
                      * added to the pending ready list as the scheduler is still
                      * suspended. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -2337,9 +3953,9 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
             {
                 /* Tasks that are removed from the event list will get added to
                  * the pending ready list as the scheduler is still suspended. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority so record that
                          * a context switch is required. */
@@ -2371,9 +3987,9 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         while( cRxLock > queueLOCKED_UNMODIFIED )
         {
-            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
             {
-                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                 {
                     vTaskMissedYield();
                 }
@@ -2424,7 +4040,7 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+    if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t ) 0 )
     {
         xReturn = pdTRUE;
     }
@@ -2437,13 +4053,14 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xCopyPosition )
 {
     BaseType_t xReturn;
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( queueHAS_SPACE( pxQueue, xCopyPosition ) == pdFALSE )
         {
             xReturn = pdTRUE;
         }
@@ -2458,6 +4075,241 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvQueueHasSpace( const Queue_t * pxQueue,
+                                        const BaseType_t xCopyPosition )
+    {
+        BaseType_t xReturn;
+
+        if( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RESERVED ) != 0U )
+        {
+            /* The reserved slot is the one at pcWriteTo, and nothing can be
+             * queued behind it until it is committed. */
+            xReturn = pdFALSE;
+        }
+        else if( ( pxQueue->ucZeroCopyState & queueZERO_COPY_REFERENCED ) != 0U )
+        {
+            /* The referenced item is no longer counted in uxMessagesWaiting but
+             * its slot is still in use.  Until another receive moves pcReadFrom
+             * on it is also where an item sent to the front would be written. */
+            if( ( xCopyPosition == queueSEND_TO_BACK ) && ( prvQueueFreeSlots( pxQueue ) != ( UBaseType_t ) 0 ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        else if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static UBaseType_t prvQueueFreeSlots( const Queue_t * pxQueue )
+    {
+        UBaseType_t uxReturn;
+        size_t xDistance;
+
+        if( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RESERVED ) != 0U )
+        {
+            uxReturn = ( UBaseType_t ) 0;
+        }
+        else if( ( pxQueue->ucZeroCopyState & queueZERO_COPY_REFERENCED ) != 0U )
+        {
+            /* Receives made while the item is referenced free the slots after
+             * it, but pcWriteTo only reaches those by passing the referenced
+             * slot, so the free space ends there.  pcWriteTo can only be equal
+             * to pcReferenced when every other slot is in use. */
+            if( pxQueue->pcWriteTo > pxQueue->pcReferenced ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+            {
+                xDistance = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) + ( size_t ) ( pxQueue->pcReferenced - pxQueue->pcHead );
+            }
+            else
+            {
+                xDistance = ( size_t ) ( pxQueue->pcReferenced - pxQueue->pcWriteTo );
+            }
+
+            uxReturn = ( UBaseType_t ) ( xDistance / pxQueue->uxItemSize );
+        }
+        else
+        {
+            uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+        }
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static void prvCommitReservedItem( Queue_t * const pxQueue )
+    {
+        /* This function is called from a critical section.  The data is
+         * already in place, so this is prvCopyDataToQueue() without the
+         * memcpy(). */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1;
+        pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_RESERVED;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static void * prvReferenceOldestItem( Queue_t * const pxQueue )
+    {
+        /* This function is called from a critical section.  Only one item can
+         * be referenced at a time, as references are not tracked individually. */
+        configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_REFERENCED ) == 0U );
+
+        /* prvCopyDataFromQueue() without the memcpy(). */
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+        pxQueue->ucZeroCopyState |= queueZERO_COPY_REFERENCED;
+        pxQueue->pcReferenced = pxQueue->u.xQueue.pcReadFrom;
+
+        return ( void * ) pxQueue->pcReferenced;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvNotifyZeroCopyWaiters( Queue_t * const pxQueue,
+                                                const BaseType_t xItemAdded )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        const int8_t cTxLock = pxQueue->cTxLock;
+        const int8_t cRxLock = pxQueue->cRxLock;
+
+        /* A queue is only locked by a task that has also suspended the
+         * scheduler, so only an interrupt can find it locked here.  As in
+         * xQueueGenericSendFromISR() and xQueueReceiveFromISR() the event lists
+         * are then left to prvUnlockQueue(). */
+        if( xItemAdded != pdFALSE )
+        {
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        xHigherPriorityTaskWoken = prvNotifyQueueSetContainer( pxQueue );
+                    }
+                    else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
+                    {
+                        xHigherPriorityTaskWoken = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
+                    {
+                        xHigherPriorityTaskWoken = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            #if ( configUSE_WAITERS == 1 )
+            {
+                if( pxQueue->pxWaiter != NULL )
+                {
+                    vWaiterNotifyFromISR( pxQueue->pxWaiter, pxQueue->ulWaiterBits, &xHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_WAITERS */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Committing or releasing a slot can also let a blocked writer in. */
+        if( ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE ) &&
+            ( prvQueueHasSpace( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) )
+        {
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 {
     BaseType_t xReturn;
@@ -2465,14 +4317,41 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
     {
-        xReturn = pdTRUE;
+        /* A free mutex holds its one item. */
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            if( queueMUTEX_HOLDER( pxQueue ) == NULL )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        else if( queueHAS_SPACE( pxQueue, queueSEND_TO_BACK ) == pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
     }
-    else
+    #else /* if ( configUSE_MUTEX_FAST_PATH == 1 ) */
     {
-        xReturn = pdFALSE;
+        if( queueHAS_SPACE( pxQueue, queueSEND_TO_BACK ) == pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
     }
+    #endif /* configUSE_MUTEX_FAST_PATH */
 
     return xReturn;
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
@@ -2492,7 +4371,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * between the check to see if the queue is full and blocking on the queue. */
         portDISABLE_INTERRUPTS();
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
             {
                 /* The queue is full - do we want to block or just leave without
                  * posting? */
@@ -2500,7 +4379,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 {
                     /* As this is called from a coroutine we cannot block directly, but
                      * return indicating that we need to block. */
-                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
+                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend.xList ) );
                     portENABLE_INTERRUPTS();
                     return errQUEUE_BLOCKED;
                 }
@@ -2522,13 +4401,13 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 xReturn = pdPASS;
 
                 /* Were any co-routines waiting for data to become available? */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                 {
                     /* In this instance the co-routine could be placed directly
                      * into the ready list as we are within a critical section.
                      * Instead the same pending ready list mechanism is used as if
                      * the event were caused from within an interrupt. */
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                     {
                         /* The co-routine waiting has a higher priority so record
                          * that a yield might be appropriate. */
@@ -2579,7 +4458,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 {
                     /* As this is a co-routine we cannot block directly, but return
                      * indicating that we need to block. */
-                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
+                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive.xList ) );
                     portENABLE_INTERRUPTS();
                     return errQUEUE_BLOCKED;
                 }
@@ -2618,13 +4497,13 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 xReturn = pdPASS;
 
                 /* Were any co-routines waiting for space to become available? */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
                 {
                     /* In this instance the co-routine could be placed directly
                      * into the ready list as we are within a critical section.
                      * Instead the same pending ready list mechanism is used as if
                      * the event were caused from within an interrupt. */
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                     {
                         xReturn = errQUEUE_YIELD;
                     }
@@ -2669,9 +4548,9 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
              * co-routine has not already been woken. */
             if( xCoRoutinePreviouslyWoken == pdFALSE )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                 {
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                     {
                         return pdTRUE;
                     }
@@ -2731,9 +4610,9 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
             if( ( *pxCoRoutineWoken ) == pdFALSE )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend.xList ) ) == pdFALSE )
                 {
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend.xList ) ) != pdFALSE )
                     {
                         *pxCoRoutineWoken = pdTRUE;
                     }
@@ -2903,7 +4782,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
         {
             /* There is nothing in the queue, block for the specified period. */
-            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
+            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive.xList ), xTicksToWait, xWaitIndefinitely );
         }
         else
         {
@@ -2950,6 +4829,15 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                  * items in the queue/semaphore. */
                 xReturn = pdFAIL;
             }
+
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+                else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
+                {
+                    /* A mutex given through its lock word never notifies a
+                     * queue set. */
+                    xReturn = pdFAIL;
+                }
+            #endif
             else
             {
                 ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
@@ -3054,9 +4942,9 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
             if( cTxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive.xList ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive.xList ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority. */
                         xReturn = pdTRUE;
@@ -3085,3 +4973,86 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITERS == 1 )
+
+    BaseType_t xQueueAttachWaiter( QueueHandle_t xQueue,
+                                   WaiterHandle_t xWaiter,
+                                   uint32_t ulReadyBits )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxQueue->pxWaiter != NULL )
+            {
+                xReturn = pdFAIL;
+            }
+
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+                else if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                {
+                    /* A mutex given through its lock word never notifies a
+                     * waiter. */
+                    xReturn = pdFAIL;
+                }
+            #endif
+            else
+            {
+                pxQueue->pxWaiter = xWaiter;
+                pxQueue->ulWaiterBits = ulReadyBits;
+
+                /* Items written before the queue was added did not notify the
+                 * waiter. */
+                if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+                {
+                    vWaiterNotify( xWaiter, ulReadyBits );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITERS == 1 )
+
+    BaseType_t xQueueDetachWaiter( QueueHandle_t xQueue,
+                                   WaiterHandle_t xWaiter )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxQueue->pxWaiter == xWaiter )
+            {
+                pxQueue->pxWaiter = NULL;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITERS */
@@ -0,0 +1,637 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rw_lock.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*
+ * The whole lock state is one pointer sized word: the number of readers
+ * holding the lock, a bit set while a writer holds it, and a bit set while any
+ * task waits for it or a woken writer has yet to retry.  A take or give that
+ * finds the contended bit clear needs nothing but a compare and swap on the
+ * word.  Otherwise it takes the slow path, which suspends the scheduler and
+ * works on the word and the two wait lists as if it were the only task - no
+ * other task can then run, and interrupts never touch the lock.  Any fast path
+ * compare and swap that was interrupted by the slow path fails because the
+ * word changed, and is retried.
+ *
+ * Woken tasks are not handed the lock.  As with queues they retry the take, so
+ * a task of higher priority than the woken one may get in first.  A writer
+ * counts itself in uxPendingWriters from the time it first blocks until its
+ * take returns, which keeps readers out while it waits to run after being
+ * woken.
+ */
+
+/* Bits of the lock state. */
+#define rwLOCK_WRITE_LOCKED     ( ( ( portPOINTER_SIZE_TYPE ) 1 ) << ( ( sizeof( portPOINTER_SIZE_TYPE ) * ( size_t ) 8 ) - ( size_t ) 1 ) )
+#define rwLOCK_CONTENDED        ( rwLOCK_WRITE_LOCKED >> 1 )
+#define rwLOCK_READER_MASK      ( rwLOCK_CONTENDED - ( portPOINTER_SIZE_TYPE ) 1 )
+
+#define rwLOCK_STATE( pxLock )                  ( ( portPOINTER_SIZE_TYPE ) ( pxLock )->pvState )
+#define rwLOCK_SET_STATE( pxLock, uxState )     ( ( pxLock )->pvState = ( void * ) ( uxState ) )
+
+/* Bits stored in the ucFlags field of the lock. */
+#define rwFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the lock. */
+typedef struct RWLockDef_t          /*lint !e9058 Style convention uses tag. */
+{
+    void * volatile pvState;        /* Reader count, rwLOCK_WRITE_LOCKED and rwLOCK_CONTENDED.  Kept as a pointer so it can be updated with portCOMPARE_AND_SWAP_POINTER(). */
+    EventList_t xWaitingReaders;    /* Tasks blocked in xRWLockTakeRead(), in priority order. */
+    EventList_t xWaitingWriters;    /* Tasks blocked in xRWLockTakeWrite(), in priority order. */
+    UBaseType_t uxPendingWriters;   /* Writers blocked in, or woken but not yet returned from, xRWLockTakeWrite(). */
+    uint8_t ucFlags;
+} RWLock_t;
+
+/*
+ * Called by both xRWLockCreate() and xRWLockCreateStatic() to initialise the
+ * members of the newly created lock structure.
+ */
+static void prvInitialiseNewRWLock( RWLock_t * const pxLock,
+                                    uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Replace the lock state with uxNew if it still equals uxExpected.  Returns
+ * pdTRUE if it did.
+ */
+static BaseType_t prvCompareAndSwapState( RWLock_t * const pxLock,
+                                          portPOINTER_SIZE_TYPE uxExpected,
+                                          portPOINTER_SIZE_TYPE uxNew ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wake the highest priority waiting writer if the lock is free, or every
+ * waiting reader if no writer holds, waits for or is about to retry the lock.
+ * Must be called with the scheduler suspended.
+ */
+static void prvWakeWaitingTasks( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set rwLOCK_CONTENDED if a task waits for the lock or a writer is pending,
+ * clear it otherwise.  Must be called with the scheduler suspended.
+ */
+static void prvUpdateContended( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    RWLockHandle_t xRWLockCreate( void )
+    {
+        RWLock_t * pxLock;
+
+        pxLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxLock != NULL )
+        {
+            prvInitialiseNewRWLock( pxLock, 0 );
+            traceRW_LOCK_CREATE( pxLock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxLock;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * const pxStaticRWLock )
+    {
+        RWLock_t * const pxLock = ( RWLock_t * ) pxStaticRWLock; /*lint !e740 !e9087 Safe cast as StaticRWLock_t is opaque RWLock_t. */
+        RWLockHandle_t xReturn;
+
+        configASSERT( pxStaticRWLock );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticRWLock_t equals the size of the real lock
+             * structure. */
+            volatile size_t xSize = sizeof( StaticRWLock_t );
+            configASSERT( xSize == sizeof( RWLock_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( pxStaticRWLock != NULL )
+        {
+            prvInitialiseNewRWLock( pxLock, rwFLAGS_IS_STATICALLY_ALLOCATED );
+            traceRW_LOCK_CREATE( pxLock );
+
+            xReturn = pxLock;
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xRWLock )
+{
+    RWLock_t * pxLock = xRWLock;
+
+    configASSERT( pxLock );
+    configASSERT( rwLOCK_STATE( pxLock ) == ( portPOINTER_SIZE_TYPE ) 0 );
+
+    if( ( pxLock->ucFlags & rwFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxLock ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xRWLock == ( RWLockHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* Scrub the structure so future use will assert. */
+        ( void ) memset( pxLock, 0x00, sizeof( RWLock_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock,
+                            TickType_t xTicksToWait )
+{
+    RWLock_t * const pxLock = xRWLock;
+    portPOINTER_SIZE_TYPE uxState;
+    BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxLock );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* Fast path: count one more reader while no writer holds the lock and no
+     * task waits for it. */
+    uxState = rwLOCK_STATE( pxLock );
+
+    while( ( uxState & ( rwLOCK_WRITE_LOCKED | rwLOCK_CONTENDED ) ) == ( portPOINTER_SIZE_TYPE ) 0 )
+    {
+        configASSERT( uxState != rwLOCK_READER_MASK );
+
+        if( prvCompareAndSwapState( pxLock, uxState, uxState + ( portPOINTER_SIZE_TYPE ) 1 ) != pdFALSE )
+        {
+            return pdPASS;
+        }
+
+        uxState = rwLOCK_STATE( pxLock );
+    }
+
+    for( ; ; )
+    {
+        xBlocked = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            uxState = rwLOCK_STATE( pxLock );
+
+            /* Writers take precedence, so a reader does not join the others
+             * while a writer waits. */
+            if( ( ( uxState & rwLOCK_WRITE_LOCKED ) == ( portPOINTER_SIZE_TYPE ) 0 ) && ( pxLock->uxPendingWriters == ( UBaseType_t ) 0 ) )
+            {
+                configASSERT( ( uxState & rwLOCK_READER_MASK ) != rwLOCK_READER_MASK );
+                rwLOCK_SET_STATE( pxLock, uxState + ( portPOINTER_SIZE_TYPE ) 1 );
+                prvUpdateContended( pxLock );
+                xReturn = pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                traceRW_LOCK_TAKE_FAILED( pxLock );
+            }
+            else
+            {
+                if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    traceBLOCKING_ON_RW_LOCK_READ( pxLock );
+                    rwLOCK_SET_STATE( pxLock, uxState | rwLOCK_CONTENDED );
+                    vTaskPlaceOnEventList( &( pxLock->xWaitingReaders.xList ), xTicksToWait );
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    /* Timed out.  The task is no longer on the wait list. */
+                    prvUpdateContended( pxLock );
+                    traceRW_LOCK_TAKE_FAILED( pxLock );
+                }
+            }
+        }
+
+        if( xTaskResumeAll() == pdFALSE )
+        {
+            if( xBlocked != pdFALSE )
+            {
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlocked == pdFALSE )
+        {
+            break;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock )
+{
+    RWLock_t * const pxLock = xRWLock;
+    portPOINTER_SIZE_TYPE uxState;
+
+    configASSERT( pxLock );
+
+    /* Fast path: nobody waits, so there is nobody to wake. */
+    uxState = rwLOCK_STATE( pxLock );
+
+    while( ( uxState & rwLOCK_CONTENDED ) == ( portPOINTER_SIZE_TYPE ) 0 )
+    {
+        configASSERT( ( uxState & rwLOCK_READER_MASK ) != ( portPOINTER_SIZE_TYPE ) 0 );
+
+        if( prvCompareAndSwapState( pxLock, uxState, uxState - ( portPOINTER_SIZE_TYPE ) 1 ) != pdFALSE )
+        {
+            return pdPASS;
+        }
+
+        uxState = rwLOCK_STATE( pxLock );
+    }
+
+    vTaskSuspendAll();
+    {
+        uxState = rwLOCK_STATE( pxLock );
+        configASSERT( ( uxState & rwLOCK_READER_MASK ) != ( portPOINTER_SIZE_TYPE ) 0 );
+
+        uxState--;
+        rwLOCK_SET_STATE( pxLock, uxState );
+
+        if( ( uxState & rwLOCK_READER_MASK ) == ( portPOINTER_SIZE_TYPE ) 0 )
+        {
+            prvWakeWaitingTasks( pxLock );
+            prvUpdateContended( pxLock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock,
+                             TickType_t xTicksToWait )
+{
+    RWLock_t * const pxLock = xRWLock;
+    portPOINTER_SIZE_TYPE uxState;
+    BaseType_t xReturn = pdFAIL, xBlocked, xPending = pdFALSE, xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxLock );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* Fast path: the lock is free and nobody waits for it. */
+    if( prvCompareAndSwapState( pxLock, ( portPOINTER_SIZE_TYPE ) 0, rwLOCK_WRITE_LOCKED ) != pdFALSE )
+    {
+        return pdPASS;
+    }
+
+    for( ; ; )
+    {
+        xBlocked = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            uxState = rwLOCK_STATE( pxLock );
+
+            if( ( uxState & ~rwLOCK_CONTENDED ) == ( portPOINTER_SIZE_TYPE ) 0 )
+            {
+                rwLOCK_SET_STATE( pxLock, uxState | rwLOCK_WRITE_LOCKED );
+
+                if( xPending != pdFALSE )
+                {
+                    ( pxLock->uxPendingWriters )--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvUpdateContended( pxLock );
+                xReturn = pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                traceRW_LOCK_TAKE_FAILED( pxLock );
+            }
+            else
+            {
+                if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    if( xPending == pdFALSE )
+                    {
+                        ( pxLock->uxPendingWriters )++;
+                        xPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceBLOCKING_ON_RW_LOCK_WRITE( pxLock );
+                    rwLOCK_SET_STATE( pxLock, uxState | rwLOCK_CONTENDED );
+                    vTaskPlaceOnEventList( &( pxLock->xWaitingWriters.xList ), xTicksToWait );
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    /* Timed out.  Readers held back by this writer may now be
+                     * able to take the lock. */
+                    if( xPending != pdFALSE )
+                    {
+                        ( pxLock->uxPendingWriters )--;
+                        prvWakeWaitingTasks( pxLock );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvUpdateContended( pxLock );
+                    traceRW_LOCK_TAKE_FAILED( pxLock );
+                }
+            }
+        }
+
+        if( xTaskResumeAll() == pdFALSE )
+        {
+            if( xBlocked != pdFALSE )
+            {
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlocked == pdFALSE )
+        {
+            break;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock )
+{
+    RWLock_t * const pxLock = xRWLock;
+    portPOINTER_SIZE_TYPE uxState;
+
+    configASSERT( pxLock );
+
+    /* Fast path: nobody waits, so there is nobody to wake. */
+    if( prvCompareAndSwapState( pxLock, rwLOCK_WRITE_LOCKED, ( portPOINTER_SIZE_TYPE ) 0 ) == pdFALSE )
+    {
+        vTaskSuspendAll();
+        {
+            uxState = rwLOCK_STATE( pxLock );
+            configASSERT( ( uxState & rwLOCK_WRITE_LOCKED ) != ( portPOINTER_SIZE_TYPE ) 0 );
+
+            rwLOCK_SET_STATE( pxLock, uxState & ~rwLOCK_WRITE_LOCKED );
+            prvWakeWaitingTasks( pxLock );
+            prvUpdateContended( pxLock );
+        }
+        ( void ) xTaskResumeAll();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock )
+{
+    RWLock_t * const pxLock = xRWLock;
+
+    configASSERT( pxLock );
+
+    return ( UBaseType_t ) ( rwLOCK_STATE( pxLock ) & rwLOCK_READER_MASK );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewRWLock( RWLock_t * const pxLock,
+                                    uint8_t ucFlags )
+{
+    pxLock->pvState = NULL;
+    vTaskEventListInitialise( &( pxLock->xWaitingReaders ) );
+    vTaskEventListInitialise( &( pxLock->xWaitingWriters ) );
+    pxLock->uxPendingWriters = ( UBaseType_t ) 0;
+    pxLock->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCompareAndSwapState( RWLock_t * const pxLock,
+                                          portPOINTER_SIZE_TYPE uxExpected,
+                                          portPOINTER_SIZE_TYPE uxNew )
+{
+    BaseType_t xReturn;
+
+    #ifdef portCOMPARE_AND_SWAP_POINTER
+    {
+        xReturn = portCOMPARE_AND_SWAP_POINTER( &( pxLock->pvState ), ( void * ) uxNew, ( void * ) uxExpected );
+    }
+    #else
+    {
+        taskENTER_CRITICAL();
+        {
+            if( rwLOCK_STATE( pxLock ) == uxExpected )
+            {
+                rwLOCK_SET_STATE( pxLock, uxNew );
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* portCOMPARE_AND_SWAP_POINTER */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeWaitingTasks( RWLock_t * const pxLock )
+{
+    const portPOINTER_SIZE_TYPE uxState = rwLOCK_STATE( pxLock );
+
+    if( ( uxState & rwLOCK_WRITE_LOCKED ) == ( portPOINTER_SIZE_TYPE ) 0 )
+    {
+        if( listLIST_IS_EMPTY( &( pxLock->xWaitingWriters.xList ) ) == pdFALSE )
+        {
+            if( ( uxState & rwLOCK_READER_MASK ) == ( portPOINTER_SIZE_TYPE ) 0 )
+            {
+                /* The woken writer stays counted in uxPendingWriters, so the
+                 * readers wait until it has taken the lock. */
+                taskENTER_CRITICAL();
+                {
+                    ( void ) xTaskRemoveFromEventList( &( pxLock->xWaitingWriters.xList ) );
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( pxLock->uxPendingWriters == ( UBaseType_t ) 0 )
+        {
+            /* Each reader is woken in its own critical section, highest
+             * priority first, so interrupts are not held off for the whole
+             * list.  xTaskResumeAll() switches to the highest of them if it
+             * has a higher priority than the calling task. */
+            while( listLIST_IS_EMPTY( &( pxLock->xWaitingReaders.xList ) ) == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    ( void ) xTaskRemoveFromEventList( &( pxLock->xWaitingReaders.xList ) );
+                }
+                taskEXIT_CRITICAL();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvUpdateContended( RWLock_t * const pxLock )
+{
+    portPOINTER_SIZE_TYPE uxState = rwLOCK_STATE( pxLock );
+
+    if( ( listLIST_IS_EMPTY( &( pxLock->xWaitingReaders.xList ) ) != pdFALSE ) &&
+        ( listLIST_IS_EMPTY( &( pxLock->xWaitingWriters.xList ) ) != pdFALSE ) &&
+        ( pxLock->uxPendingWriters == ( UBaseType_t ) 0 ) )
+    {
+        uxState &= ~rwLOCK_CONTENDED;
+    }
+    else
+    {
+        uxState |= rwLOCK_CONTENDED;
+    }
+
+    rwLOCK_SET_STATE( pxLock, uxState );
+}
+/*-----------------------------------------------------------*/
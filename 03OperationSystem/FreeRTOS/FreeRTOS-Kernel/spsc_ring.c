@@ -0,0 +1,470 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_ring.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_ring.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*
+ * The producer owns uxHead and the consumer owns uxTail.  Each side only ever
+ * writes its own index and reads the other's, so neither needs a critical
+ * section.  The indices run freely and are masked to find the slot, which is
+ * why the length must be a power of two, and the ring is full when they are
+ * uxLength apart.
+ *
+ * portMEMORY_BARRIER() orders the item copy against publishing the index that
+ * hands the slot to the other side, and the index store against the read of the
+ * other side's index used to decide on a wake up.  It is a compiler barrier on
+ * single core ports and a full fence on the Posix port.
+ */
+
+/* Bits stored in the ucFlags field of the ring. */
+#define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the ring. */
+typedef struct SpscRingDef_t           /*lint !e9058 Style convention uses tag. */
+{
+    volatile UBaseType_t uxHead;       /* Number of items ever pushed.  Written by the producer only. */
+    volatile UBaseType_t uxTail;       /* Number of items ever popped.  Written by the consumer only. */
+    UBaseType_t uxMask;                /* The length of the ring minus one. */
+    UBaseType_t uxItemSize;            /* The size of each item in bytes. */
+    uint8_t * pucStorage;              /* Points to the storage area, uxMask + 1 items long. */
+    volatile TaskHandle_t xTaskToNotify; /* The consumer task notified when the ring stops being empty, or NULL. */
+    UBaseType_t uxIndexToNotify;       /* The task notification index used to wake xTaskToNotify. */
+    uint8_t ucFlags;
+} SpscRing_t;
+
+/*
+ * Called by both xSpscRingCreate() and xSpscRingCreateStatic() to initialise
+ * the members of the newly created ring structure.
+ */
+static void prvInitialiseNewSpscRing( SpscRing_t * const pxRing,
+                                      uint8_t * const pucStorage,
+                                      UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize,
+                                      uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the item into the slot at uxHead and publish it.  Returns pdTRUE if the
+ * consumer had emptied the ring by the time the item became visible, in which
+ * case it may be about to wait and must be notified.
+ */
+static BaseType_t prvPushItem( SpscRing_t * const pxRing,
+                               const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory;
+        size_t xStorageBytes;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* The structure and the storage area are allocated in a single call to
+         * pvPortMalloc(), with the storage area immediately after the
+         * structure. */
+        xStorageBytes = ( size_t ) uxLength * ( size_t ) uxItemSize;
+
+        if( ( xStorageBytes / ( size_t ) uxItemSize ) == ( size_t ) uxLength )
+        {
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( SpscRing_t ) + xStorageBytes ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            pucAllocatedMemory = NULL;
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewSpscRing( ( SpscRing_t * ) pucAllocatedMemory,    /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                      pucAllocatedMemory + sizeof( SpscRing_t ), /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer. */
+                                      uxLength,
+                                      uxItemSize,
+                                      0 );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ( SpscRingHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+                                            UBaseType_t uxItemSize,
+                                            uint8_t * const pucRingStorageArea,
+                                            StaticSpscRing_t * const pxStaticRing )
+    {
+        SpscRing_t * const pxRing = ( SpscRing_t * ) pxStaticRing; /*lint !e740 !e9087 Safe cast as StaticSpscRing_t is opaque SpscRing_t. */
+        SpscRingHandle_t xReturn;
+
+        configASSERT( pucRingStorageArea );
+        configASSERT( pxStaticRing );
+        configASSERT( uxLength > ( UBaseType_t ) 0 );
+        configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticSpscRing_t equals the size of the real ring
+             * structure. */
+            volatile size_t xSize = sizeof( StaticSpscRing_t );
+            configASSERT( xSize == sizeof( SpscRing_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucRingStorageArea != NULL ) && ( pxStaticRing != NULL ) )
+        {
+            prvInitialiseNewSpscRing( pxRing,
+                                      pucRingStorageArea,
+                                      uxLength,
+                                      uxItemSize,
+                                      spscFLAGS_IS_STATICALLY_ALLOCATED );
+
+            xReturn = ( SpscRingHandle_t ) pxStaticRing; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vSpscRingDelete( SpscRingHandle_t xRing )
+{
+    SpscRing_t * pxRing = xRing;
+
+    configASSERT( pxRing );
+
+    if( ( pxRing->ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the storage were allocated using a single
+             * call to pvPortMalloc(), hence only one call to vPortFree() is
+             * required. */
+            vPortFree( ( void * ) pxRing ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xRing == ( SpscRingHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* Scrub the structure so future use will assert. */
+        ( void ) memset( pxRing, 0x00, sizeof( SpscRing_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vSpscRingSetNotification( SpscRingHandle_t xRing,
+                               TaskHandle_t xTaskToNotify,
+                               UBaseType_t uxIndexToNotify )
+{
+    SpscRing_t * const pxRing = xRing;
+
+    configASSERT( pxRing );
+    configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+    /* Clear the handle first so a producer never pairs the new task with the
+     * old index. */
+    pxRing->xTaskToNotify = NULL;
+    portMEMORY_BARRIER();
+    pxRing->uxIndexToNotify = uxIndexToNotify;
+    portMEMORY_BARRIER();
+    pxRing->xTaskToNotify = xTaskToNotify;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+                          const void * pvItem )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxRing );
+    configASSERT( pvItem );
+
+    if( ( pxRing->uxHead - pxRing->uxTail ) <= pxRing->uxMask )
+    {
+        if( prvPushItem( pxRing, pvItem ) != pdFALSE )
+        {
+            xTaskToNotify = pxRing->xTaskToNotify;
+
+            if( xTaskToNotify != NULL )
+            {
+                ( void ) xTaskNotifyGiveIndexed( xTaskToNotify, pxRing->uxIndexToNotify );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxRing );
+    configASSERT( pvItem );
+
+    if( ( pxRing->uxHead - pxRing->uxTail ) <= pxRing->uxMask )
+    {
+        if( prvPushItem( pxRing, pvItem ) != pdFALSE )
+        {
+            xTaskToNotify = pxRing->xTaskToNotify;
+
+            if( xTaskToNotify != NULL )
+            {
+                vTaskNotifyGiveIndexedFromISR( xTaskToNotify, pxRing->uxIndexToNotify, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+                         void * pvBuffer )
+{
+    SpscRing_t * const pxRing = xRing;
+    UBaseType_t uxTail;
+    uint8_t * pucSlot;
+    BaseType_t xReturn;
+
+    configASSERT( pxRing );
+    configASSERT( pvBuffer );
+
+    uxTail = pxRing->uxTail;
+
+    if( pxRing->uxHead != uxTail )
+    {
+        /* Do not read the slot before the index that published it. */
+        portMEMORY_BARRIER();
+
+        pucSlot = &( pxRing->pucStorage[ ( uxTail & pxRing->uxMask ) * pxRing->uxItemSize ] );
+
+        if( pxRing->uxItemSize == ( UBaseType_t ) 1 )
+        {
+            *( ( uint8_t * ) pvBuffer ) = *pucSlot;
+        }
+        else
+        {
+            ( void ) memcpy( pvBuffer, ( const void * ) pucSlot, ( size_t ) pxRing->uxItemSize ); /*lint !e9087 memcpy() requires void *. */
+        }
+
+        /* The copy must be complete before the slot is handed back to the
+         * producer, and the new tail visible before the next emptiness check
+         * reads uxHead - see prvPushItem(). */
+        portMEMORY_BARRIER();
+        pxRing->uxTail = uxTail + ( UBaseType_t ) 1;
+        portMEMORY_BARRIER();
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvBuffer,
+                             TickType_t xTicksToWait )
+{
+    SpscRing_t * const pxRing = xRing;
+    BaseType_t xReturn;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxRing );
+
+    /* Only the registered task is woken when items arrive. */
+    configASSERT( ( xTicksToWait == ( TickType_t ) 0 ) || ( pxRing->xTaskToNotify == xTaskGetCurrentTaskHandle() ) );
+
+    xReturn = xSpscRingPop( xRing, pvBuffer );
+
+    if( ( xReturn == errQUEUE_EMPTY ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* A push that finds the ring empty gives the notification, so an
+             * item published since the pop above has either been seen by the
+             * next pop or left the notification pending.  Stale counts from
+             * items already popped only cause an extra pass of the loop. */
+            ( void ) ulTaskNotifyTakeIndexed( pxRing->uxIndexToNotify, pdTRUE, xTicksToWait );
+            xReturn = xSpscRingPop( xRing, pvBuffer );
+        } while( ( xReturn == errQUEUE_EMPTY ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing )
+{
+    const SpscRing_t * const pxRing = xRing;
+
+    configASSERT( pxRing );
+
+    return pxRing->uxHead - pxRing->uxTail;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPushItem( SpscRing_t * const pxRing,
+                               const void * pvItem )
+{
+    const UBaseType_t uxHead = pxRing->uxHead;
+    uint8_t * const pucSlot = &( pxRing->pucStorage[ ( uxHead & pxRing->uxMask ) * pxRing->uxItemSize ] );
+
+    if( pxRing->uxItemSize == ( UBaseType_t ) 1 )
+    {
+        /* USART receive path. */
+        *pucSlot = *( ( const uint8_t * ) pvItem );
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pucSlot, pvItem, ( size_t ) pxRing->uxItemSize ); /*lint !e9087 memcpy() requires void *. */
+    }
+
+    /* The item must be in the slot before the consumer can see the new
+     * head. */
+    portMEMORY_BARRIER();
+    pxRing->uxHead = uxHead + ( UBaseType_t ) 1;
+    portMEMORY_BARRIER();
+
+    /* Deciding on the wake up from the tail read before the push could miss a
+     * consumer that empties the ring and goes to wait in between, so read it
+     * again now the item is visible.  If the consumer has already taken
+     * everything before this item it may have found the ring empty. */
+    return ( pxRing->uxTail == uxHead ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSpscRing( SpscRing_t * const pxRing,
+                                      uint8_t * const pucStorage,
+                                      UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize,
+                                      uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxRing, 0x00, sizeof( SpscRing_t ) ); /*lint !e9087 memset() requires void *. */
+    pxRing->pucStorage = pucStorage;
+    pxRing->uxMask = uxLength - ( UBaseType_t ) 1;
+    pxRing->uxItemSize = uxItemSize;
+    pxRing->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
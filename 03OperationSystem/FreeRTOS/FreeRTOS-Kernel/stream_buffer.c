@@ -40,6 +40,10 @@
 #include "task.h"
 #include "stream_buffer.h"
 
+#if ( configUSE_WAITERS == 1 )
+    #include "waiter.h"
+#endif
+
 #if ( configUSE_TASK_NOTIFICATIONS != 1 )
     #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -208,6 +212,31 @@
     sbSEND_COMPLETE_FROM_ISR( ( pxStreamBuffer ), ( pxHigherPriorityTaskWoken ) )
 #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
+/* A stream buffer added to a waiter becomes ready whenever a write leaves at
+ * least the trigger level in it - when a task waiting to receive would be
+ * unblocked.  This is done whether or not the application provides its own
+ * completion macros or callbacks. */
+#if ( configUSE_WAITERS == 1 )
+    #define prvNOTIFY_WAITER( pxStreamBuffer )                                                    \
+    {                                                                                             \
+        if( ( pxStreamBuffer )->pxWaiter != NULL )                                                \
+        {                                                                                         \
+            vWaiterNotify( ( pxStreamBuffer )->pxWaiter, ( pxStreamBuffer )->ulWaiterBits );      \
+        }                                                                                         \
+    }
+
+    #define prvNOTIFY_WAITER_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )                                                \
+    {                                                                                                                             \
+        if( ( pxStreamBuffer )->pxWaiter != NULL )                                                                                \
+        {                                                                                                                         \
+            vWaiterNotifyFromISR( ( pxStreamBuffer )->pxWaiter, ( pxStreamBuffer )->ulWaiterBits, ( pxHigherPriorityTaskWoken ) ); \
+        }                                                                                                                         \
+    }
+#else /* if ( configUSE_WAITERS == 1 ) */
+    #define prvNOTIFY_WAITER( pxStreamBuffer )
+    #define prvNOTIFY_WAITER_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )
+#endif /* if ( configUSE_WAITERS == 1 ) */
+
 /*lint -restore (9026) */
 
 /* The number of bytes used to hold the length of a message in the buffer. */
@@ -239,6 +268,10 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+    #if ( configUSE_WAITERS == 1 )
+        struct WaiterDef_t * pxWaiter; /* The waiter the stream buffer was added to, or NULL. */
+        uint32_t ulWaiterBits;         /* The ready bits the stream buffer sets in pxWaiter. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -316,6 +349,22 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                           StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/*
+ * The number of bytes that can be written starting at xHead without wrapping
+ * back to the start of the buffer.
+ */
+    static size_t prvContiguousSpace( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of bytes that can be read starting at xTail without wrapping
+ * back to the start of the buffer.
+ */
+    static size_t prvContiguousData( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 /*-----------------------------------------------------------*/
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
     StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
@@ -480,6 +529,13 @@ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
 
     configASSERT( pxStreamBuffer );
 
+    #if ( configUSE_WAITERS == 1 )
+    {
+        /* Remove the stream buffer from its waiter first. */
+        configASSERT( pxStreamBuffer->pxWaiter == NULL );
+    }
+    #endif
+
     traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
@@ -517,6 +573,11 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_WAITERS == 1 )
+        struct WaiterDef_t * pxWaiter;
+        uint32_t ulWaiterBits;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -539,6 +600,14 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_WAITERS == 1 )
+            {
+                /* The stream buffer stays in its waiter. */
+                pxWaiter = pxStreamBuffer->pxWaiter;
+                ulWaiterBits = pxStreamBuffer->ulWaiterBits;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -553,6 +622,13 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_WAITERS == 1 )
+            {
+                pxStreamBuffer->pxWaiter = pxWaiter;
+                pxStreamBuffer->ulWaiterBits = ulWaiterBits;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -754,6 +830,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETED( pxStreamBuffer );
+            prvNOTIFY_WAITER( pxStreamBuffer );
         }
         else
         {
@@ -804,6 +881,7 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            prvNOTIFY_WAITER_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
         }
         else
         {
@@ -1245,6 +1323,378 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                      void ** ppvData,
+                                      TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+        TimeOut_t xTimeOut;
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+
+        /* A message buffer must keep each length word next to its message, so
+         * only stream buffers can be written in place. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Wait until at least one byte is free. */
+                taskENTER_CRITICAL();
+                {
+                    if( xStreamBufferSpacesAvailable( pxStreamBuffer ) == ( size_t ) 0 )
+                    {
+                        /* Clear notification state as going to wait for space. */
+                        ( void ) xTaskNotifyStateClear( NULL );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvContiguousSpace( pxStreamBuffer );
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+
+        if( xReturn == ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                             void ** ppvData )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+
+        return prvContiguousSpace( pxStreamBuffer );
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesWritten )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xHead, xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        /* The reader only ever frees space, so the region returned by the
+         * last acquire is still at least this large. */
+        configASSERT( xBytesWritten <= prvContiguousSpace( pxStreamBuffer ) );
+
+        if( xBytesWritten > ( size_t ) 0 )
+        {
+            xHead = pxStreamBuffer->xHead + xBytesWritten;
+
+            if( xHead >= pxStreamBuffer->xLength )
+            {
+                xHead -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxStreamBuffer->xHead = xHead;
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvBytesInBuffer( pxStreamBuffer );
+
+        /* Was a task waiting for the data? */
+        if( ( xBytesWritten > ( size_t ) 0 ) && ( xReturn >= pxStreamBuffer->xTriggerLevelBytes ) )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+            prvNOTIFY_WAITER( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesWritten,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xHead, xReturn;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( xBytesWritten <= prvContiguousSpace( pxStreamBuffer ) );
+
+        if( xBytesWritten > ( size_t ) 0 )
+        {
+            xHead = pxStreamBuffer->xHead + xBytesWritten;
+
+            if( xHead >= pxStreamBuffer->xLength )
+            {
+                xHead -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxStreamBuffer->xHead = xHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvBytesInBuffer( pxStreamBuffer );
+
+        if( ( xBytesWritten > ( size_t ) 0 ) && ( xReturn >= pxStreamBuffer->xTriggerLevelBytes ) )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            prvNOTIFY_WAITER_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvData,
+                                     TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state must
+             * be performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xReturn == ( size_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xReturn == ( size_t ) 0 )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvContiguousData( pxStreamBuffer );
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+
+        if( xReturn == ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void ** ppvData )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+
+        return prvContiguousData( pxStreamBuffer );
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesRead )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xTail;
+
+        configASSERT( pxStreamBuffer );
+
+        /* The writer only ever adds data, so the region returned by the last
+         * acquire is still at least this large. */
+        configASSERT( xBytesRead <= prvContiguousData( pxStreamBuffer ) );
+
+        if( xBytesRead > ( size_t ) 0 )
+        {
+            xTail = pxStreamBuffer->xTail + xBytesRead;
+
+            if( xTail >= pxStreamBuffer->xLength )
+            {
+                xTail -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxStreamBuffer->xTail = xTail;
+
+            /* Was a task waiting for space in the buffer? */
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xStreamBufferSpacesAvailable( pxStreamBuffer );
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesRead,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xTail;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( xBytesRead <= prvContiguousData( pxStreamBuffer ) );
+
+        if( xBytesRead > ( size_t ) 0 )
+        {
+            xTail = pxStreamBuffer->xTail + xBytesRead;
+
+            if( xTail >= pxStreamBuffer->xLength )
+            {
+                xTail -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxStreamBuffer->xTail = xTail;
+            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+
+        return xStreamBufferSpacesAvailable( pxStreamBuffer );
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
                                      size_t xCount,
@@ -1356,6 +1806,29 @@ static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvContiguousSpace( const StreamBuffer_t * const pxStreamBuffer )
+    {
+        /* When xTail is 0 the free space already stops one byte short of the
+         * end of the buffer, so the minimum never lets xHead catch up with
+         * xTail. */
+        return configMIN( xStreamBufferSpacesAvailable( ( StreamBufferHandle_t ) pxStreamBuffer ), pxStreamBuffer->xLength - pxStreamBuffer->xHead );
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvContiguousData( const StreamBuffer_t * const pxStreamBuffer )
+    {
+        return configMIN( prvBytesInBuffer( pxStreamBuffer ), pxStreamBuffer->xLength - pxStreamBuffer->xTail );
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           uint8_t * const pucBuffer,
                                           size_t xBufferSizeBytes,
@@ -1425,3 +1898,77 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITERS == 1 )
+
+    BaseType_t xStreamBufferAttachWaiter( StreamBufferHandle_t xStreamBuffer,
+                                          WaiterHandle_t xWaiter,
+                                          uint32_t ulReadyBits )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxStreamBuffer->pxWaiter == NULL )
+            {
+                pxStreamBuffer->pxWaiter = xWaiter;
+                pxStreamBuffer->ulWaiterBits = ulReadyBits;
+
+                /* Data written before the stream buffer was added did not
+                 * notify the waiter. */
+                if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+                {
+                    vWaiterNotify( xWaiter, ulReadyBits );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITERS == 1 )
+
+    BaseType_t xStreamBufferDetachWaiter( StreamBufferHandle_t xStreamBuffer,
+                                          WaiterHandle_t xWaiter )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxStreamBuffer->pxWaiter == xWaiter )
+            {
+                pxStreamBuffer->pxWaiter = NULL;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITERS */
+/*-----------------------------------------------------------*/
@@ -39,6 +39,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "event_groups.h"
 #include "stack_macros.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
@@ -146,7 +147,7 @@
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_FROM_READY_LIST( uxTopPriority );                                          \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -176,7 +177,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_FROM_READY_LIST( uxTopPriority );                                            \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 /*-----------------------------------------------------------*/
@@ -212,16 +213,119 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+/*
+ * With configUSE_DELAYED_TASK_HEAP set to 1 the delayed lists are left
+ * unsorted and each one is shadowed by a pairing heap of the TCBs it holds,
+ * keyed on wake time.  Blocking is then O(1) instead of a vListInsert() walk
+ * inside a critical section, and removing the earliest (or any) task is
+ * O(log n) amortised.  The lists still record which tasks are blocked, so all
+ * code that only tests list membership is unchanged.
+ */
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+    #define taskGET_EARLIEST_DELAYED_TASK( pxList )    ( *prvDelayedHeapRoot( pxList ) )
+    #define taskINSERT_DELAYED_TASK( pxList, pxTCB )    prvDelayedHeapInsert( ( pxList ), ( pxTCB ) )
+    #define taskREMOVE_FROM_DELAYED_HEAP( pxTCB )       prvDelayedHeapRemove( pxTCB )
+#else
+    #define taskGET_EARLIEST_DELAYED_TASK( pxList )    ( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ) )
+    #define taskINSERT_DELAYED_TASK( pxList, pxTCB )    vListInsert( ( pxList ), &( ( pxTCB )->xStateListItem ) )
+    #define taskREMOVE_FROM_DELAYED_HEAP( pxTCB )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * With configUSE_EDF_SCHEDULER set to 1 the ready list at
+ * configEDF_TASK_PRIORITY is kept in earliest deadline first order and its
+ * head always runs, instead of its tasks sharing the processor round robin.
+ * Tasks above that priority still pre-empt every EDF task, and tasks below it
+ * only run while no EDF job is ready.  A task at the EDF priority that has no
+ * EDF parameters, for example one raised there by priority inheritance, runs
+ * before every EDF task.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* Deadlines are compared through their signed distance so the order holds
+ * across a tick count overflow. */
+    #define taskDEADLINE_IS_BEFORE( xA, xB )    ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
+    #define taskINSERT_INTO_READY_LIST( pxTCB )                                                                \
+    {                                                                                                          \
+        if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY )                                 \
+        {                                                                                                      \
+            prvAddTaskToEDFReadyList( pxTCB );                                                                 \
+        }                                                                                                      \
+        else                                                                                                   \
+        {                                                                                                      \
+            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                      \
+    }
+
+    #define taskSELECT_FROM_READY_LIST( uxTopPriority )                                                                  \
+    {                                                                                                                    \
+        if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_TASK_PRIORITY )                                               \
+        {                                                                                                                \
+            pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ); \
+        }                                                                                                                \
+        else                                                                                                             \
+        {                                                                                                                \
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );                    \
+        }                                                                                                                \
+    }
+
+/* An unblocked task pre-empts the running task if it has a higher priority
+ * or, with both at the EDF priority, an earlier deadline. */
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )                                     \
+    ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||                      \
+      ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&    \
+        ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) && \
+        ( prvEDFRunsBefore( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) ) )
+
+    #define taskIS_TIME_SLICED( uxPriority )    ( ( uxPriority ) != ( UBaseType_t ) configEDF_TASK_PRIORITY )
+
+#else /* configUSE_EDF_SCHEDULER */
+
+    #define taskINSERT_INTO_READY_LIST( pxTCB )            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+    #define taskSELECT_FROM_READY_LIST( uxTopPriority )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) )
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )             ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+    #define taskIS_TIME_SLICED( uxPriority )               pdTRUE
+
+#endif /* configUSE_EDF_SCHEDULER */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * With configUSE_EVENT_LIST_INDEX set to 1 the event list item of a task that
+ * waits on an EventList_t is inserted after the last waiting task of the same
+ * or a higher priority, which the index of the EventList_t gives directly up to
+ * 32 priorities, instead of walking the list.  Changing the priority of a waiting task moves
+ * its item so the index stays valid.  Event lists of event groups and the
+ * pending ready list are not indexed.
+ */
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+    #define taskEVENT_LIST_INSERT( pxEventList, pxEventListItem )       prvEventListInsert( ( pxEventList ), ( pxEventListItem ) )
+    #define taskEVENT_LIST_REMOVE( pxEventListItem )                    prvEventListRemove( pxEventListItem )
+    #define taskSET_EVENT_LIST_ITEM_VALUE( pxEventListItem, xValue )    prvEventListSetValue( ( pxEventListItem ), ( xValue ) )
+
+#else /* configUSE_EVENT_LIST_INDEX */
+
+    #define taskEVENT_LIST_INSERT( pxEventList, pxEventListItem )       vListInsert( ( pxEventList ), ( pxEventListItem ) )
+    #define taskEVENT_LIST_REMOVE( pxEventListItem )                    listREMOVE_ITEM( pxEventListItem )
+    #define taskSET_EVENT_LIST_ITEM_VALUE( pxEventListItem, xValue )    listSET_LIST_ITEM_VALUE( ( pxEventListItem ), ( xValue ) )
+
+#endif /* configUSE_EVENT_LIST_INDEX */
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order at
+ * configEDF_TASK_PRIORITY.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
-    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+#define prvAddTaskToReadyList( pxTCB )                  \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );            \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority ); \
+    taskINSERT_INTO_READY_LIST( pxTCB );                \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -294,6 +398,11 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state. */
+        configRUN_TIME_COUNTER_TYPE ulRunTimeAtSnapshot; /*< ulRunTimeCounter when uxTaskGetRunTimeSnapshot() last ran. */
+        #if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+            configRUN_TIME_COUNTER_TYPE ulISRRunTimeCounter;    /*< Time spent in interrupts taken while the task was running.  Not included in ulRunTimeCounter. */
+            configRUN_TIME_COUNTER_TYPE ulISRRunTimeAtSnapshot; /*< ulISRRunTimeCounter when uxTaskGetRunTimeSnapshot() last ran. */
+        #endif
     #endif
 
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
@@ -318,6 +427,19 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        struct tskTaskControlBlock * pxDelayChild;   /*< First child in the delayed task heap. */
+        struct tskTaskControlBlock * pxDelaySibling; /*< Next sibling in the delayed task heap. */
+        struct tskTaskControlBlock * pxDelayPrev;    /*< Parent if this is a first child, else previous sibling.  NULL for the heap root. */
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        TickType_t xPeriod;           /*< Time between job releases, which the task passes to xTaskDelayUntil(). */
+        TickType_t xRelativeDeadline; /*< Deadline of each job relative to its release.  Zero if the task has no EDF parameters. */
+        TickType_t xAbsoluteDeadline; /*< Deadline of the current job, which orders the ready list at configEDF_TASK_PRIORITY. */
+        UBaseType_t uxDeadlineMisses; /*< Number of jobs that completed after their deadline. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -337,6 +459,11 @@ PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Del
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+    PRIVILEGED_DATA static TCB_t * pxDelayedTaskHeap1 = NULL; /*< Root of the wake time heap over xDelayedTaskList1. */
+    PRIVILEGED_DATA static TCB_t * pxDelayedTaskHeap2 = NULL; /*< Root of the wake time heap over xDelayedTaskList2. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -361,7 +488,11 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#else
+    PRIVILEGED_DATA static volatile portREADY_PRIORITIES_TYPE uxTopReadyPriority; /*< Bit map of the ready priorities, empty until the first task is created. */
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
@@ -391,6 +522,13 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
  * code working with debuggers that need to remove the static qualifier. */
     PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulSnapshotTime = 0UL;          /*< Holds ulTotalRunTime as it was when uxTaskGetRunTimeSnapshot() last ran. */
+
+    #if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulISREnterTime = 0UL;   /*< Holds the run time counter value when the outermost interrupt was entered. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulISRTimeInSlice = 0UL; /*< Interrupt time since ulTaskSwitchedInTime, which is not run time of the running task. */
+        PRIVILEGED_DATA static UBaseType_t uxISRNesting = 0U;
+    #endif
 
 #endif
 
@@ -457,6 +595,49 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * Pairing heap that orders the tasks of each delayed list by wake time.
+ * prvDelayedHeapRemove() does nothing if the task is not in a delayed list,
+ * so it can be called before any removal of xStateListItem.
+ */
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+    static TCB_t ** prvDelayedHeapRoot( const List_t * pxList ) PRIVILEGED_FUNCTION;
+    static void prvDelayedHeapInsert( List_t * pxList,
+                                      TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvDelayedHeapRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Earliest deadline first ordering of the ready list at
+ * configEDF_TASK_PRIORITY.  prvEDFRunsBefore() returns pdTRUE if pxTCB has to
+ * run before pxOther.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static BaseType_t prvEDFRunsBefore( const TCB_t * pxTCB,
+                                        const TCB_t * pxOther ) PRIVILEGED_FUNCTION;
+    static void prvAddTaskToEDFReadyList( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Insert an event list item into, or remove it from, the list of an
+ * EventList_t while keeping the index of the EventList_t up to date.
+ * prvEventListSetValue() sets the item value of an event list item, moving
+ * the item if it is in an indexed list.
+ */
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+    static void prvEventListInsert( List_t * const pxEventList,
+                                    ListItem_t * const pxEventListItem ) PRIVILEGED_FUNCTION;
+    static void prvEventListRemove( ListItem_t * const pxEventListItem ) PRIVILEGED_FUNCTION;
+    static void prvEventListSetValue( ListItem_t * const pxEventListItem,
+                                      TickType_t xValue ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -516,6 +697,25 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+/*
+ * Add the time since the running task was switched in, less any interrupt
+ * time taken out of it, to the run time of the running task, then start a new
+ * slice.  Called from the context switch or from a critical section.
+ */
+    static void prvUpdateRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills a TaskRunTimeSnapshot_t structure with the run time used by each task
+ * in pxList since the previous snapshot.
+ */
+    static UBaseType_t prvSnapshotTasksWithinSingleList( TaskRunTimeSnapshot_t * pxSnapshotArray,
+                                                         List_t * pxList,
+                                                         configRUN_TIME_COUNTER_TYPE ulElapsedTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -1091,7 +1291,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxNewTCB ) )
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1120,6 +1320,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
             /* Remove task from the ready/delayed list. */
+            taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
+
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -1132,7 +1334,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                taskEVENT_LIST_REMOVE( &( pxTCB->xEventListItem ) );
             }
             else
             {
@@ -1264,6 +1466,46 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             /* Update the wake time ready for the next call. */
             *pxPreviousWakeTime = xTimeToWake;
 
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                if( pxCurrentTCB->xRelativeDeadline != ( TickType_t ) 0 )
+                {
+                    /* The call completes the current job of an EDF task and
+                     * releases the next one at xTimeToWake, which is only the
+                     * next release if the task delays by its period. */
+                    configASSERT( xTimeIncrement == pxCurrentTCB->xPeriod );
+
+                    if( taskDEADLINE_IS_BEFORE( pxCurrentTCB->xAbsoluteDeadline, xConstTickCount ) )
+                    {
+                        traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+                        ( pxCurrentTCB->uxDeadlineMisses )++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxCurrentTCB->xAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xRelativeDeadline;
+
+                    if( ( xShouldDelay == pdFALSE ) && ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) )
+                    {
+                        /* The next job is already due, so the task stays ready
+                         * but moves to the place of its new deadline. */
+                        ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                        prvAddTaskToEDFReadyList( pxCurrentTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_EDF_SCHEDULER */
+
             if( xShouldDelay != pdFALSE )
             {
                 traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -1296,6 +1538,96 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    void vTaskSetEDFParameters( TaskHandle_t xTask,
+                                TickType_t xPeriod,
+                                TickType_t xRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+
+        /* Only constrained deadlines are supported, a zero deadline meaning
+         * the deadline is the end of the period. */
+        configASSERT( xPeriod > ( TickType_t ) 0 );
+        configASSERT( xRelativeDeadline <= xPeriod );
+
+        if( xRelativeDeadline == ( TickType_t ) 0 )
+        {
+            xRelativeDeadline = xPeriod;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* The first job is taken to be released now. */
+            pxTCB->xPeriod = xPeriod;
+            pxTCB->xRelativeDeadline = xRelativeDeadline;
+            pxTCB->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                /* Move the task to the place of its deadline, which may change
+                 * the task that should be running. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                prvAddTaskToEDFReadyList( pxTCB );
+
+                if( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTaskGetEDFDeadline( TaskHandle_t xTask )
+    {
+        TickType_t xReturn;
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = pxTCB->xAbsoluteDeadline;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetEDFDeadlineMisses( TaskHandle_t xTask )
+    {
+        UBaseType_t uxReturn;
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxDeadlineMisses;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
     void vTaskDelay( const TickType_t xTicksToDelay )
@@ -1613,7 +1945,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * being used for anything else. */
                 if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    taskSET_EVENT_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
                 else
                 {
@@ -1684,6 +2016,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
+            taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
+
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -1696,7 +2030,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                taskEVENT_LIST_REMOVE( &( pxTCB->xEventListItem ) );
             }
             else
             {
@@ -2128,14 +2462,12 @@ void vTaskSuspendAll( void )
         }
         #else
         {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
-
             /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
+             * variable is used as a bit map.  If bits other than the one for the
+             * idle priority are set then there are tasks that have a priority
              * above the idle priority that are in the Ready state.  This takes
              * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
+            if( portHAS_READY_PRIORITY_ABOVE_IDLE( uxTopReadyPriority ) )
             {
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
@@ -2200,6 +2532,7 @@ BaseType_t xTaskResumeAll( void )
                     pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
                     listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
                     portMEMORY_BARRIER();
+                    taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
 
@@ -2215,6 +2548,14 @@ BaseType_t xTaskResumeAll( void )
                     }
                 }
 
+                #if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+                {
+                    /* Apply event group bits that were set by interrupts while
+                     * the scheduler was suspended. */
+                    vEventGroupProcessPendingBits();
+                }
+                #endif
+
                 if( pxTCB != NULL )
                 {
                     /* A task was unblocked while the scheduler was suspended,
@@ -2657,6 +2998,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 /* Remove the reference to the task from the blocked list.  An
                  * interrupt won't touch the xStateListItem because the
                  * scheduler is suspended. */
+                taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
                 ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 
                 /* Is the task waiting on an event also?  If so remove it from
@@ -2667,7 +3009,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 {
                     if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
                     {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                        taskEVENT_LIST_REMOVE( &( pxTCB->xEventListItem ) );
 
                         /* This lets the task know it was forcibly removed from the
                          * blocked state so it should not re-evaluate its block time and
@@ -2691,7 +3033,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                     /* Preemption is on, but a context switch should only be
                      * performed if the unblocked task has a priority that is
                      * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* Pend the yield to be performed when the scheduler
                          * is unsuspended. */
@@ -2771,7 +3113,7 @@ BaseType_t xTaskIncrementTick( void )
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
                      * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    pxTCB = taskGET_EARLIEST_DELAYED_TASK( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -2790,13 +3132,14 @@ BaseType_t xTaskIncrementTick( void )
                     }
 
                     /* It is time to remove the item from the Blocked state. */
+                    taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
                     /* Is the task waiting on an event also?  If so remove
                      * it from the event list. */
                     if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
                     {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        taskEVENT_LIST_REMOVE( &( pxTCB->xEventListItem ) );
                     }
                     else
                     {
@@ -2819,7 +3162,7 @@ BaseType_t xTaskIncrementTick( void )
                          * processing time (which happens when both
                          * preemption and time slicing are on) is
                          * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             xSwitchRequired = pdTRUE;
                         }
@@ -2838,7 +3181,8 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                ( taskIS_TIME_SLICED( pxCurrentTCB->uxPriority ) != pdFALSE ) )
             {
                 xSwitchRequired = pdTRUE;
             }
@@ -3021,29 +3365,7 @@ void vTaskSwitchContext( void )
 
         #if ( configGENERATE_RUN_TIME_STATS == 1 )
         {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
-
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
-            {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            ulTaskSwitchedInTime = ulTotalRunTime;
+            prvUpdateRunTimeCounter();
         }
         #endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -3080,6 +3402,21 @@ void vTaskSwitchContext( void )
 }
 /*-----------------------------------------------------------*/
 
+void vTaskEventListInitialise( EventList_t * const pxEventList )
+{
+    configASSERT( pxEventList );
+
+    vListInitialise( &( pxEventList->xList ) );
+
+    #if ( configUSE_EVENT_LIST_INDEX == 1 )
+    {
+        /* The last item of a slot is only read while its bit is set. */
+        pxEventList->ulWaitingSlots = 0U;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnEventList( List_t * const pxEventList,
                             const TickType_t xTicksToWait )
 {
@@ -3099,7 +3436,7 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
      *
      * The queue that contains the event list is locked, preventing
      * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    taskEVENT_LIST_INSERT( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 }
@@ -3148,8 +3485,17 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
         /* Place the event list item of the TCB in the appropriate event list.
          * In this case it is assume that this is the only task that is going to
          * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+         * can be used in place of vListInsert.  An indexed list inserts in
+         * constant time anyway, and has to keep its index up to date. */
+        #if ( configUSE_EVENT_LIST_INDEX == 1 )
+        {
+            prvEventListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+        #else
+        {
+            listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+        #endif
 
         /* If the task should block indefinitely then set the block time to a
          * value that will be recognised as an indefinite delay inside the
@@ -3186,10 +3532,11 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
      * pxEventList is not empty. */
     pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
     configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    taskEVENT_LIST_REMOVE( &( pxUnblockedTCB->xEventListItem ) );
 
     if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
     {
+        taskREMOVE_FROM_DELAYED_HEAP( pxUnblockedTCB );
         listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
         prvAddTaskToReadyList( pxUnblockedTCB );
 
@@ -3214,7 +3561,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
     {
         /* Return true if the task removed from the event list has a higher
          * priority than the calling task.  This allows the calling task to know if
@@ -3269,10 +3616,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     /* Remove the task from the delayed list and add it to the ready list.  The
      * scheduler is suspended so interrupts will not be accessing the ready
      * lists. */
+    taskREMOVE_FROM_DELAYED_HEAP( pxUnblockedTCB );
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -3283,6 +3631,57 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_ISR_FAST_PATH == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, WHICH CAN BE
+         * WITHIN AN ISR, WITH THE SCHEDULER NOT SUSPENDED.  It is used by the
+         * event flags implementation to unblock tasks from an interrupt.  As
+         * the scheduler is not suspended no task is part way through
+         * updating the event list or the ready lists. */
+        configASSERT( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE );
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        taskREMOVE_FROM_DELAYED_HEAP( pxUnblockedTCB );
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* See the comment in xTaskRemoveFromEventList(). */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
+        {
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter. */
+            xReturn = pdTRUE;
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_ISR_FAST_PATH */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     configASSERT( pxTimeOut );
@@ -3996,6 +4395,65 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    static void prvUpdateRunTimeCounter( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulSliceTime;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+        #else
+            ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* Add the amount of time the task has been running to the
+         * accumulated time so far.  The time the task started running was
+         * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+         * protection here so count values are only valid until the timer
+         * overflows, which in practice means configRUN_TIME_COUNTER_TYPE has to
+         * be 64 bits wide for a fast counter.  The guard against negative
+         * values is to protect against suspect run time stat counter
+         * implementations - which are provided by the application, not the
+         * kernel. */
+        if( ulTotalRunTime > ulTaskSwitchedInTime )
+        {
+            ulSliceTime = ulTotalRunTime - ulTaskSwitchedInTime;
+
+            #if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+            {
+                /* Interrupts taken during the slice have already been added
+                 * to ulISRRunTimeCounter. */
+                if( ulSliceTime > ulISRTimeInSlice )
+                {
+                    ulSliceTime -= ulISRTimeInSlice;
+                }
+                else
+                {
+                    ulSliceTime = 0;
+                }
+            }
+            #endif
+
+            pxCurrentTCB->ulRunTimeCounter += ulSliceTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+        {
+            ulISRTimeInSlice = 0;
+        }
+        #endif
+
+        ulTaskSwitchedInTime = ulTotalRunTime;
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
     if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
@@ -4012,7 +4470,7 @@ static void prvResetNextTaskUnblockTime( void )
          * the item at the head of the delayed list.  This is the time at
          * which the task at the head of the delayed list should be removed
          * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( taskGET_EARLIEST_DELAYED_TASK( pxDelayedTaskList )->xStateListItem ) );
     }
 }
 /*-----------------------------------------------------------*/
@@ -4084,7 +4542,7 @@ static void prvResetNextTaskUnblockTime( void )
                  * not being used for anything else. */
                 if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    taskSET_EVENT_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
                 else
                 {
@@ -4285,7 +4743,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * being used for anything else. */
                     if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                     {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        taskSET_EVENT_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                     }
                     else
                     {
@@ -4686,13 +5144,184 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
 
-    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
-                                      BaseType_t xClearCountOnExit,
-                                      TickType_t xTicksToWait )
+    void vTaskDecrementMutexHeldCount( void )
     {
-        uint32_t ulReturn;
+        /* Only the task itself changes its mutex held count, so no critical
+         * section is needed. */
+        if( pxCurrentTCB != NULL )
+        {
+            configASSERT( pxCurrentTCB->uxMutexesHeld );
+            ( pxCurrentTCB->uxMutexesHeld )--;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPriorityIsInherited( void )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* The priority can still be raised after this check by a task that
+         * blocks on a mutex this task holds.  If that is the mutex being given
+         * it carries the waiters tag and its compare and swap fails, otherwise
+         * this task keeps holding a mutex and xTaskPriorityDisinherit() would
+         * not have restored the base priority either. */
+        if( ( pxCurrentTCB != NULL ) && ( pxCurrentTCB->uxPriority != pxCurrentTCB->uxBasePriority ) )
+        {
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    static void prvSetRunningTaskPriority( TCB_t * const pxTCB,
+                                           UBaseType_t uxNewPriority )
+    {
+        /* The task is running, so it is in the ready list of its current
+         * priority and its event list item is not in use. */
+        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+        {
+            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->uxPriority = uxNewPriority;
+        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        prvAddTaskToReadyList( pxTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        const UBaseType_t uxPriorityOnEntry = pxTCB->uxPriority;
+
+        /* Called from a critical section by the task that has just taken the
+         * mutex.  Every task that takes the mutex must have a base priority at
+         * or below its ceiling, otherwise it can still be blocked by the holder
+         * and the protocol gives no bound. */
+        configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+        /* A priority inherited from another mutex may already be higher. */
+        if( uxCeilingPriority > uxPriorityOnEntry )
+        {
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+            prvSetRunningTaskPriority( pxTCB, uxCeilingPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxPriorityOnEntry;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPriorityRestoreFromCeiling( UBaseType_t uxCeilingPriority,
+                                                UBaseType_t uxPriorityBeforeCeiling )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        UBaseType_t uxNewPriority, uxTopPriority;
+        BaseType_t xReturn = pdFALSE;
+
+        /* The mutex is given by its holder, which is the running task. */
+        configASSERT( pxTCB->uxMutexesHeld );
+        ( pxTCB->uxMutexesHeld )--;
+
+        if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+        {
+            /* Nothing held any more can keep the task above its base
+             * priority. */
+            uxNewPriority = pxTCB->uxBasePriority;
+        }
+        else if( pxTCB->uxPriority == uxCeilingPriority )
+        {
+            /* Back to the priority the task ran at when it took the mutex,
+             * which is the ceiling of the next mutex out when they are nested.
+             * The base priority may have been raised since. */
+            if( uxPriorityBeforeCeiling > pxTCB->uxBasePriority )
+            {
+                uxNewPriority = uxPriorityBeforeCeiling;
+            }
+            else
+            {
+                uxNewPriority = pxTCB->uxBasePriority;
+            }
+        }
+        else
+        {
+            /* Another mutex raised the task above this ceiling, and will drop
+             * it again when it is given. */
+            uxNewPriority = pxTCB->uxPriority;
+        }
+
+        if( uxNewPriority != pxTCB->uxPriority )
+        {
+            traceTASK_PRIORITY_DISINHERIT( pxTCB, uxNewPriority );
+            prvSetRunningTaskPriority( pxTCB, uxNewPriority );
+
+            /* The highest ready priority, found as the next context switch
+             * would.  This task is ready at uxNewPriority, so there is one. */
+            #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+            {
+                /* uxTopReadyPriority is only lowered when a task is selected,
+                 * so lower it here and leave the next selection nothing to
+                 * scan. */
+                uxTopPriority = uxTopReadyPriority;
+
+                while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) != pdFALSE )
+                {
+                    --uxTopPriority;
+                }
+
+                uxTopReadyPriority = uxTopPriority;
+            }
+            #else
+            {
+                portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+            }
+            #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+            /* Switch only to a task that became ready above the new priority
+             * while this one ran at the ceiling.  A yield to a task of the
+             * same priority would let it run into the mutexes this task still
+             * holds. */
+            if( uxTopPriority > uxNewPriority )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
+                                      BaseType_t xClearCountOnExit,
+                                      TickType_t xTicksToWait )
+    {
+        uint32_t ulReturn;
 
         configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
@@ -4921,6 +5550,7 @@ TickType_t uxTaskResetEventItemValue( void )
              * notification then unblock it now. */
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
+                taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
                 listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                 prvAddTaskToReadyList( pxTCB );
 
@@ -4943,7 +5573,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5068,6 +5698,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
+                    taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
                 }
@@ -5078,7 +5709,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5159,6 +5790,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
+                    taskREMOVE_FROM_DELAYED_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
                 }
@@ -5169,7 +5801,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5294,6 +5926,216 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+
+    void vTaskRunTimeISREnter( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( uxISRNesting == ( UBaseType_t ) 0U )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulISREnterTime );
+                #else
+                    ulISREnterTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxISRNesting++;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configRUN_TIME_STATS_ISR_ATTRIBUTION */
+/*-----------------------------------------------------------*/
+
+#if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+
+    void vTaskRunTimeISRExit( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        configRUN_TIME_COUNTER_TYPE ulNow, ulISRTime;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            configASSERT( uxISRNesting > ( UBaseType_t ) 0U );
+            uxISRNesting--;
+
+            if( uxISRNesting == ( UBaseType_t ) 0U )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+                #else
+                    ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* pxCurrentTCB is NULL if an interrupt runs before the first
+                 * task is created. */
+                if( ( ulNow > ulISREnterTime ) && ( pxCurrentTCB != NULL ) )
+                {
+                    ulISRTime = ulNow - ulISREnterTime;
+                    pxCurrentTCB->ulISRRunTimeCounter += ulISRTime;
+                    ulISRTimeInSlice += ulISRTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configRUN_TIME_STATS_ISR_ATTRIBUTION */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTimeSnapshot_t * const pxSnapshotArray,
+                                          const UBaseType_t uxArraySize,
+                                          configRUN_TIME_COUNTER_TYPE * const pulElapsedTime )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        configRUN_TIME_COUNTER_TYPE ulElapsedTime = 0;
+
+        configASSERT( pxSnapshotArray != NULL );
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                /* Bring the calling task's run time up to date so the deltas
+                 * add up to the elapsed time. */
+                taskENTER_CRITICAL();
+                {
+                    prvUpdateRunTimeCounter();
+                    ulElapsedTime = ulTotalRunTime - ulSnapshotTime;
+                    ulSnapshotTime = ulTotalRunTime;
+                }
+                taskEXIT_CRITICAL();
+
+                do
+                {
+                    uxQueue--;
+                    uxTask += prvSnapshotTasksWithinSingleList( &( pxSnapshotArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), ulElapsedTime );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                uxTask += prvSnapshotTasksWithinSingleList( &( pxSnapshotArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, ulElapsedTime );
+                uxTask += prvSnapshotTasksWithinSingleList( &( pxSnapshotArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, ulElapsedTime );
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    uxTask += prvSnapshotTasksWithinSingleList( &( pxSnapshotArray[ uxTask ] ), &xTasksWaitingTermination, ulElapsedTime );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    uxTask += prvSnapshotTasksWithinSingleList( &( pxSnapshotArray[ uxTask ] ), &xSuspendedTaskList, ulElapsedTime );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( pulElapsedTime != NULL )
+        {
+            *pulElapsedTime = ulElapsedTime;
+        }
+
+        return uxTask;
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    static UBaseType_t prvSnapshotTasksWithinSingleList( TaskRunTimeSnapshot_t * pxSnapshotArray,
+                                                         List_t * pxList,
+                                                         configRUN_TIME_COUNTER_TYPE ulElapsedTime )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+        TaskRunTimeSnapshot_t * pxSnapshot;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                pxSnapshot = &( pxSnapshotArray[ uxTask ] );
+
+                pxSnapshot->xHandle = ( TaskHandle_t ) pxNextTCB;
+                pxSnapshot->pcTaskName = ( const char * ) &( pxNextTCB->pcTaskName[ 0 ] );
+
+                /* The scheduler is suspended, so only interrupts can change
+                 * the counters, and only the ISR counter of the calling task. */
+                pxSnapshot->ulRunTime = pxNextTCB->ulRunTimeCounter - pxNextTCB->ulRunTimeAtSnapshot;
+                pxNextTCB->ulRunTimeAtSnapshot = pxNextTCB->ulRunTimeCounter;
+
+                #if ( configRUN_TIME_STATS_ISR_ATTRIBUTION == 1 )
+                {
+                    configRUN_TIME_COUNTER_TYPE ulISRRunTimeCounter;
+
+                    taskENTER_CRITICAL();
+                    {
+                        ulISRRunTimeCounter = pxNextTCB->ulISRRunTimeCounter;
+                    }
+                    taskEXIT_CRITICAL();
+
+                    pxSnapshot->ulISRTime = ulISRRunTimeCounter - pxNextTCB->ulISRRunTimeAtSnapshot;
+                    pxNextTCB->ulISRRunTimeAtSnapshot = ulISRRunTimeCounter;
+                }
+                #else
+                {
+                    pxSnapshot->ulISRTime = 0;
+                }
+                #endif
+
+                if( ulElapsedTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+                {
+                    pxSnapshot->usCPUUsage = ( uint16_t ) ( ( ( uint64_t ) pxSnapshot->ulRunTime * 10000ULL ) / ( uint64_t ) ulElapsedTime );
+                    pxSnapshot->usISRUsage = ( uint16_t ) ( ( ( uint64_t ) pxSnapshot->ulISRTime * 10000ULL ) / ( uint64_t ) ulElapsedTime );
+                }
+                else
+                {
+                    pxSnapshot->usCPUUsage = 0;
+                    pxSnapshot->usISRUsage = 0;
+                }
+
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxTask;
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
@@ -5345,13 +6187,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             {
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxOverflowDelayedTaskList, pxCurrentTCB );
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxDelayedTaskList, pxCurrentTCB );
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5380,12 +6222,12 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxOverflowDelayedTaskList, pxCurrentTCB );
         }
         else
         {
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxDelayedTaskList, pxCurrentTCB );
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -5406,6 +6248,411 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     #endif /* INCLUDE_vTaskSuspend */
 }
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+    static TCB_t ** prvDelayedHeapRoot( const List_t * pxList )
+    {
+        /* Each heap belongs to a list rather than to the current/overflow
+         * role, so taskSWITCH_DELAYED_LISTS() swaps the heaps along with the
+         * list pointers. */
+        return ( pxList == &xDelayedTaskList1 ) ? &pxDelayedTaskHeap1 : &pxDelayedTaskHeap2;
+    }
+/*-----------------------------------------------------------*/
+
+/* Link two detached heap roots, the later waking one becoming the first
+ * child of the other. */
+    static TCB_t * prvDelayedHeapMeld( TCB_t * pxA,
+                                       TCB_t * pxB )
+    {
+        TCB_t * pxTemp;
+
+        if( pxA == NULL )
+        {
+            return pxB;
+        }
+
+        if( pxB == NULL )
+        {
+            return pxA;
+        }
+
+        if( listGET_LIST_ITEM_VALUE( &( pxB->xStateListItem ) ) < listGET_LIST_ITEM_VALUE( &( pxA->xStateListItem ) ) )
+        {
+            pxTemp = pxA;
+            pxA = pxB;
+            pxB = pxTemp;
+        }
+
+        pxB->pxDelayPrev = pxA;
+        pxB->pxDelaySibling = pxA->pxDelayChild;
+
+        if( pxA->pxDelayChild != NULL )
+        {
+            pxA->pxDelayChild->pxDelayPrev = pxB;
+        }
+
+        pxA->pxDelayChild = pxB;
+
+        return pxA;
+    }
+/*-----------------------------------------------------------*/
+
+/* Standard two pass pairing of a sibling chain, done iteratively so the
+ * stack usage is bounded regardless of the number of delayed tasks. */
+    static TCB_t * prvDelayedHeapMergePairs( TCB_t * pxFirst )
+    {
+        TCB_t * pxA;
+        TCB_t * pxB;
+        TCB_t * pxNext;
+        TCB_t * pxPairs = NULL;
+        TCB_t * pxResult = NULL;
+
+        /* Left to right, meld adjacent siblings and stack each result on a
+         * reversed chain. */
+        while( pxFirst != NULL )
+        {
+            pxA = pxFirst;
+            pxB = pxA->pxDelaySibling;
+            pxNext = ( pxB != NULL ) ? pxB->pxDelaySibling : NULL;
+
+            pxA->pxDelaySibling = NULL;
+            pxA->pxDelayPrev = NULL;
+
+            if( pxB != NULL )
+            {
+                pxB->pxDelaySibling = NULL;
+                pxB->pxDelayPrev = NULL;
+            }
+
+            pxA = prvDelayedHeapMeld( pxA, pxB );
+            pxA->pxDelaySibling = pxPairs;
+            pxPairs = pxA;
+            pxFirst = pxNext;
+        }
+
+        /* Right to left, meld the pairs into a single heap. */
+        while( pxPairs != NULL )
+        {
+            pxNext = pxPairs->pxDelaySibling;
+            pxPairs->pxDelaySibling = NULL;
+            pxResult = prvDelayedHeapMeld( pxResult, pxPairs );
+            pxPairs = pxNext;
+        }
+
+        return pxResult;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedHeapInsert( List_t * pxList,
+                                      TCB_t * pxTCB )
+    {
+        TCB_t ** ppxRoot = prvDelayedHeapRoot( pxList );
+
+        /* The list only records membership, so append in O(1).  The wake
+         * time must already be set as the item value. */
+        listINSERT_END( pxList, &( pxTCB->xStateListItem ) );
+
+        pxTCB->pxDelayChild = NULL;
+        pxTCB->pxDelaySibling = NULL;
+        pxTCB->pxDelayPrev = NULL;
+        *ppxRoot = prvDelayedHeapMeld( *ppxRoot, pxTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedHeapRemove( TCB_t * pxTCB )
+    {
+        const List_t * pxList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+        TCB_t ** ppxRoot;
+        TCB_t * pxChildren;
+
+        if( ( pxList != &xDelayedTaskList1 ) && ( pxList != &xDelayedTaskList2 ) )
+        {
+            /* Ready, suspended or pending - not in a heap. */
+            return;
+        }
+
+        ppxRoot = prvDelayedHeapRoot( pxList );
+        pxChildren = prvDelayedHeapMergePairs( pxTCB->pxDelayChild );
+
+        if( *ppxRoot == pxTCB )
+        {
+            *ppxRoot = pxChildren;
+        }
+        else
+        {
+            /* Unlink from the parent or previous sibling, then meld the
+             * orphaned subtree back into the heap. */
+            if( pxTCB->pxDelayPrev->pxDelayChild == pxTCB )
+            {
+                pxTCB->pxDelayPrev->pxDelayChild = pxTCB->pxDelaySibling;
+            }
+            else
+            {
+                pxTCB->pxDelayPrev->pxDelaySibling = pxTCB->pxDelaySibling;
+            }
+
+            if( pxTCB->pxDelaySibling != NULL )
+            {
+                pxTCB->pxDelaySibling->pxDelayPrev = pxTCB->pxDelayPrev;
+            }
+
+            *ppxRoot = prvDelayedHeapMeld( *ppxRoot, pxChildren );
+        }
+
+        pxTCB->pxDelayChild = NULL;
+        pxTCB->pxDelaySibling = NULL;
+        pxTCB->pxDelayPrev = NULL;
+    }
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static BaseType_t prvEDFRunsBefore( const TCB_t * pxTCB,
+                                        const TCB_t * pxOther )
+    {
+        BaseType_t xReturn;
+
+        if( pxOther->xRelativeDeadline == ( TickType_t ) 0 )
+        {
+            /* Tasks without EDF parameters run first, in the order they
+             * became ready. */
+            xReturn = pdFALSE;
+        }
+        else if( pxTCB->xRelativeDeadline == ( TickType_t ) 0 )
+        {
+            xReturn = pdTRUE;
+        }
+        else if( taskDEADLINE_IS_BEFORE( pxTCB->xAbsoluteDeadline, pxOther->xAbsoluteDeadline ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddTaskToEDFReadyList( TCB_t * pxTCB )
+    {
+        List_t * const pxList = &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] );
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        ListItem_t * pxIterator;
+
+        listTEST_LIST_INTEGRITY( pxList );
+        listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
+
+        /* Skip every task that runs before this one, so tasks with equal
+         * deadlines keep the order they became ready in.  The walk is linear
+         * in the number of ready EDF tasks. */
+        pxIterator = listGET_HEAD_ENTRY( pxList );
+
+        while( ( pxIterator != listGET_END_MARKER( pxList ) ) &&
+               ( prvEDFRunsBefore( pxTCB, listGET_LIST_ITEM_OWNER( pxIterator ) ) == pdFALSE ) )
+        {
+            pxIterator = listGET_NEXT( pxIterator );
+        }
+
+        /* Insert the task in front of pxIterator. */
+        pxNewListItem->pxNext = pxIterator;
+        pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+        pxIterator->pxPrevious->pxNext = pxNewListItem;
+        pxIterator->pxPrevious = pxNewListItem;
+
+        /* Remember which list the item is in. */
+        pxNewListItem->pxContainer = pxList;
+
+        ( pxList->uxNumberOfItems )++;
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+/* The item value of an event list item is configMAX_PRIORITIES less the
+ * priority of the task, so slot 0 holds the highest priorities and the list is
+ * in ascending slot order. */
+    #define taskEVENT_LIST_SLOT( xValue )    ( ( ( UBaseType_t ) ( xValue ) - ( UBaseType_t ) 1U ) / ( UBaseType_t ) tskEVENT_LIST_PRIORITIES_PER_SLOT )
+
+/* The highest slot set in a word of slots.  Above 32 priorities the ready
+ * priorities are no longer a single word, so the port provides a separate
+ * macro for one word of its bit map. */
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES <= 32 )
+        #define taskGET_HIGHEST_SLOT( uxSlot, ulSlots )    portGET_HIGHEST_PRIORITY( uxSlot, ulSlots )
+    #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        #define taskGET_HIGHEST_SLOT( uxSlot, ulSlots )    portGET_HIGHEST_SET_BIT( uxSlot, ulSlots )
+    #else
+        #define taskGET_HIGHEST_SLOT( uxSlot, ulSlots )                            \
+        {                                                                          \
+            ( uxSlot ) = ( UBaseType_t ) tskEVENT_LIST_SLOTS - ( UBaseType_t ) 1U; \
+                                                                                   \
+            while( ( ( ulSlots ) & ( ( uint32_t ) 1U << ( uxSlot ) ) ) == 0U )     \
+            {                                                                      \
+                ( uxSlot )--;                                                      \
+            }                                                                      \
+        }
+    #endif
+
+/* Only the items of ordered event lists carry a priority based value. */
+    #define taskIS_INDEXED_EVENT_LIST_ITEM( pxEventListItem )                 \
+    ( ( listLIST_ITEM_CONTAINER( pxEventListItem ) != NULL ) &&               \
+      ( listLIST_ITEM_CONTAINER( pxEventListItem ) != &xPendingReadyList ) && \
+      ( ( listGET_LIST_ITEM_VALUE( pxEventListItem ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL ) )
+
+    static void prvEventListInsert( List_t * const pxEventList,
+                                    ListItem_t * const pxEventListItem )
+    {
+        EventList_t * const pxIndexedList = ( EventList_t * ) pxEventList; /*lint !e9087 !e740 xList is the first member of an EventList_t. */
+        const TickType_t xValue = listGET_LIST_ITEM_VALUE( pxEventListItem );
+        const UBaseType_t uxSlot = taskEVENT_LIST_SLOT( xValue );
+        const uint32_t ulSlotBit = ( uint32_t ) 1U << uxSlot;
+        uint32_t ulSlotsBefore;
+        UBaseType_t uxPreviousSlot;
+        ListItem_t * pxPrevious;
+        BaseType_t xLastOfSlot;
+
+        configASSERT( uxSlot < ( UBaseType_t ) tskEVENT_LIST_SLOTS );
+        listTEST_LIST_INTEGRITY( pxEventList );
+        listTEST_LIST_ITEM_INTEGRITY( pxEventListItem );
+
+        /* The new item goes after the last item of its slot if that is of the
+         * same or a higher priority, so tasks of equal priority stay in the
+         * order they blocked in.  With one priority per slot that is always
+         * the case when the slot is occupied. */
+        if( ( ( pxIndexedList->ulWaitingSlots & ulSlotBit ) != 0U ) &&
+            ( listGET_LIST_ITEM_VALUE( pxIndexedList->pxLastOfSlot[ uxSlot ] ) <= xValue ) )
+        {
+            pxPrevious = pxIndexedList->pxLastOfSlot[ uxSlot ];
+            xLastOfSlot = pdTRUE;
+        }
+        else
+        {
+            /* Otherwise it goes after the last item of the highest occupied
+             * slot before its own, or at the head if there is no such slot. */
+            ulSlotsBefore = pxIndexedList->ulWaitingSlots & ( ulSlotBit - 1U );
+
+            if( ulSlotsBefore != 0U )
+            {
+                taskGET_HIGHEST_SLOT( uxPreviousSlot, ulSlotsBefore );
+                pxPrevious = pxIndexedList->pxLastOfSlot[ uxPreviousSlot ];
+            }
+            else
+            {
+                pxPrevious = ( ListItem_t * ) listGET_END_MARKER( pxEventList );
+            }
+
+            #if ( tskEVENT_LIST_PRIORITIES_PER_SLOT > 1 )
+            {
+                /* Then past the items of its slot of the same or a higher
+                 * priority.  The end marker stops the walk as its value is
+                 * portMAX_DELAY. */
+                while( listGET_LIST_ITEM_VALUE( pxPrevious->pxNext ) <= xValue )
+                {
+                    pxPrevious = pxPrevious->pxNext;
+                }
+            }
+            #endif
+
+            if( ( pxIndexedList->ulWaitingSlots & ulSlotBit ) == 0U )
+            {
+                xLastOfSlot = pdTRUE;
+            }
+            else
+            {
+                xLastOfSlot = pdFALSE;
+            }
+        }
+
+        pxEventListItem->pxNext = pxPrevious->pxNext;
+        pxEventListItem->pxPrevious = pxPrevious;
+        pxPrevious->pxNext->pxPrevious = pxEventListItem;
+        pxPrevious->pxNext = pxEventListItem;
+
+        /* Remember which list the item is in. */
+        pxEventListItem->pxContainer = pxEventList;
+
+        ( pxEventList->uxNumberOfItems )++;
+
+        if( xLastOfSlot != pdFALSE )
+        {
+            pxIndexedList->pxLastOfSlot[ uxSlot ] = pxEventListItem;
+            pxIndexedList->ulWaitingSlots |= ulSlotBit;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEventListRemove( ListItem_t * const pxEventListItem )
+    {
+        EventList_t * pxIndexedList;
+        TickType_t xValue;
+        UBaseType_t uxSlot;
+
+        if( taskIS_INDEXED_EVENT_LIST_ITEM( pxEventListItem ) )
+        {
+            pxIndexedList = ( EventList_t * ) listLIST_ITEM_CONTAINER( pxEventListItem ); /*lint !e9087 !e740 xList is the first member of an EventList_t. */
+            xValue = listGET_LIST_ITEM_VALUE( pxEventListItem );
+            uxSlot = taskEVENT_LIST_SLOT( xValue );
+
+            /* The last item of a slot hands over to the item before it if that
+             * is in the same slot.  The end marker never is, as its value is
+             * portMAX_DELAY. */
+            if( pxIndexedList->pxLastOfSlot[ uxSlot ] == pxEventListItem )
+            {
+                if( taskEVENT_LIST_SLOT( listGET_LIST_ITEM_VALUE( pxEventListItem->pxPrevious ) ) == uxSlot )
+                {
+                    pxIndexedList->pxLastOfSlot[ uxSlot ] = pxEventListItem->pxPrevious;
+                }
+                else
+                {
+                    pxIndexedList->ulWaitingSlots &= ~( ( uint32_t ) 1U << uxSlot );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listREMOVE_ITEM( pxEventListItem );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEventListSetValue( ListItem_t * const pxEventListItem,
+                                      TickType_t xValue )
+    {
+        List_t * pxEventList;
+
+        /* A waiting task whose priority changes moves to the place in the list
+         * for its new priority. */
+        if( taskIS_INDEXED_EVENT_LIST_ITEM( pxEventListItem ) )
+        {
+            pxEventList = listLIST_ITEM_CONTAINER( pxEventListItem );
+            prvEventListRemove( pxEventListItem );
+            listSET_LIST_ITEM_VALUE( pxEventListItem, xValue );
+            prvEventListInsert( pxEventList, pxEventListItem );
+        }
+        else
+        {
+            listSET_LIST_ITEM_VALUE( pxEventListItem, xValue );
+        }
+    }
+
+#endif /* configUSE_EVENT_LIST_INDEX */
+/*-----------------------------------------------------------*/
+
 /* Code below here allows additional code to be inserted into this source file,
  * especially where access to file scope functions and data is needed (for example
  * when performing module tests). */
@@ -71,6 +71,29 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+/* Geometry of the hierarchical timing wheel used when configUSE_TIMER_WHEEL
+ * is 1.  Level N slot S holds the timers whose expiry time, shifted right by
+ * N * configTIMER_WHEEL_SLOT_BITS, has S in its low bits. */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        #define tmrWHEEL_SLOTS                   ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK               ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_SHIFT( uxLevel )        ( ( uxLevel ) * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+
+        #if ( ( configTIMER_WHEEL_LEVELS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS < 1 ) )
+            #error configTIMER_WHEEL_LEVELS and configTIMER_WHEEL_SLOT_BITS must both be at least 1.
+        #endif
+
+        #if ( configUSE_16_BIT_TICKS == 1 )
+            #if ( ( configTIMER_WHEEL_LEVELS * configTIMER_WHEEL_SLOT_BITS ) > 16 )
+                #error The timing wheel spans more bits than TickType_t holds.  Reduce configTIMER_WHEEL_LEVELS or configTIMER_WHEEL_SLOT_BITS.
+            #endif
+        #else
+            #if ( ( configTIMER_WHEEL_LEVELS * configTIMER_WHEEL_SLOT_BITS ) > 32 )
+                #error The timing wheel spans more bits than TickType_t holds.  Reduce configTIMER_WHEEL_LEVELS or configTIMER_WHEEL_SLOT_BITS.
+            #endif
+        #endif
+    #endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -134,10 +157,26 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 0 )
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #else
+
+/* When the timing wheel is used the active timers are held in unordered slot
+ * lists instead, so starting, stopping and resetting a timer are O(1)
+ * regardless of how many timers are active.  xTimerWheelTime is the last tick
+ * the wheel has been advanced to, and every timer in the wheel expires after
+ * it.  Timers whose expiry tick has been reached are moved to xTimerWheelDueList
+ * from where the daemon processes them one at a time, exactly as it processes
+ * the head of the sorted list when the wheel is not used.  Only the timer
+ * service task is allowed to access these. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+        PRIVILEGED_DATA static List_t xTimerWheelDueList;
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+        PRIVILEGED_DATA static UBaseType_t uxTimerWheelCount = ( UBaseType_t ) 0U;
+    #endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -191,11 +230,51 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+        static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+    #else
+
+/*
+ * Add an active timer to the timing wheel.  The timer's list item value must
+ * already hold its expiry time, which must be after xTimerWheelTime.
+ */
+        static void prvTimerWheelInsert( Timer_t * const pxTimer,
+                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a timer in the wheel slot that matches its expiry time relative to
+ * xBaseTime.  Used both for new timers and when cascading a slot of a higher
+ * level down to the lower levels.
+ */
+        static void prvTimerWheelPlace( Timer_t * const pxTimer,
+                                        const TickType_t xBaseTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a timer from the wheel, or from the list of timers that are due.
+ */
+        static void prvTimerWheelRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the tick, after xTimerWheelTime, at which the wheel next has to do
+ * some work - either a level 0 slot holding timers is reached or a slot of a
+ * higher level has to be cascaded.
+ */
+        static TickType_t prvTimerWheelNextEventTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Advance the wheel to xEventTime, which must have been returned by
+ * prvTimerWheelNextEventTime(), cascading the higher levels and moving the
+ * timers that expire at xEventTime onto the list of due timers.
+ */
+        static void prvTimerWheelAdvance( const TickType_t xEventTime ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -541,12 +620,20 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+            /* Remove the timer from the list of active timers.  A check has already
+             * been performed to ensure the list is not empty. */
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        #else
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTimerWheelDueList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Remove the timer from the list of due timers.  A check has
+             * already been performed to ensure the list is not empty. */
+            prvTimerWheelRemove( pxTimer );
+        #endif /* configUSE_TIMER_WHEEL */
 
         /* If the timer is an auto-reload timer then calculate the next
          * expiry time and re-insert the timer in the list of active timers. */
@@ -606,6 +693,7 @@
     {
         TickType_t xTimeNow;
         BaseType_t xTimerListsWereSwitched;
+        BaseType_t xTimerIsDue;
 
         vTaskSuspendAll();
         {
@@ -618,11 +706,42 @@
 
             if( xTimerListsWereSwitched == pdFALSE )
             {
-                /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    /* The tick count has not overflowed, has the timer expired? */
+                    xTimerIsDue = ( xNextExpireTime <= xTimeNow ) ? pdTRUE : pdFALSE;
+                }
+                #else
+                {
+                    /* The wheel never switches lists, so compare both times
+                     * relative to the tick the wheel was last advanced to.  That
+                     * keeps the comparison valid across a tick count overflow. */
+                    xTimerIsDue = ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) ? pdTRUE : pdFALSE;
+                }
+                #endif /* configUSE_TIMER_WHEEL */
+
+                if( ( xListWasEmpty == pdFALSE ) && ( xTimerIsDue != pdFALSE ) )
                 {
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        if( listLIST_IS_EMPTY( &xTimerWheelDueList ) == pdFALSE )
+                        {
+                            prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                        }
+                        else
+                        {
+                            /* No timer is due yet, but the wheel has reached a
+                             * slot that needs processing. */
+                            prvTimerWheelAdvance( xNextExpireTime );
+                        }
+                    }
+                    #else
+                    {
+                        prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    }
+                    #endif /* configUSE_TIMER_WHEEL */
                 }
                 else
                 {
@@ -632,12 +751,16 @@
                      * received - whichever comes first.  The following line cannot
                      * be reached unless xNextExpireTime > xTimeNow, except in the
                      * case when the current timer list is empty. */
-                    if( xListWasEmpty != pdFALSE )
+                    #if ( configUSE_TIMER_WHEEL == 0 )
                     {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            /* The current timer list is empty - is the overflow list
+                             * also empty? */
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
                     }
+                    #endif /* configUSE_TIMER_WHEEL */
 
                     vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
@@ -674,17 +797,42 @@
          * this task to unblock when the tick count overflows, at which point the
          * timer lists will be switched and the next expiry time can be
          * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 0 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
-        else
+        #else /* if ( configUSE_TIMER_WHEEL == 0 ) */
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            /* The wheel is not sorted, so rather than the expiry time of the
+             * next timer this is the time at which the wheel next needs
+             * attention - which is now if some timers are already due.  The
+             * tick count rolling over needs no special handling. */
+            *pxListWasEmpty = ( uxTimerWheelCount == ( UBaseType_t ) 0U ) ? pdTRUE : pdFALSE;
+
+            if( *pxListWasEmpty != pdFALSE )
+            {
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+            else if( listLIST_IS_EMPTY( &xTimerWheelDueList ) == pdFALSE )
+            {
+                xNextExpireTime = xTimerWheelTime;
+            }
+            else
+            {
+                xNextExpireTime = prvTimerWheelNextEventTime();
+            }
         }
+        #endif /* if ( configUSE_TIMER_WHEEL == 0 ) */
 
         return xNextExpireTime;
     }
@@ -693,21 +841,32 @@
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
     {
         TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
         xTimeNow = xTaskGetTickCount();
 
-        if( xTimeNow < xLastTime )
+        #if ( configUSE_TIMER_WHEEL == 0 )
         {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
+            PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+            if( xTimeNow < xLastTime )
+            {
+                prvSwitchTimerLists();
+                *pxTimerListsWereSwitched = pdTRUE;
+            }
+            else
+            {
+                *pxTimerListsWereSwitched = pdFALSE;
+            }
+
+            xLastTime = xTimeNow;
         }
-        else
+        #else
         {
+            /* Wheel slots are indexed by the low bits of the expiry time, so
+             * there are no lists to switch when the tick count overflows. */
             *pxTimerListsWereSwitched = pdFALSE;
         }
-
-        xLastTime = xTimeNow;
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xTimeNow;
     }
@@ -723,6 +882,22 @@
         listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
         listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* The expiry time is one period after the command time, so the
+             * timer has already expired if at least one period has elapsed
+             * since the command was issued.  Measuring the elapsed time covers
+             * both of the overflow cases handled separately below. */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            {
+                xProcessTimerNow = pdTRUE;
+            }
+            else
+            {
+                prvTimerWheelInsert( pxTimer, xTimeNow );
+            }
+        }
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
         if( xNextExpiryTime <= xTimeNow )
         {
             /* Has the expiry time elapsed between the command to start/reset a
@@ -752,6 +927,7 @@
                 vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
             }
         }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
 
         return xProcessTimerNow;
     }
@@ -799,7 +975,15 @@
                 if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
                 {
                     /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        prvTimerWheelRemove( pxTimer );
+                    }
+                    #else
+                    {
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -905,6 +1089,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
@@ -928,6 +1114,158 @@
         pxCurrentTimerList = pxOverflowTimerList;
         pxOverflowTimerList = pxTemp;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+    static void prvTimerWheelInsert( Timer_t * const pxTimer,
+                                     const TickType_t xTimeNow )
+    {
+        if( uxTimerWheelCount == ( UBaseType_t ) 0U )
+        {
+            /* Nothing is waiting in the wheel so it can jump straight to the
+             * current time.  That avoids stepping through slots that are known
+             * to be empty, and stops the wheel time falling so far behind the
+             * tick count that an expiry time could alias with it. */
+            xTimerWheelTime = xTimeNow;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvTimerWheelPlace( pxTimer, xTimerWheelTime );
+        uxTimerWheelCount++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTimerWheelPlace( Timer_t * const pxTimer,
+                                    const TickType_t xBaseTime )
+    {
+        const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+        const TickType_t xTicksToExpiry = xExpiryTime - xBaseTime;
+        UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+
+        /* Use the lowest level whose span still covers the time to expiry.
+         * Timers further away than the span of the whole wheel are parked in
+         * the top level, and are simply placed again each time their slot is
+         * cascaded until they come within range. */
+        while( ( uxLevel < ( UBaseType_t ) ( configTIMER_WHEEL_LEVELS - 1 ) ) &&
+               ( ( xTicksToExpiry >> tmrWHEEL_SHIFT( uxLevel + ( UBaseType_t ) 1U ) ) != ( TickType_t ) 0U ) )
+        {
+            uxLevel++;
+        }
+
+        vListInsertEnd( &( xTimerWheel[ uxLevel ][ ( xExpiryTime >> tmrWHEEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK ] ), &( pxTimer->xTimerListItem ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTimerWheelRemove( Timer_t * const pxTimer )
+    {
+        configASSERT( uxTimerWheelCount > ( UBaseType_t ) 0U );
+
+        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        uxTimerWheelCount--;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvTimerWheelNextEventTime( void )
+    {
+        TickType_t xNextEventTime = xTimerWheelTime;
+        TickType_t xTicksToEvent, xTicksToNextEvent = tmrMAX_TIME_BEFORE_OVERFLOW;
+        TickType_t xLevelTime;
+        UBaseType_t uxLevel, uxStep;
+
+        /* For each level find the first slot after the current one that holds
+         * timers.  Level 0 slots are reached one tick apart, slots of level N
+         * are cascaded each time the low N * configTIMER_WHEEL_SLOT_BITS bits of
+         * the tick count wrap to zero.  The search is bounded by the size of the
+         * wheel, not by the number of active timers. */
+        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+        {
+            xLevelTime = xTimerWheelTime >> tmrWHEEL_SHIFT( uxLevel );
+
+            for( uxStep = ( UBaseType_t ) 1U; uxStep <= tmrWHEEL_SLOTS; uxStep++ )
+            {
+                if( listLIST_IS_EMPTY( &( xTimerWheel[ uxLevel ][ ( xLevelTime + ( TickType_t ) uxStep ) & tmrWHEEL_SLOT_MASK ] ) ) == pdFALSE )
+                {
+                    xTicksToEvent = ( TickType_t ) ( ( xLevelTime + ( TickType_t ) uxStep ) << tmrWHEEL_SHIFT( uxLevel ) ) - xTimerWheelTime;
+
+                    if( xTicksToEvent < xTicksToNextEvent )
+                    {
+                        xTicksToNextEvent = xTicksToEvent;
+                        xNextEventTime = xTimerWheelTime + xTicksToEvent;
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        /* Only called when at least one timer is in the wheel. */
+        configASSERT( xNextEventTime != xTimerWheelTime );
+
+        return xNextEventTime;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTimerWheelAdvance( const TickType_t xEventTime )
+    {
+        List_t xCascadeList;
+        List_t * pxSlot;
+        Timer_t * pxTimer;
+        UBaseType_t uxLevel;
+
+        /* No slot between the old wheel time and xEventTime holds any timers,
+         * so the wheel can move straight to xEventTime. */
+        xTimerWheelTime = xEventTime;
+        vListInitialise( &xCascadeList );
+
+        /* Cascade each level whose slot boundary has been reached, lowest level
+         * first.  The timers of a slot are moved to a local list before being
+         * placed again as a timer parked in the top level can land back in the
+         * slot being emptied. */
+        for( uxLevel = ( UBaseType_t ) 1U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+        {
+            if( ( xEventTime & ( ( ( TickType_t ) 1U << tmrWHEEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+            {
+                break;
+            }
+
+            pxSlot = &( xTimerWheel[ uxLevel ][ ( xEventTime >> tmrWHEEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK ] );
+
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                vListInsertEnd( &xCascadeList, &( pxTimer->xTimerListItem ) );
+            }
+
+            while( listLIST_IS_EMPTY( &xCascadeList ) == pdFALSE )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xCascadeList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                prvTimerWheelPlace( pxTimer, xEventTime );
+            }
+        }
+
+        /* Every timer now in the level 0 slot for xEventTime expires at
+         * xEventTime.  Move them to the due list so reloading an auto-reload
+         * timer into the same slot cannot make it expire twice. */
+        pxSlot = &( xTimerWheel[ 0 ][ xEventTime & tmrWHEEL_SLOT_MASK ] );
+
+        while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+        {
+            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            configASSERT( listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) == xEventTime );
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            vListInsertEnd( &xTimerWheelDueList, &( pxTimer->xTimerListItem ) );
+        }
+    }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -939,10 +1277,28 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    vListInitialise( &xActiveTimerList2 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                    pxOverflowTimerList = &xActiveTimerList2;
+                }
+                #else
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+                    }
+
+                    vListInitialise( &xTimerWheelDueList );
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -0,0 +1,269 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder.  This #if is closed at the very bottom of this
+ * file.  If you want to record a trace then ensure configUSE_TRACE_RECORDER is
+ * set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+    #if ( ( configTRACE_RECORDER_EVENTS & ( configTRACE_RECORDER_EVENTS - 1 ) ) != 0 )
+        #error configTRACE_RECORDER_EVENTS must be a power of two.
+    #endif
+
+    #define recorderEVENT_INDEX_MASK    ( ( uint32_t ) configTRACE_RECORDER_EVENTS - 1UL )
+
+/* The fields of the three structures below are the dump format described in
+ * trace_recorder.h, so all are 32 bit words or byte arrays of a multiple of four
+ * bytes and the structures have no padding on any port. */
+    typedef struct TraceRecorderHeader
+    {
+        uint32_t ulMagic;
+        uint32_t ulVersion;
+        uint32_t ulTimestampHz;
+        uint32_t ulEventCapacity;
+        uint32_t ulSymbolCapacity;
+        uint32_t ulNameLength;
+        uint32_t ulEventsWritten;
+        uint32_t ulSymbolsWritten;
+        volatile uint32_t ulRecording;
+    } TraceRecorderHeader_t;
+
+    typedef struct TraceRecorderSymbol
+    {
+        uint32_t ulObject;
+        uint32_t ulFirstEvent;
+        char cName[ recorderNAME_LENGTH ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    } TraceRecorderSymbol_t;
+
+    typedef struct TraceRecorderEvent
+    {
+        uint32_t ulTimestamp;
+        uint32_t ulObject;
+        uint32_t ulEventAndParameter;
+    } TraceRecorderEvent_t;
+
+    typedef struct TraceRecorder
+    {
+        TraceRecorderHeader_t xHeader;
+        TraceRecorderSymbol_t xSymbols[ configTRACE_RECORDER_SYMBOLS ];
+        TraceRecorderEvent_t xEvents[ configTRACE_RECORDER_EVENTS ];
+    } TraceRecorder_t;
+
+/* Recording is on from reset so the tasks and queues created before the
+ * scheduler starts are captured too.  The timestamp frequency is filled in by
+ * vTraceRecorderStart(), as it may depend on clocks configured in main(). */
+    PRIVILEGED_DATA static TraceRecorder_t xTraceRecorder =
+    {
+        {
+            recorderMAGIC,
+            recorderVERSION,
+            0UL,
+            ( uint32_t ) configTRACE_RECORDER_EVENTS,
+            ( uint32_t ) configTRACE_RECORDER_SYMBOLS,
+            ( uint32_t ) recorderNAME_LENGTH,
+            0UL,
+            0UL,
+            1UL
+        },
+        { { 0UL, 0UL, { 0 } } },
+        { { 0UL, 0UL, 0UL } }
+    };
+
+/*
+ * Give ulObject a name from the next event recorded on.
+ */
+    static void prvSetSymbol( uint32_t ulObject,
+                              const char * pcName ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderEvent( uint32_t ulEventID,
+                              const void * pvObject,
+                              uint32_t ulParameter )
+    {
+        TraceRecorderEvent_t * pxEvent;
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( xTraceRecorder.xHeader.ulRecording != 0UL )
+        {
+            /* Masking interrupts, rather than a critical section, lets the
+             * macros be called from interrupts and from inside critical
+             * sections alike.  The timestamp is taken with the mask held so
+             * events are in time order in the buffer. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                pxEvent = &( xTraceRecorder.xEvents[ xTraceRecorder.xHeader.ulEventsWritten & recorderEVENT_INDEX_MASK ] );
+                xTraceRecorder.xHeader.ulEventsWritten++;
+
+                pxEvent->ulTimestamp = ( uint32_t ) configTRACE_RECORDER_TIMESTAMP();
+                pxEvent->ulObject = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvObject;
+                pxEvent->ulEventAndParameter = ( ulParameter << 8 ) | ( ulEventID & 0xffUL );
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetSymbol( uint32_t ulObject,
+                              const char * pcName )
+    {
+        TraceRecorderSymbol_t * pxSymbol = NULL;
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulIndex;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* The newest entry for the address is the one that matters. */
+            for( ulIndex = xTraceRecorder.xHeader.ulSymbolsWritten; ulIndex > 0UL; ulIndex-- )
+            {
+                if( xTraceRecorder.xSymbols[ ulIndex - 1UL ].ulObject == ulObject )
+                {
+                    pxSymbol = &( xTraceRecorder.xSymbols[ ulIndex - 1UL ] );
+                    break;
+                }
+            }
+
+            if( ( pxSymbol != NULL ) && ( strncmp( pxSymbol->cName, pcName, recorderNAME_LENGTH - 1 ) == 0 ) )
+            {
+                /* Same name again, typically a new object of the same type
+                 * in the memory of a deleted one. */
+                pxSymbol = NULL;
+            }
+            else if( xTraceRecorder.xHeader.ulSymbolsWritten < ( uint32_t ) configTRACE_RECORDER_SYMBOLS )
+            {
+                /* A new entry rather than overwriting one for the same
+                 * address, so the events of the earlier object keep its
+                 * name. */
+                pxSymbol = &( xTraceRecorder.xSymbols[ xTraceRecorder.xHeader.ulSymbolsWritten ] );
+                xTraceRecorder.xHeader.ulSymbolsWritten++;
+            }
+            else
+            {
+                /* The table is full, so rename the address if it has an
+                 * entry and otherwise drop the name - the decoder shows
+                 * unnamed objects by address. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxSymbol != NULL )
+            {
+                pxSymbol->ulObject = ulObject;
+                pxSymbol->ulFirstEvent = xTraceRecorder.xHeader.ulEventsWritten;
+                ( void ) strncpy( pxSymbol->cName, pcName, recorderNAME_LENGTH - 1 );
+                pxSymbol->cName[ recorderNAME_LENGTH - 1 ] = '\0';
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderSetName( const void * pvObject,
+                                const char * pcName )
+    {
+        configASSERT( pcName );
+
+        prvSetSymbol( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvObject, pcName );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderSetISRName( uint32_t ulISRNumber,
+                                   const char * pcName )
+    {
+        configASSERT( pcName );
+
+        prvSetSymbol( ulISRNumber, pcName );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderISREnter( uint32_t ulISRNumber )
+    {
+        vTraceRecorderEvent( recorderEVENT_ISR_ENTER, ( const void * ) ( portPOINTER_SIZE_TYPE ) ulISRNumber, 0 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderISRExit( uint32_t ulISRNumber )
+    {
+        vTraceRecorderEvent( recorderEVENT_ISR_EXIT, ( const void * ) ( portPOINTER_SIZE_TYPE ) ulISRNumber, 0 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStart( void )
+    {
+        xTraceRecorder.xHeader.ulTimestampHz = ( uint32_t ) configTRACE_RECORDER_TIMESTAMP_HZ;
+        prvSetSymbol( recorderTICK_ISR, "Tick" );
+        xTraceRecorder.xHeader.ulRecording = 1UL;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStop( void )
+    {
+        xTraceRecorder.xHeader.ulRecording = 0UL;
+    }
+/*-----------------------------------------------------------*/
+
+    const void * pvTraceRecorderGetBuffer( size_t * pxBufferSize )
+    {
+        configASSERT( pxBufferSize );
+
+        *pxBufferSize = sizeof( xTraceRecorder );
+
+        return &xTraceRecorder;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder.  If you want to record a trace then ensure
+ * configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TRACE_RECORDER == 1 */
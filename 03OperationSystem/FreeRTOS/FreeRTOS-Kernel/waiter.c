@@ -0,0 +1,434 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "waiter.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include waiters.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_WAITERS == 1 )
+
+/*
+ * Each source holds a pointer to its waiter and its ready bits, and calls
+ * vWaiterNotify() or vWaiterNotifyFromISR() when it becomes ready.  Those OR
+ * the bits into ulReadyBits and, if the waiting task is blocked, notify it and
+ * clear xTaskWaiting, so any further source that becomes ready before the
+ * task runs only sets its bits.  xWaitAny() clears the task's notification
+ * state and sets xTaskWaiting in the same critical section in which it finds
+ * ulReadyBits empty, so a source that becomes ready after that always sees the
+ * task and its notification is not lost.
+ */
+
+/* Bits stored in the ucFlags field of the waiter. */
+    #define waiterFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the waiter. */
+    typedef struct WaiterDef_t            /*lint !e9058 Style convention uses tag. */
+    {
+        volatile uint32_t ulReadyBits;    /* The ready bits of the sources that became ready since xWaitAny() last returned. */
+        volatile TaskHandle_t xTaskWaiting; /* The task to notify when ulReadyBits becomes non-zero, or NULL. */
+        UBaseType_t uxSources;            /* The number of sources added and not removed. */
+        uint8_t ucFlags;
+    } Waiter_t;
+
+/*
+ * Called by both xWaiterCreate() and xWaiterCreateStatic() to initialise the
+ * members of the newly created waiter.
+ */
+    static void prvInitialiseNewWaiter( Waiter_t * const pxWaiter,
+                                        uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Count a source in or out of the waiter if xResult is pdPASS, and return
+ * xResult.
+ */
+    static BaseType_t prvCountSource( Waiter_t * const pxWaiter,
+                                      BaseType_t xResult,
+                                      BaseType_t xAdded ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        WaiterHandle_t xWaiterCreate( void )
+        {
+            Waiter_t * pxWaiter;
+
+            pxWaiter = ( Waiter_t * ) pvPortMalloc( sizeof( Waiter_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+            if( pxWaiter != NULL )
+            {
+                prvInitialiseNewWaiter( pxWaiter, 0 );
+                traceWAITER_CREATE( pxWaiter );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxWaiter;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        WaiterHandle_t xWaiterCreateStatic( StaticWaiter_t * const pxStaticWaiter )
+        {
+            Waiter_t * pxWaiter;
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticWaiter_t equals the size of the real
+                 * waiter structure. */
+                volatile size_t xSize = sizeof( StaticWaiter_t );
+                configASSERT( xSize == sizeof( Waiter_t ) );
+            } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+            #endif /* configASSERT_DEFINED */
+
+            pxWaiter = ( Waiter_t * ) pxStaticWaiter; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+
+            if( pxWaiter != NULL )
+            {
+                prvInitialiseNewWaiter( pxWaiter, waiterFLAGS_IS_STATICALLY_ALLOCATED );
+                traceWAITER_CREATE( pxWaiter );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxWaiter;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vWaiterDelete( WaiterHandle_t xWaiter )
+    {
+        Waiter_t * pxWaiter = xWaiter;
+
+        configASSERT( pxWaiter );
+        configASSERT( pxWaiter->uxSources == ( UBaseType_t ) 0 );
+        configASSERT( pxWaiter->xTaskWaiting == NULL );
+
+        if( ( pxWaiter->ucFlags & waiterFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFree( ( void * ) pxWaiter );
+            }
+            #else
+            {
+                /* Should not be possible to get here if dynamic allocation is
+                 * not supported. */
+                configASSERT( 0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was statically allocated, so nothing to free. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaiterAddQueue( WaiterHandle_t xWaiter,
+                                QueueHandle_t xQueueOrSemaphore,
+                                uint32_t ulReadyBits )
+    {
+        configASSERT( xWaiter );
+        configASSERT( ulReadyBits != 0U );
+
+        return prvCountSource( xWaiter, xQueueAttachWaiter( xQueueOrSemaphore, xWaiter, ulReadyBits ), pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaiterRemoveQueue( WaiterHandle_t xWaiter,
+                                   QueueHandle_t xQueueOrSemaphore )
+    {
+        configASSERT( xWaiter );
+
+        return prvCountSource( xWaiter, xQueueDetachWaiter( xQueueOrSemaphore, xWaiter ), pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaiterAddStreamBuffer( WaiterHandle_t xWaiter,
+                                       StreamBufferHandle_t xStreamBuffer,
+                                       uint32_t ulReadyBits )
+    {
+        configASSERT( xWaiter );
+        configASSERT( ulReadyBits != 0U );
+
+        return prvCountSource( xWaiter, xStreamBufferAttachWaiter( xStreamBuffer, xWaiter, ulReadyBits ), pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaiterRemoveStreamBuffer( WaiterHandle_t xWaiter,
+                                          StreamBufferHandle_t xStreamBuffer )
+    {
+        configASSERT( xWaiter );
+
+        return prvCountSource( xWaiter, xStreamBufferDetachWaiter( xStreamBuffer, xWaiter ), pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaiterAddEventGroup( WaiterHandle_t xWaiter,
+                                     EventGroupHandle_t xEventGroup,
+                                     EventBits_t uxBitsToWaitFor,
+                                     uint32_t ulReadyBits )
+    {
+        configASSERT( xWaiter );
+        configASSERT( uxBitsToWaitFor != ( EventBits_t ) 0 );
+        configASSERT( ulReadyBits != 0U );
+
+        return prvCountSource( xWaiter, xEventGroupAttachWaiter( xEventGroup, xWaiter, uxBitsToWaitFor, ulReadyBits ), pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaiterRemoveEventGroup( WaiterHandle_t xWaiter,
+                                        EventGroupHandle_t xEventGroup )
+    {
+        configASSERT( xWaiter );
+
+        return prvCountSource( xWaiter, xEventGroupDetachWaiter( xEventGroup, xWaiter ), pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    void vWaiterSignal( WaiterHandle_t xWaiter,
+                        uint32_t ulReadyBits )
+    {
+        configASSERT( xWaiter );
+        configASSERT( ulReadyBits != 0U );
+
+        vWaiterNotify( xWaiter, ulReadyBits );
+    }
+/*-----------------------------------------------------------*/
+
+    void vWaiterSignalFromISR( WaiterHandle_t xWaiter,
+                               uint32_t ulReadyBits,
+                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        configASSERT( xWaiter );
+        configASSERT( ulReadyBits != 0U );
+
+        vWaiterNotifyFromISR( xWaiter, ulReadyBits, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitAny( WaiterHandle_t xWaiter,
+                         uint32_t * const pulReadyBits,
+                         TickType_t xTicksToWait )
+    {
+        Waiter_t * const pxWaiter = xWaiter;
+        TimeOut_t xTimeOut;
+        uint32_t ulReadyBits;
+        BaseType_t xBlock, xReturn;
+
+        configASSERT( pxWaiter );
+        configASSERT( pulReadyBits );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                ulReadyBits = pxWaiter->ulReadyBits;
+                pxWaiter->ulReadyBits = 0U;
+
+                if( ( ulReadyBits == 0U ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+                {
+                    /* Only one task may wait on a waiter at a time. */
+                    configASSERT( ( pxWaiter->xTaskWaiting == NULL ) || ( pxWaiter->xTaskWaiting == xTaskGetCurrentTaskHandle() ) );
+
+                    /* Any notification left over from before is stale. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+                    pxWaiter->xTaskWaiting = xTaskGetCurrentTaskHandle();
+                    xBlock = pdTRUE;
+                }
+                else
+                {
+                    pxWaiter->xTaskWaiting = NULL;
+                    xBlock = pdFALSE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBlock == pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                traceBLOCKING_ON_WAITER( pxWaiter );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+
+                /* Sets xTicksToWait to 0 once the time has expired, so the next
+                 * pass collects any last bits and returns. */
+                ( void ) xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+            }
+        }
+
+        *pulReadyBits = ulReadyBits;
+
+        if( ulReadyBits != 0U )
+        {
+            traceWAITER_READY( pxWaiter, ulReadyBits );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vWaiterNotify( WaiterHandle_t xWaiter,
+                        uint32_t ulReadyBits )
+    {
+        Waiter_t * const pxWaiter = xWaiter;
+        TaskHandle_t xTaskToNotify;
+
+        taskENTER_CRITICAL();
+        {
+            pxWaiter->ulReadyBits |= ulReadyBits;
+
+            xTaskToNotify = pxWaiter->xTaskWaiting;
+
+            if( xTaskToNotify != NULL )
+            {
+                /* Cleared first, as the task may run and wait again before
+                 * the notify returns. */
+                pxWaiter->xTaskWaiting = NULL;
+                ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vWaiterNotifyFromISR( WaiterHandle_t xWaiter,
+                               uint32_t ulReadyBits,
+                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        Waiter_t * const pxWaiter = xWaiter;
+        TaskHandle_t xTaskToNotify;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxWaiter->ulReadyBits |= ulReadyBits;
+
+            xTaskToNotify = pxWaiter->xTaskWaiting;
+
+            if( xTaskToNotify != NULL )
+            {
+                /* Cleared first, as the task may run and wait again before
+                 * the notify returns. */
+                pxWaiter->xTaskWaiting = NULL;
+                ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewWaiter( Waiter_t * const pxWaiter,
+                                        uint8_t ucFlags )
+    {
+        pxWaiter->ulReadyBits = 0U;
+        pxWaiter->xTaskWaiting = NULL;
+        pxWaiter->uxSources = ( UBaseType_t ) 0;
+        pxWaiter->ucFlags = ucFlags;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCountSource( Waiter_t * const pxWaiter,
+                                      BaseType_t xResult,
+                                      BaseType_t xAdded )
+    {
+        if( xResult == pdPASS )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( xAdded != pdFALSE )
+                {
+                    ( pxWaiter->uxSources )++;
+                }
+                else
+                {
+                    ( pxWaiter->uxSources )--;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xResult;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_WAITERS */
@@ -0,0 +1,602 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "work_queue.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*
+ * Pending items are kept on a singly linked FIFO list threaded through the
+ * items themselves, with a pointer to both ends, so a submission appends in
+ * constant time and nothing is copied.  The worker task is only notified when
+ * a submission finds the list empty.  It takes the items off the head one at a
+ * time and only blocks again once it has seen the list empty, so any later
+ * submission notifies it.
+ */
+
+/* Bits stored in the ucFlags field of queues and items. */
+#define workFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+#define workFLAGS_IS_PENDING                 ( ( uint8_t ) 2 )
+
+/* Read the run time counter into xTime. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        #define workGET_TIME( xTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( xTime )
+    #else
+        #define workGET_TIME( xTime )    ( xTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on a work item. */
+typedef struct WorkItemDef_t        /*lint !e9058 Style convention uses tag. */
+{
+    struct WorkItemDef_t * pxNext;  /* The next pending item of the same queue. */
+    WorkFunction_t pxWorkFunction;
+    void * pvParameter;
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulSubmitTime; /* The run time counter when the item was last submitted. */
+    #endif
+    uint8_t ucFlags;
+} WorkItem_t;
+
+/* Structure that holds state information on a work queue. */
+typedef struct WorkQueueDef_t       /*lint !e9058 Style convention uses tag. */
+{
+    WorkItem_t * pxHead;            /* The next item to run, NULL if none is pending. */
+    WorkItem_t * pxTail;            /* The last item submitted. */
+    TaskHandle_t xWorker;
+    UBaseType_t uxPending;          /* The number of items on the list. */
+    WorkQueueStats_t xStats;
+    uint8_t ucFlags;
+} WorkQueue_t;
+
+/*
+ * Called by both xWorkQueueCreate() and xWorkQueueCreateStatic() to
+ * initialise the members of the newly created queue structure.
+ */
+static void prvInitialiseNewWorkQueue( WorkQueue_t * const pxQueue,
+                                       uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Append the item to the queue unless it is already pending.  Sets
+ * *pxNotifyWorker to pdTRUE if the queue was empty.  Must be called from
+ * inside a critical section.
+ */
+static BaseType_t prvSubmitItem( WorkQueue_t * const pxQueue,
+                                 WorkItem_t * const pxItem,
+                                 BaseType_t * const pxNotifyWorker ) PRIVILEGED_FUNCTION;
+
+/*
+ * The worker task of every queue.
+ */
+static portTASK_FUNCTION_PROTO( prvWorkQueueTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        UBaseType_t uxPriority,
+                                        const configSTACK_DEPTH_TYPE usStackDepth )
+    {
+        WorkQueue_t * pxQueue;
+
+        pxQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxQueue != NULL )
+        {
+            prvInitialiseNewWorkQueue( pxQueue, 0 );
+
+            if( xTaskCreate( prvWorkQueueTask, pcName, usStackDepth, ( void * ) pxQueue, uxPriority, &( pxQueue->xWorker ) ) == pdPASS )
+            {
+                traceWORK_QUEUE_CREATE( pxQueue );
+            }
+            else
+            {
+                vPortFree( ( void * ) pxQueue );
+                pxQueue = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                              UBaseType_t uxPriority,
+                                              const uint32_t ulStackDepth,
+                                              StackType_t * const puxStackBuffer,
+                                              StaticTask_t * const pxTaskBuffer,
+                                              StaticWorkQueue_t * const pxWorkQueueBuffer )
+    {
+        WorkQueue_t * const pxQueue = ( WorkQueue_t * ) pxWorkQueueBuffer; /*lint !e740 !e9087 Safe cast as StaticWorkQueue_t is opaque WorkQueue_t. */
+        WorkQueueHandle_t xReturn;
+
+        configASSERT( puxStackBuffer );
+        configASSERT( pxTaskBuffer );
+        configASSERT( pxWorkQueueBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticWorkQueue_t equals the size of the real
+             * queue structure. */
+            volatile size_t xSize = sizeof( StaticWorkQueue_t );
+            configASSERT( xSize == sizeof( WorkQueue_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) && ( pxWorkQueueBuffer != NULL ) )
+        {
+            prvInitialiseNewWorkQueue( pxQueue, workFLAGS_IS_STATICALLY_ALLOCATED );
+            pxQueue->xWorker = xTaskCreateStatic( prvWorkQueueTask, pcName, ulStackDepth, ( void * ) pxQueue, uxPriority, puxStackBuffer, pxTaskBuffer );
+            traceWORK_QUEUE_CREATE( pxQueue );
+
+            xReturn = pxQueue;
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vWorkQueueDelete( WorkQueueHandle_t xWorkQueue )
+{
+    WorkQueue_t * pxQueue = xWorkQueue;
+    WorkItem_t * pxItem;
+
+    configASSERT( pxQueue );
+    configASSERT( pxQueue->xWorker != xTaskGetCurrentTaskHandle() );
+
+    vTaskDelete( pxQueue->xWorker );
+
+    /* Drop the items the worker did not get to. */
+    taskENTER_CRITICAL();
+    {
+        for( pxItem = pxQueue->pxHead; pxItem != NULL; pxItem = pxItem->pxNext )
+        {
+            pxItem->ucFlags &= ( uint8_t ) ~workFLAGS_IS_PENDING;
+        }
+
+        pxQueue->pxHead = NULL;
+        pxQueue->pxTail = NULL;
+    }
+    taskEXIT_CRITICAL();
+
+    if( ( pxQueue->ucFlags & workFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxQueue ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xWorkQueue == ( WorkQueueHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* Scrub the structure so future use will assert. */
+        ( void ) memset( pxQueue, 0x00, sizeof( WorkQueue_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    WorkItemHandle_t xWorkItemCreate( WorkFunction_t pxWorkFunction,
+                                      void * pvParameter )
+    {
+        WorkItem_t * pxItem;
+
+        configASSERT( pxWorkFunction );
+
+        pxItem = ( WorkItem_t * ) pvPortMalloc( sizeof( WorkItem_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxItem != NULL )
+        {
+            ( void ) memset( pxItem, 0x00, sizeof( WorkItem_t ) );
+            pxItem->pxWorkFunction = pxWorkFunction;
+            pxItem->pvParameter = pvParameter;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxItem;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxWorkFunction,
+                                            void * pvParameter,
+                                            StaticWorkItem_t * const pxWorkItemBuffer )
+    {
+        WorkItem_t * const pxItem = ( WorkItem_t * ) pxWorkItemBuffer; /*lint !e740 !e9087 Safe cast as StaticWorkItem_t is opaque WorkItem_t. */
+
+        configASSERT( pxWorkFunction );
+        configASSERT( pxWorkItemBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticWorkItem_t equals the size of the real
+             * item structure. */
+            volatile size_t xSize = sizeof( StaticWorkItem_t );
+            configASSERT( xSize == sizeof( WorkItem_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( pxItem != NULL )
+        {
+            ( void ) memset( pxItem, 0x00, sizeof( WorkItem_t ) );
+            pxItem->pxWorkFunction = pxWorkFunction;
+            pxItem->pvParameter = pvParameter;
+            pxItem->ucFlags = workFLAGS_IS_STATICALLY_ALLOCATED;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxItem;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vWorkItemDelete( WorkItemHandle_t xWorkItem )
+{
+    WorkItem_t * pxItem = xWorkItem;
+
+    configASSERT( pxItem );
+    configASSERT( ( pxItem->ucFlags & workFLAGS_IS_PENDING ) == ( uint8_t ) 0 );
+
+    if( ( pxItem->ucFlags & workFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxItem ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xWorkItem == ( WorkItemHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* Scrub the structure so future use will assert. */
+        ( void ) memset( pxItem, 0x00, sizeof( WorkItem_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem )
+{
+    const WorkItem_t * const pxItem = xWorkItem;
+    BaseType_t xReturn;
+
+    configASSERT( pxItem );
+
+    if( ( pxItem->ucFlags & workFLAGS_IS_PENDING ) != ( uint8_t ) 0 )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItemHandle_t xWorkItem )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+    BaseType_t xReturn, xNotifyWorker = pdFALSE;
+
+    configASSERT( pxQueue );
+    configASSERT( xWorkItem );
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvSubmitItem( pxQueue, xWorkItem, &xNotifyWorker );
+    }
+    taskEXIT_CRITICAL();
+
+    if( xNotifyWorker != pdFALSE )
+    {
+        ( void ) xTaskNotifyGive( pxQueue->xWorker );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItemHandle_t xWorkItem,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+    BaseType_t xReturn, xNotifyWorker = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxQueue );
+    configASSERT( xWorkItem );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Only FreeRTOS
+     * functions that end in FromISR can be called from interrupts that have
+     * been assigned a priority at or (logically) below that maximum. */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        xReturn = prvSubmitItem( pxQueue, xWorkItem, &xNotifyWorker );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xNotifyWorker != pdFALSE )
+    {
+        vTaskNotifyGiveFromISR( pxQueue->xWorker, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                         WorkQueueStats_t * pxStats )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pxStats );
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = pxQueue->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueResetStats( WorkQueueHandle_t xWorkQueue )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        ( void ) memset( &( pxQueue->xStats ), 0x00, sizeof( WorkQueueStats_t ) );
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewWorkQueue( WorkQueue_t * const pxQueue,
+                                       uint8_t ucFlags )
+{
+    ( void ) memset( pxQueue, 0x00, sizeof( WorkQueue_t ) );
+    pxQueue->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSubmitItem( WorkQueue_t * const pxQueue,
+                                 WorkItem_t * const pxItem,
+                                 BaseType_t * const pxNotifyWorker )
+{
+    BaseType_t xReturn;
+
+    if( ( pxItem->ucFlags & workFLAGS_IS_PENDING ) == ( uint8_t ) 0 )
+    {
+        pxItem->ucFlags |= workFLAGS_IS_PENDING;
+        pxItem->pxNext = NULL;
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            workGET_TIME( pxItem->ulSubmitTime );
+        }
+        #endif
+
+        if( pxQueue->pxTail == NULL )
+        {
+            pxQueue->pxHead = pxItem;
+            *pxNotifyWorker = pdTRUE;
+        }
+        else
+        {
+            pxQueue->pxTail->pxNext = pxItem;
+        }
+
+        pxQueue->pxTail = pxItem;
+        ( pxQueue->uxPending )++;
+
+        if( pxQueue->uxPending > pxQueue->xStats.uxMaxPending )
+        {
+            pxQueue->xStats.uxMaxPending = pxQueue->uxPending;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( pxQueue->xStats.ulSubmitted )++;
+        traceWORK_QUEUE_SUBMIT( pxQueue, pxItem );
+        xReturn = pdPASS;
+    }
+    else
+    {
+        /* Already pending, so the one run covers this submission too. */
+        ( pxQueue->xStats.ulCoalesced )++;
+        traceWORK_QUEUE_COALESCE( pxQueue, pxItem );
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvWorkQueueTask, pvParameters )
+{
+    WorkQueue_t * const pxQueue = ( WorkQueue_t * ) pvParameters;
+    WorkItem_t * pxItem;
+    WorkFunction_t pxWorkFunction = NULL;
+    void * pvParameter = NULL;
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulNow, ulLatency;
+    #endif
+
+    for( ; ; )
+    {
+        /* Take the next item off the list, and stop pending it before its
+         * function runs so it can be submitted again. */
+        taskENTER_CRITICAL();
+        {
+            pxItem = pxQueue->pxHead;
+
+            if( pxItem != NULL )
+            {
+                pxQueue->pxHead = pxItem->pxNext;
+
+                if( pxQueue->pxHead == NULL )
+                {
+                    pxQueue->pxTail = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ( pxQueue->uxPending )--;
+                pxItem->ucFlags &= ( uint8_t ) ~workFLAGS_IS_PENDING;
+                pxWorkFunction = pxItem->pxWorkFunction;
+                pvParameter = pxItem->pvParameter;
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    workGET_TIME( ulNow );
+                    ulLatency = ulNow - pxItem->ulSubmitTime;
+
+                    if( ( pxQueue->xStats.ulRun == 0U ) || ( ulLatency < pxQueue->xStats.ulMinLatency ) )
+                    {
+                        pxQueue->xStats.ulMinLatency = ulLatency;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( ulLatency > pxQueue->xStats.ulMaxLatency )
+                    {
+                        pxQueue->xStats.ulMaxLatency = ulLatency;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxQueue->xStats.ulTotalLatency += ulLatency;
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
+
+                ( pxQueue->xStats.ulRun )++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxItem != NULL )
+        {
+            traceWORK_ITEM_RUN( pxQueue, pxItem );
+            pxWorkFunction( pvParameter );
+        }
+        else
+        {
+            /* The list was seen empty, so the next submission notifies this
+             * task. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
@@ -41,7 +41,11 @@
 * http://www.freertos.org/a00110.html
 *----------------------------------------------------------*/
 
-#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+#if defined(USE_HOST_SIM)
+/* Host build on the Posix port (Posix_GCC/Makefile), no device headers. */
+#include <stdint.h>
+extern uint32_t SystemCoreClock;
+#elif defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
 #include <stdint.h>
 #include "air32f10x.h"
 extern uint32_t SystemCoreClock;
@@ -52,19 +56,113 @@ extern uint32_t SystemCoreClock;
 #define configUSE_TICK_HOOK			0
 #define configCPU_CLOCK_HZ			( ( unsigned long ) SystemCoreClock )	
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
+/* "make prio256" in Posix_GCC sets it to 256 on the command line. */
+#ifndef configMAX_PRIORITIES
 #define configMAX_PRIORITIES		( 5 )
+#endif
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 128 )
+#ifdef USE_HOST_SIM
+/* StackType_t and pointers are twice as wide on a 64-bit host, and the
+benchmarks create up to a thousand kernel objects. */
+#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 256 * 1024 ) )
+#else
 #define configTOTAL_HEAP_SIZE		( ( size_t ) ( 24 * 1024 ) )
+#endif
 #define configMAX_TASK_NAME_LEN		( 16 )
 #define configUSE_TRACE_FACILITY	0
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
+/* Keep blocked tasks in a wake time heap instead of a sorted list, so
+vTaskDelay() does not walk every sleeping task inside a critical section. */
+#define configUSE_DELAYED_TASK_HEAP	1
+/* xEventGroupSetBitsFromISR() unblocks the waiting tasks from the interrupt
+instead of deferring the set to the timer task. */
+#define configUSE_EVENT_GROUP_ISR_FAST_PATH	1
+/* Tasks block on and are woken from queue and mutex wait lists in constant time
+however many of them wait, see EventList_t. */
+#define configUSE_EVENT_LIST_INDEX	1
+/* Mutexes with priority inheritance.  An uncontended take or give is a single
+LDREX/STREX compare and swap on the owner word, without a critical section. */
+#define configUSE_MUTEXES	1
+#define configUSE_MUTEX_FAST_PATH	1
+/* Tasks, queues and stream buffers of the C++ wrappers (FreeRTOS-Cpp) are
+created in static storage with xTaskCreateStatic() and friends, so the idle and
+timer task memory comes from main.c as well. */
+#define configSUPPORT_STATIC_ALLOCATION	1
+
+/* xQueueReserve()/xQueueCommit() and xQueuePeekRef()/xQueueRelease() write and
+read queue items in place in the queue storage instead of copying them.
+Queue<T, N>::sendInPlace() and receiveInPlace() of the C++ wrappers copy items
+of sizeof( T ) through them, so it is on for the target too whenever the C++
+wrappers are built (benchUSE_CPP). */
+#if defined(USE_HOST_SIM) || defined(benchUSE_CPP)
+#define configUSE_QUEUE_ZERO_COPY	1
+#endif
+
+/* Optional APIs that the benchmarks in Benchmark/ measure.  The demo in main.c
+calls none of them, so they are only on in the host build and the 24 KB target
+does not pay for them. */
+#ifdef USE_HOST_SIM
+/* xQueueSendMultiple()/xQueueReceiveMultiple() move several items per call,
+copying as many as fit under one critical section and waking the waiting tasks
+once per group of items instead of once per item. */
+#define configUSE_QUEUE_BATCH	1
+/* xStreamBufferAcquireWrite()/xStreamBufferCommitWrite() and
+xStreamBufferAcquireRead()/xStreamBufferReleaseRead() hand out the free and the
+filled part of the stream buffer storage to write or read in place. */
+#define configUSE_STREAM_BUFFER_ZERO_COPY	1
+/* Tasks at configEDF_TASK_PRIORITY that are given a period and a deadline with
+vTaskSetEDFParameters() run earliest deadline first instead of round robin.
+Tasks at that priority without EDF parameters run before them, and tasks at
+other priorities are scheduled as before. */
+#define configUSE_EDF_SCHEDULER	1
+#define configEDF_TASK_PRIORITY	1
+/* xSemaphoreCreateMutexWithCeiling() creates mutexes under the immediate
+priority ceiling protocol: the holder runs at the ceiling priority given at
+creation until it gives the mutex back. */
+#define configUSE_MUTEX_PRIORITY_CEILING	1
+/* Waiters (waiter.h) let one task block in xWaitAny() until any of the queues,
+stream buffers and event groups added to its waiter is ready. */
+#define configUSE_WAITERS	1
+#endif
+
+/* Per task CPU time counted in CPU cycles by the DWT cycle counter (in ns on the
+host), with interrupt time kept apart from the task it interrupted.  Read the
+CPU load with uxTaskGetRunTimeSnapshot(). */
+#define configGENERATE_RUN_TIME_STATS	1
+#define configRUN_TIME_COUNTER_TYPE	uint64_t
+#define configRUN_TIME_STATS_ISR_ATTRIBUTION	1
+#ifndef USE_HOST_SIM
+#define configUSE_DWT_RUN_TIME_COUNTER	1
+#endif
+
+/* Kernel events go to a RAM ring buffer that Tools/trace_decode.c turns into a
+Perfetto timeline, see trace_recorder.h.  "make trace" in Posix_GCC builds the
+benchmarks with it on. */
+#ifndef configUSE_TRACE_RECORDER
+#define configUSE_TRACE_RECORDER	0
+#endif
+#ifdef USE_HOST_SIM
+extern uint32_t ulHostTraceTimestamp( void );
+#define configTRACE_RECORDER_TIMESTAMP()	ulHostTraceTimestamp()
+#define configTRACE_RECORDER_TIMESTAMP_HZ	1000000000UL
+#else
+/* DWT->CYCCNT, main() turns the counter on. */
+#define configTRACE_RECORDER_TIMESTAMP()	( *( ( volatile uint32_t * ) 0xE0001004UL ) )
+#define configTRACE_RECORDER_TIMESTAMP_HZ	configCPU_CLOCK_HZ
+#endif
 
 /* Software timer related definitions. */
 #define configUSE_TIMERS                1
 #define configTIMER_TASK_PRIORITY       ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH        10
 #define configTIMER_TASK_STACK_DEPTH    ( configMINIMAL_STACK_SIZE * 2 )   
+/* Keep active timers in a hierarchical timing wheel (3 levels x 32 slots, 32768
+ticks before a timer has to be re-cascaded) so starting or resetting a timer
+does not walk the sorted active timer list. */
+#define configUSE_TIMER_WHEEL           1
+#define configTIMER_WHEEL_SLOT_BITS     5
+#define configTIMER_WHEEL_LEVELS        3
 
 #define INCLUDE_xTaskGetSchedulerState  1
 
@@ -82,6 +180,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTimerPendFunctionCall	1
 
 #define vPortSVCHandler         SVC_Handler
 #define xPortPendSVHandler      PendSV_Handler
@@ -109,6 +208,11 @@ NVIC value of 255. */
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
+#ifdef USE_HOST_SIM
+extern void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+#else
 #define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,1110 @@
+/*
+ * Converts a buffer recorded by FreeRTOS-Kernel/trace_recorder.c into Chrome
+ * trace event JSON, which https://ui.perfetto.dev and chrome://tracing show
+ * as a timeline:
+ *
+ *   CPU          one slice per stretch of time a task was running.
+ *   Interrupts   one slice per interrupt, nested as the interrupts nested.
+ *   <task>       one track per task with its state over time: Running, Ready
+ *                (made ready, waiting for the CPU - the scheduling latency),
+ *                Preempted, Blocked on an object, Delayed or Suspended.
+ *   counters     the number of items in each queue or semaphore, the free
+ *                blocks of each memory pool and every user event channel.
+ *
+ * Kernel object operations are instant events on the track of the task (or
+ * the Interrupts track) that made them.  A per task summary of the time spent
+ * running and of the worst and average Ready time is printed to stderr.
+ *
+ * The input can be the recorder buffer on its own, as written by
+ * pvTraceRecorderGetBuffer(), or any larger memory dump that contains it.
+ *
+ * Usage: trace_decode [-f timestamp_hz] dump.bin [trace.json]
+ *
+ * Built by Posix_GCC/Makefile; "make trace" there records the kernel
+ * benchmarks and decodes the result to build/trace.json.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Keep in step with trace_recorder.h. */
+#define decodeMAGIC                  0x52545246UL
+#define decodeVERSION                1UL
+#define decodeHEADER_WORDS           9
+#define decodeTICK_ISR               0xffffffffUL
+
+#define decodeTASK_CREATE            0x01
+#define decodeTASK_DELETE            0x02
+#define decodeTASK_SWITCHED_IN       0x03
+#define decodeTASK_READY             0x04
+#define decodeTASK_DELAY             0x05
+#define decodeTASK_DELAY_UNTIL       0x06
+#define decodeTASK_SUSPEND           0x07
+#define decodeTASK_NOTIFY_TAKE_BLOCK 0x10
+#define decodeTASK_NOTIFY_WAIT_BLOCK 0x11
+#define decodeQUEUE_CREATE           0x20
+#define decodeQUEUE_SEND             0x22
+#define decodeQUEUE_SEND_FROM_ISR    0x24
+#define decodeQUEUE_RECEIVE          0x26
+#define decodeQUEUE_RECEIVE_FROM_ISR 0x28
+#define decodeBLOCKING_QUEUE_SEND    0x2B
+#define decodeBLOCKING_QUEUE_RECEIVE 0x2C
+#define decodeBLOCKING_QUEUE_PEEK    0x2D
+#define decodeQUEUE_SEND_MULTIPLE    0x2E
+#define decodeQUEUE_RECEIVE_MULTIPLE 0x2F
+#define decodeEG_CREATE              0x30
+#define decodeEG_WAIT_BITS_BLOCK     0x35
+#define decodeEG_SYNC_BLOCK          0x36
+#define decodeMUTEX_TAKE             0x38
+#define decodeMUTEX_GIVE             0x39
+#define decodeSB_CREATE              0x40
+#define decodeSB_BLOCKING_SEND       0x46
+#define decodeSB_BLOCKING_RECEIVE    0x47
+#define decodeMEM_POOL_CREATE        0x50
+#define decodeMEM_POOL_ALLOC         0x51
+#define decodeMEM_POOL_FREE          0x53
+#define decodeTIMER_CREATE           0x58
+#define decodeISR_ENTER              0x60
+#define decodeISR_EXIT               0x61
+#define decodeUSER                   0x70
+
+/* queueQUEUE_TYPE_* values from queue.h. */
+#define decodeQUEUE_TYPE_MUTEX              1
+#define decodeQUEUE_TYPE_COUNTING_SEMAPHORE 2
+#define decodeQUEUE_TYPE_BINARY_SEMAPHORE   3
+#define decodeQUEUE_TYPE_RECURSIVE_MUTEX    4
+
+#define decodeCPU_TID           1
+#define decodeISR_TID           2
+#define decodeFIRST_TASK_TID    100
+#define decodeMAX_ISR_NESTING   16
+#define decodeLABEL_LENGTH      64
+
+typedef enum
+{
+    eKindUnknown = 0,
+    eKindTask,
+    eKindQueue,
+    eKindEventGroup,
+    eKindStreamBuffer,
+    eKindMemPool,
+    eKindTimer,
+    eKindISR,
+    eKindUserChannel
+} ObjectKind_t;
+
+typedef enum
+{
+    eStateUnknown = 0,
+    eStateRunning,
+    eStateReady,
+    eStatePreempted,
+    eStateBlocked,
+    eStateDeleted
+} TaskState_t;
+
+/* One run of a task, from its creation (or the start of the trace) until it
+ * is deleted.  A task created at the address of a deleted one gets a new
+ * Task_t and a new track. */
+typedef struct Task
+{
+    int xTid;
+    char cName[ 40 ];
+    TaskState_t eState;
+    char cStateLabel[ decodeLABEL_LENGTH ];
+    double dStateSince;
+    int xPendingBlock;
+    char cPendingLabel[ decodeLABEL_LENGTH ];
+    double dRunning;
+    double dReadyTotal;
+    double dReadyMax;
+    unsigned long ulReadyCount;
+    unsigned long ulSwitchesIn;
+} Task_t;
+
+typedef struct Symbol
+{
+    uint32_t ulFirstEvent;
+    char cName[ 40 ];
+    struct Symbol * pxOlder;
+} Symbol_t;
+
+typedef struct Object
+{
+    uint32_t ulHandle;
+    int xUsed;
+    ObjectKind_t eKind;
+    uint32_t ulQueueType;
+    long lItems; /* The last count of items plotted for a queue. */
+    Symbol_t * pxSymbols; /* Names given to the address, newest first. */
+    char cName[ 40 ];
+    Task_t * pxTask;
+} Object_t;
+
+typedef struct EventName
+{
+    int xID;
+    ObjectKind_t eKind;
+    const char * pcName;
+} EventName_t;
+
+static const EventName_t xEventNames[] =
+{
+    { 0x01, eKindTask,         "Task create"              },
+    { 0x02, eKindTask,         "Task delete"              },
+    { 0x05, eKindTask,         "Delay"                    },
+    { 0x06, eKindTask,         "Delay until"              },
+    { 0x07, eKindTask,         "Suspend"                  },
+    { 0x08, eKindTask,         "Resume"                   },
+    { 0x09, eKindTask,         "Resume from ISR"          },
+    { 0x0A, eKindTask,         "Priority set"             },
+    { 0x0B, eKindTask,         "Priority inherit"         },
+    { 0x0C, eKindTask,         "Priority disinherit"      },
+    { 0x0D, eKindTask,         "Notify"                   },
+    { 0x0E, eKindTask,         "Notify from ISR"          },
+    { 0x0F, eKindTask,         "Notify give from ISR"     },
+    { 0x10, eKindTask,         "Notify take block"        },
+    { 0x11, eKindTask,         "Notify wait block"        },
+    { 0x20, eKindQueue,        "Queue create"             },
+    { 0x21, eKindQueue,        "Queue delete"             },
+    { 0x22, eKindQueue,        "Queue send"               },
+    { 0x23, eKindQueue,        "Queue send failed"        },
+    { 0x24, eKindQueue,        "Queue send from ISR"      },
+    { 0x25, eKindQueue,        "Queue send from ISR failed" },
+    { 0x26, eKindQueue,        "Queue receive"            },
+    { 0x27, eKindQueue,        "Queue receive failed"     },
+    { 0x28, eKindQueue,        "Queue receive from ISR"   },
+    { 0x29, eKindQueue,        "Queue receive from ISR failed" },
+    { 0x2A, eKindQueue,        "Queue peek"               },
+    { 0x2B, eKindQueue,        "Queue send block"         },
+    { 0x2C, eKindQueue,        "Queue receive block"      },
+    { 0x2D, eKindQueue,        "Queue peek block"         },
+    { 0x2E, eKindQueue,        "Queue send multiple"      },
+    { 0x2F, eKindQueue,        "Queue receive multiple"   },
+    { 0x30, eKindEventGroup,   "Event group create"       },
+    { 0x31, eKindEventGroup,   "Event group delete"       },
+    { 0x32, eKindEventGroup,   "Set bits"                 },
+    { 0x33, eKindEventGroup,   "Set bits from ISR"        },
+    { 0x34, eKindEventGroup,   "Clear bits"               },
+    { 0x35, eKindEventGroup,   "Wait bits block"          },
+    { 0x36, eKindEventGroup,   "Sync block"               },
+    { 0x38, eKindQueue,        "Mutex take"               },
+    { 0x39, eKindQueue,        "Mutex give"               },
+    { 0x40, eKindStreamBuffer, "Stream buffer create"     },
+    { 0x41, eKindStreamBuffer, "Stream buffer delete"     },
+    { 0x42, eKindStreamBuffer, "Stream buffer send"       },
+    { 0x43, eKindStreamBuffer, "Stream buffer send from ISR" },
+    { 0x44, eKindStreamBuffer, "Stream buffer receive"    },
+    { 0x45, eKindStreamBuffer, "Stream buffer receive from ISR" },
+    { 0x46, eKindStreamBuffer, "Stream buffer send block" },
+    { 0x47, eKindStreamBuffer, "Stream buffer receive block" },
+    { 0x50, eKindMemPool,      "Pool create"              },
+    { 0x51, eKindMemPool,      "Pool alloc"               },
+    { 0x52, eKindMemPool,      "Pool alloc failed"        },
+    { 0x53, eKindMemPool,      "Pool free"                },
+    { 0x58, eKindTimer,        "Timer create"             },
+    { 0x59, eKindTimer,        "Timer expired"            },
+    { 0x70, eKindUserChannel,  "User event"               }
+};
+
+static Object_t * pxObjects;
+static size_t xObjectCapacity;
+static size_t xObjectCount;
+
+static Task_t ** ppxTasks;
+static size_t xTaskCount;
+
+static uint32_t ulEventNumber;
+
+static FILE * pxOut;
+static int xFirstEvent = 1;
+static double dTicksPerMicrosecond;
+
+static Task_t * pxRunning;
+static double dCpuSince;
+static uint32_t ulISRStack[ decodeMAX_ISR_NESTING ];
+static double dISRSince[ decodeMAX_ISR_NESTING ];
+static int xISRDepth;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRead32( const uint8_t * pucBytes )
+{
+    return ( uint32_t ) pucBytes[ 0 ] |
+           ( ( uint32_t ) pucBytes[ 1 ] << 8 ) |
+           ( ( uint32_t ) pucBytes[ 2 ] << 16 ) |
+           ( ( uint32_t ) pucBytes[ 3 ] << 24 );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvHash( uint32_t ulHandle )
+{
+    return ( size_t ) ( ( ulHandle * 2654435761UL ) & 0xffffffffUL );
+}
+/*-----------------------------------------------------------*/
+
+static Object_t * prvFindSlot( Object_t * pxTable,
+                               size_t xCapacity,
+                               uint32_t ulHandle )
+{
+    size_t xIndex = prvHash( ulHandle ) & ( xCapacity - 1 );
+
+    while( ( pxTable[ xIndex ].xUsed != 0 ) && ( pxTable[ xIndex ].ulHandle != ulHandle ) )
+    {
+        xIndex = ( xIndex + 1 ) & ( xCapacity - 1 );
+    }
+
+    return &( pxTable[ xIndex ] );
+}
+/*-----------------------------------------------------------*/
+
+static Object_t * prvGetObject( uint32_t ulHandle )
+{
+    Object_t * pxObject;
+    size_t i;
+
+    /* Open addressing, grown at half full.  No pointer into the table is held
+     * across calls. */
+    if( ( xObjectCount + 1 ) * 2 > xObjectCapacity )
+    {
+        size_t xNewCapacity = ( xObjectCapacity == 0 ) ? 1024 : xObjectCapacity * 2;
+        Object_t * pxNewTable = calloc( xNewCapacity, sizeof( Object_t ) );
+
+        if( pxNewTable == NULL )
+        {
+            fprintf( stderr, "trace_decode: out of memory\n" );
+            exit( 1 );
+        }
+
+        for( i = 0; i < xObjectCapacity; i++ )
+        {
+            if( pxObjects[ i ].xUsed != 0 )
+            {
+                *prvFindSlot( pxNewTable, xNewCapacity, pxObjects[ i ].ulHandle ) = pxObjects[ i ];
+            }
+        }
+
+        free( pxObjects );
+        pxObjects = pxNewTable;
+        xObjectCapacity = xNewCapacity;
+    }
+
+    pxObject = prvFindSlot( pxObjects, xObjectCapacity, ulHandle );
+
+    if( pxObject->xUsed == 0 )
+    {
+        pxObject->xUsed = 1;
+        pxObject->ulHandle = ulHandle;
+        xObjectCount++;
+    }
+
+    return pxObject;
+}
+/*-----------------------------------------------------------*/
+
+static const char * prvObjectName( Object_t * pxObject )
+{
+    static const char * const pcKindNames[] =
+    {
+        "Object", "Task", "Queue", "Event group", "Stream buffer", "Pool", "Timer", "IRQ", "Channel"
+    };
+    const char * pcKind = pcKindNames[ pxObject->eKind ];
+
+    Symbol_t * pxSymbol;
+
+    /* A name only applies to the object that was given it, not to an earlier
+     * one at the same address. */
+    for( pxSymbol = pxObject->pxSymbols; pxSymbol != NULL; pxSymbol = pxSymbol->pxOlder )
+    {
+        if( ulEventNumber >= pxSymbol->ulFirstEvent )
+        {
+            return pxSymbol->cName;
+        }
+    }
+
+    if( pxObject->eKind == eKindQueue )
+    {
+        switch( pxObject->ulQueueType )
+        {
+            case decodeQUEUE_TYPE_MUTEX:
+            case decodeQUEUE_TYPE_RECURSIVE_MUTEX:
+                pcKind = "Mutex";
+                break;
+
+            case decodeQUEUE_TYPE_COUNTING_SEMAPHORE:
+            case decodeQUEUE_TYPE_BINARY_SEMAPHORE:
+                pcKind = "Semaphore";
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if( pxObject->eKind == eKindISR )
+    {
+        snprintf( pxObject->cName, sizeof( pxObject->cName ), "%s %ld", pcKind, ( long ) ( int32_t ) pxObject->ulHandle );
+    }
+    else
+    {
+        snprintf( pxObject->cName, sizeof( pxObject->cName ), "%s 0x%08lx", pcKind, ( unsigned long ) pxObject->ulHandle );
+    }
+
+    return pxObject->cName;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintJsonString( const char * pcText )
+{
+    fputc( '"', pxOut );
+
+    for( ; *pcText != '\0'; pcText++ )
+    {
+        unsigned char ucChar = ( unsigned char ) *pcText;
+
+        if( ( ucChar == '"' ) || ( ucChar == '\\' ) )
+        {
+            fprintf( pxOut, "\\%c", ucChar );
+        }
+        else if( ucChar < 0x20 )
+        {
+            fprintf( pxOut, "\\u%04x", ucChar );
+        }
+        else
+        {
+            fputc( ucChar, pxOut );
+        }
+    }
+
+    fputc( '"', pxOut );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBeginEvent( void )
+{
+    fprintf( pxOut, xFirstEvent ? "\n  " : ",\n  " );
+    xFirstEvent = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvThreadName( int xTid,
+                           const char * pcName )
+{
+    prvBeginEvent();
+    fprintf( pxOut, "{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", xTid );
+    prvPrintJsonString( pcName );
+    fprintf( pxOut, "}}" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlice( int xTid,
+                      const char * pcName,
+                      double dStart,
+                      double dEnd )
+{
+    prvBeginEvent();
+    fprintf( pxOut, "{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"name\":", xTid, dStart, dEnd - dStart );
+    prvPrintJsonString( pcName );
+    fputc( '}', pxOut );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInstant( double dTime,
+                        const char * pcName,
+                        Object_t * pxObject,
+                        uint32_t ulParameter )
+{
+    int xTid = decodeCPU_TID;
+
+    if( xISRDepth > 0 )
+    {
+        xTid = decodeISR_TID;
+    }
+    else if( pxRunning != NULL )
+    {
+        xTid = pxRunning->xTid;
+    }
+
+    prvBeginEvent();
+    fprintf( pxOut, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":", xTid, dTime );
+    prvPrintJsonString( pcName );
+    fprintf( pxOut, ",\"args\":{\"object\":" );
+    prvPrintJsonString( prvObjectName( pxObject ) );
+    fprintf( pxOut, ",\"parameter\":%lu}}", ( unsigned long ) ulParameter );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCounter( double dTime,
+                        Object_t * pxObject,
+                        const char * pcSeries,
+                        long lValue )
+{
+    prvBeginEvent();
+    fprintf( pxOut, "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":", dTime );
+    prvPrintJsonString( prvObjectName( pxObject ) );
+    fprintf( pxOut, ",\"args\":{\"%s\":%ld}}", pcSeries, lValue );
+}
+/*-----------------------------------------------------------*/
+
+/* Queue events that move one item carry the count from before the call, so
+ * the count is rebuilt from each of them and does not drift if events were
+ * lost.  lItems is kept for the events that only give a change. */
+static void prvQueueItems( double dTime,
+                           Object_t * pxObject,
+                           long lItems )
+{
+    pxObject->lItems = lItems;
+    prvCounter( dTime, pxObject, "items", lItems );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetKind( Object_t * pxObject,
+                        ObjectKind_t eKind )
+{
+    if( pxObject->eKind == eKindUnknown )
+    {
+        pxObject->eKind = eKind;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static Task_t * prvNewTask( Object_t * pxObject )
+{
+    Task_t * pxTask = calloc( 1, sizeof( Task_t ) );
+
+    ppxTasks = realloc( ppxTasks, ( xTaskCount + 1 ) * sizeof( Task_t * ) );
+
+    if( ( pxTask == NULL ) || ( ppxTasks == NULL ) )
+    {
+        fprintf( stderr, "trace_decode: out of memory\n" );
+        exit( 1 );
+    }
+
+    ppxTasks[ xTaskCount ] = pxTask;
+    pxTask->xTid = decodeFIRST_TASK_TID + ( int ) xTaskCount;
+    xTaskCount++;
+
+    pxObject->eKind = eKindTask;
+    snprintf( pxTask->cName, sizeof( pxTask->cName ), "%s", prvObjectName( pxObject ) );
+    prvThreadName( pxTask->xTid, pxTask->cName );
+    pxObject->pxTask = pxTask;
+
+    return pxTask;
+}
+/*-----------------------------------------------------------*/
+
+static Task_t * prvGetTask( Object_t * pxObject )
+{
+    if( pxObject->pxTask == NULL )
+    {
+        return prvNewTask( pxObject );
+    }
+
+    return pxObject->pxTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEnterState( Task_t * pxTask,
+                           TaskState_t eState,
+                           const char * pcLabel,
+                           double dTime )
+{
+    /* The handle of a deleted task may be reused by a new one. */
+    if( ( pxTask->eState != eStateUnknown ) && ( pxTask->eState != eStateDeleted ) )
+    {
+        prvSlice( pxTask->xTid, pxTask->cStateLabel, pxTask->dStateSince, dTime );
+
+        if( pxTask->eState == eStateReady )
+        {
+            double dReady = dTime - pxTask->dStateSince;
+
+            pxTask->dReadyTotal += dReady;
+            pxTask->ulReadyCount++;
+
+            if( dReady > pxTask->dReadyMax )
+            {
+                pxTask->dReadyMax = dReady;
+            }
+        }
+        else if( pxTask->eState == eStateRunning )
+        {
+            pxTask->dRunning += dTime - pxTask->dStateSince;
+        }
+    }
+
+    pxTask->eState = eState;
+    pxTask->dStateSince = dTime;
+    snprintf( pxTask->cStateLabel, sizeof( pxTask->cStateLabel ), "%s", pcLabel );
+}
+/*-----------------------------------------------------------*/
+
+/* A task that blocks is still running until the scheduler switches away from
+ * it, so the reason is remembered until then. */
+static void prvBlockRunningTask( const char * pcWhat,
+                                 Object_t * pxObject )
+{
+    if( pxRunning != NULL )
+    {
+        pxRunning->xPendingBlock = 1;
+
+        if( pxObject != NULL )
+        {
+            snprintf( pxRunning->cPendingLabel, sizeof( pxRunning->cPendingLabel ), "%s %s", pcWhat, prvObjectName( pxObject ) );
+        }
+        else
+        {
+            snprintf( pxRunning->cPendingLabel, sizeof( pxRunning->cPendingLabel ), "%s", pcWhat );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static const char * prvQueueVerb( Object_t * pxQueue,
+                                  int xSend )
+{
+    switch( pxQueue->ulQueueType )
+    {
+        case decodeQUEUE_TYPE_MUTEX:
+        case decodeQUEUE_TYPE_RECURSIVE_MUTEX:
+        case decodeQUEUE_TYPE_COUNTING_SEMAPHORE:
+        case decodeQUEUE_TYPE_BINARY_SEMAPHORE:
+            return xSend ? "Blocked: give" : "Blocked: take";
+
+        default:
+            return xSend ? "Blocked: send to" : "Blocked: receive from";
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvDecodeEvent( double dTime,
+                            uint32_t ulHandle,
+                            int xID,
+                            uint32_t ulParameter )
+{
+    Object_t * pxObject = prvGetObject( ulHandle );
+    Task_t * pxTask;
+    size_t i;
+
+    switch( xID )
+    {
+        case decodeTASK_SWITCHED_IN:
+            pxTask = prvGetTask( pxObject );
+            pxTask->ulSwitchesIn++;
+
+            if( pxTask != pxRunning )
+            {
+                if( pxRunning != NULL )
+                {
+                    prvSlice( decodeCPU_TID, pxRunning->cName, dCpuSince, dTime );
+
+                    if( pxRunning->eState == eStateDeleted )
+                    {
+                        /* Already closed by the delete event. */
+                    }
+                    else if( pxRunning->xPendingBlock != 0 )
+                    {
+                        prvEnterState( pxRunning, eStateBlocked, pxRunning->cPendingLabel, dTime );
+                    }
+                    else
+                    {
+                        prvEnterState( pxRunning, eStatePreempted, "Preempted", dTime );
+                    }
+                }
+
+                prvEnterState( pxTask, eStateRunning, "Running", dTime );
+                pxRunning = pxTask;
+                dCpuSince = dTime;
+            }
+
+            pxTask->xPendingBlock = 0;
+            return;
+
+        case decodeTASK_READY:
+            pxTask = prvGetTask( pxObject );
+
+            if( pxTask == pxRunning )
+            {
+                /* Made ready again before the scheduler switched away. */
+                pxTask->xPendingBlock = 0;
+            }
+            else if( ( pxTask->eState != eStateReady ) && ( pxTask->eState != eStatePreempted ) )
+            {
+                prvEnterState( pxTask, eStateReady, "Ready", dTime );
+            }
+
+            return;
+
+        case decodeTASK_CREATE:
+
+            if( ( pxObject->pxTask != NULL ) && ( pxObject->pxTask->eState != eStateUnknown ) )
+            {
+                /* A new task in the memory of a deleted one. */
+                ( void ) prvNewTask( pxObject );
+            }
+            else
+            {
+                ( void ) prvGetTask( pxObject );
+            }
+
+            break;
+
+        case decodeTASK_DELETE:
+            pxTask = prvGetTask( pxObject );
+            prvEnterState( pxTask, eStateDeleted, "Deleted", dTime );
+            break;
+
+        case decodeTASK_DELAY:
+        case decodeTASK_DELAY_UNTIL:
+            prvBlockRunningTask( "Delayed", NULL );
+            return;
+
+        case decodeTASK_SUSPEND:
+            pxTask = prvGetTask( pxObject );
+
+            if( pxTask == pxRunning )
+            {
+                prvBlockRunningTask( "Suspended", NULL );
+            }
+            else
+            {
+                prvEnterState( pxTask, eStateBlocked, "Suspended", dTime );
+            }
+
+            break;
+
+        case decodeTASK_NOTIFY_TAKE_BLOCK:
+        case decodeTASK_NOTIFY_WAIT_BLOCK:
+            prvBlockRunningTask( "Blocked: notification", NULL );
+            return;
+
+        /* The create events set the kind even if the address was used by a
+         * different kind of object before. */
+        case decodeQUEUE_CREATE:
+            pxObject->eKind = eKindQueue;
+            pxObject->ulQueueType = ulParameter;
+            pxObject->lItems = 0;
+            break;
+
+        case decodeQUEUE_SEND:
+        case decodeQUEUE_SEND_FROM_ISR:
+            prvSetKind( pxObject, eKindQueue );
+            prvQueueItems( dTime, pxObject, ( long ) ulParameter + 1 );
+            break;
+
+        case decodeQUEUE_RECEIVE:
+        case decodeQUEUE_RECEIVE_FROM_ISR:
+            prvSetKind( pxObject, eKindQueue );
+            prvQueueItems( dTime, pxObject, ( long ) ulParameter - 1 );
+            break;
+
+        case decodeQUEUE_SEND_MULTIPLE:
+            prvSetKind( pxObject, eKindQueue );
+            prvQueueItems( dTime, pxObject, pxObject->lItems + ( long ) ulParameter );
+            break;
+
+        case decodeQUEUE_RECEIVE_MULTIPLE:
+            prvSetKind( pxObject, eKindQueue );
+            prvQueueItems( dTime, pxObject, pxObject->lItems - ( long ) ulParameter );
+            break;
+
+        case decodeMUTEX_TAKE:
+            prvSetKind( pxObject, eKindQueue );
+            prvQueueItems( dTime, pxObject, 0 );
+            break;
+
+        case decodeMUTEX_GIVE:
+            prvSetKind( pxObject, eKindQueue );
+            prvQueueItems( dTime, pxObject, 1 );
+            break;
+
+        case decodeBLOCKING_QUEUE_SEND:
+            prvSetKind( pxObject, eKindQueue );
+            prvBlockRunningTask( prvQueueVerb( pxObject, 1 ), pxObject );
+            break;
+
+        case decodeBLOCKING_QUEUE_RECEIVE:
+        case decodeBLOCKING_QUEUE_PEEK:
+            prvSetKind( pxObject, eKindQueue );
+            prvBlockRunningTask( prvQueueVerb( pxObject, 0 ), pxObject );
+            break;
+
+        case decodeEG_WAIT_BITS_BLOCK:
+        case decodeEG_SYNC_BLOCK:
+            prvSetKind( pxObject, eKindEventGroup );
+            prvBlockRunningTask( "Blocked: wait bits", pxObject );
+            break;
+
+        case decodeSB_BLOCKING_SEND:
+            prvSetKind( pxObject, eKindStreamBuffer );
+            prvBlockRunningTask( "Blocked: send to", pxObject );
+            break;
+
+        case decodeSB_BLOCKING_RECEIVE:
+            prvSetKind( pxObject, eKindStreamBuffer );
+            prvBlockRunningTask( "Blocked: receive from", pxObject );
+            break;
+
+        case decodeEG_CREATE:
+            pxObject->eKind = eKindEventGroup;
+            break;
+
+        case decodeSB_CREATE:
+            pxObject->eKind = eKindStreamBuffer;
+            break;
+
+        case decodeTIMER_CREATE:
+            pxObject->eKind = eKindTimer;
+            break;
+
+        case decodeMEM_POOL_CREATE:
+            pxObject->eKind = eKindMemPool;
+            prvCounter( dTime, pxObject, "free", ( long ) ulParameter );
+            break;
+
+        case decodeMEM_POOL_ALLOC:
+        case decodeMEM_POOL_FREE:
+            prvSetKind( pxObject, eKindMemPool );
+            prvCounter( dTime, pxObject, "free", ( long ) ulParameter );
+            break;
+
+        case decodeUSER:
+            prvSetKind( pxObject, eKindUserChannel );
+            prvCounter( dTime, pxObject, "value", ( long ) ulParameter );
+            return;
+
+        case decodeISR_ENTER:
+            prvSetKind( pxObject, eKindISR );
+
+            if( xISRDepth < decodeMAX_ISR_NESTING )
+            {
+                ulISRStack[ xISRDepth ] = ulHandle;
+                dISRSince[ xISRDepth ] = dTime;
+            }
+
+            xISRDepth++;
+            return;
+
+        case decodeISR_EXIT:
+
+            if( xISRDepth > 0 )
+            {
+                xISRDepth--;
+
+                if( ( xISRDepth < decodeMAX_ISR_NESTING ) && ( ulISRStack[ xISRDepth ] == ulHandle ) )
+                {
+                    prvSlice( decodeISR_TID, prvObjectName( pxObject ), dISRSince[ xISRDepth ], dTime );
+                }
+            }
+
+            return;
+
+        default:
+            break;
+    }
+
+    for( i = 0; i < sizeof( xEventNames ) / sizeof( xEventNames[ 0 ] ); i++ )
+    {
+        if( xEventNames[ i ].xID == xID )
+        {
+            prvSetKind( pxObject, xEventNames[ i ].eKind );
+            prvInstant( dTime, xEventNames[ i ].pcName, pxObject, ulParameter );
+            return;
+        }
+    }
+
+    prvInstant( dTime, "Unknown event", pxObject, ( ulParameter << 8 ) | ( uint32_t ) xID );
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the offset of the first plausible recorder header in the dump, or
+ * -1 if there is none. */
+static long prvFindHeader( const uint8_t * pucDump,
+                           size_t xLength )
+{
+    size_t xOffset;
+
+    for( xOffset = 0; xOffset + ( decodeHEADER_WORDS * 4 ) <= xLength; xOffset += 4 )
+    {
+        const uint8_t * pucHeader = pucDump + xOffset;
+        uint32_t ulEvents, ulSymbols, ulNameLength;
+        size_t xSize;
+
+        if( ( prvRead32( pucHeader ) != decodeMAGIC ) || ( prvRead32( pucHeader + 4 ) != decodeVERSION ) )
+        {
+            continue;
+        }
+
+        ulEvents = prvRead32( pucHeader + 12 );
+        ulSymbols = prvRead32( pucHeader + 16 );
+        ulNameLength = prvRead32( pucHeader + 20 );
+
+        if( ( ulEvents == 0 ) || ( ( ulEvents & ( ulEvents - 1 ) ) != 0 ) || ( ulEvents > ( 1UL << 24 ) ) ||
+            ( ulSymbols > 65536 ) || ( ulNameLength == 0 ) || ( ( ulNameLength % 4 ) != 0 ) || ( ulNameLength > 256 ) )
+        {
+            continue;
+        }
+
+        xSize = ( decodeHEADER_WORDS * 4 ) + ( ( size_t ) ulSymbols * ( 8 + ulNameLength ) ) + ( ( size_t ) ulEvents * 12 );
+
+        if( xOffset + xSize <= xLength )
+        {
+            return ( long ) xOffset;
+        }
+    }
+
+    return -1;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvReadFile( const char * pcPath,
+                              size_t * pxLength )
+{
+    FILE * pxFile = fopen( pcPath, "rb" );
+    uint8_t * pucData = NULL;
+    size_t xCapacity = 0, xLength = 0, xRead;
+
+    if( pxFile == NULL )
+    {
+        return NULL;
+    }
+
+    do
+    {
+        if( xLength == xCapacity )
+        {
+            xCapacity = ( xCapacity == 0 ) ? 65536 : xCapacity * 2;
+            pucData = realloc( pucData, xCapacity );
+
+            if( pucData == NULL )
+            {
+                fclose( pxFile );
+                return NULL;
+            }
+        }
+
+        xRead = fread( pucData + xLength, 1, xCapacity - xLength, pxFile );
+        xLength += xRead;
+    } while( xRead > 0 );
+
+    fclose( pxFile );
+    *pxLength = xLength;
+
+    return pucData;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintSummary( double dEnd )
+{
+    size_t i;
+
+    fprintf( stderr, "%-16s %12s %8s %10s %14s %14s\n", "task", "running_us", "cpu_%", "switches", "ready_avg_us", "ready_max_us" );
+
+    for( i = 0; i < xTaskCount; i++ )
+    {
+        Task_t * pxTask = ppxTasks[ i ];
+
+        fprintf( stderr, "%-16s %12.1f %8.2f %10lu %14.2f %14.2f\n",
+                 pxTask->cName,
+                 pxTask->dRunning,
+                 ( dEnd > 0.0 ) ? ( 100.0 * pxTask->dRunning / dEnd ) : 0.0,
+                 pxTask->ulSwitchesIn,
+                 ( pxTask->ulReadyCount > 0 ) ? ( pxTask->dReadyTotal / ( double ) pxTask->ulReadyCount ) : 0.0,
+                 pxTask->dReadyMax );
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    const char * pcInput = NULL, * pcOutput = NULL;
+    double dHz = 0.0, dTime = 0.0;
+    uint8_t * pucDump;
+    const uint8_t * pucHeader, * pucSymbols, * pucEvents;
+    size_t xLength, i;
+    long lOffset;
+    uint32_t ulHz, ulEvents, ulSymbols, ulNameLength, ulWritten, ulSymbolsWritten, ulCount, ulFirst, ulPrevious = 0;
+    uint64_t ullTicks = 0;
+    int xArg;
+
+    for( xArg = 1; xArg < argc; xArg++ )
+    {
+        if( ( strcmp( argv[ xArg ], "-f" ) == 0 ) && ( xArg + 1 < argc ) )
+        {
+            dHz = strtod( argv[ ++xArg ], NULL );
+        }
+        else if( pcInput == NULL )
+        {
+            pcInput = argv[ xArg ];
+        }
+        else if( pcOutput == NULL )
+        {
+            pcOutput = argv[ xArg ];
+        }
+        else
+        {
+            pcInput = NULL;
+            break;
+        }
+    }
+
+    if( pcInput == NULL )
+    {
+        fprintf( stderr, "usage: %s [-f timestamp_hz] dump.bin [trace.json]\n", argv[ 0 ] );
+        return 2;
+    }
+
+    pucDump = prvReadFile( pcInput, &xLength );
+
+    if( pucDump == NULL )
+    {
+        fprintf( stderr, "trace_decode: cannot read %s\n", pcInput );
+        return 1;
+    }
+
+    lOffset = prvFindHeader( pucDump, xLength );
+
+    if( lOffset < 0 )
+    {
+        fprintf( stderr, "trace_decode: no trace recorder buffer in %s\n", pcInput );
+        return 1;
+    }
+
+    pucHeader = pucDump + lOffset;
+    ulHz = prvRead32( pucHeader + 8 );
+    ulEvents = prvRead32( pucHeader + 12 );
+    ulSymbols = prvRead32( pucHeader + 16 );
+    ulNameLength = prvRead32( pucHeader + 20 );
+    ulWritten = prvRead32( pucHeader + 24 );
+    ulSymbolsWritten = prvRead32( pucHeader + 28 );
+    pucSymbols = pucHeader + ( decodeHEADER_WORDS * 4 );
+    pucEvents = pucSymbols + ( ( size_t ) ulSymbols * ( 8 + ulNameLength ) );
+
+    if( dHz <= 0.0 )
+    {
+        if( ulHz == 0 )
+        {
+            fprintf( stderr, "trace_decode: the dump has no timestamp frequency (the scheduler was never started), give it with -f\n" );
+            return 1;
+        }
+
+        dHz = ( double ) ulHz;
+    }
+
+    dTicksPerMicrosecond = dHz / 1000000.0;
+
+    if( pcOutput != NULL )
+    {
+        pxOut = fopen( pcOutput, "w" );
+
+        if( pxOut == NULL )
+        {
+            fprintf( stderr, "trace_decode: cannot write %s\n", pcOutput );
+            return 1;
+        }
+    }
+    else
+    {
+        pxOut = stdout;
+    }
+
+    if( ulSymbolsWritten > ulSymbols )
+    {
+        ulSymbolsWritten = ulSymbols;
+    }
+
+    for( i = 0; i < ulSymbolsWritten; i++ )
+    {
+        const uint8_t * pucSymbol = pucSymbols + ( i * ( 8 + ulNameLength ) );
+        Object_t * pxObject = prvGetObject( prvRead32( pucSymbol ) );
+        size_t xNameLength = strnlen( ( const char * ) pucSymbol + 8, ulNameLength );
+        Symbol_t * pxSymbol = calloc( 1, sizeof( Symbol_t ) );
+        Symbol_t ** ppxInsert = &( pxObject->pxSymbols );
+
+        if( pxSymbol == NULL )
+        {
+            fprintf( stderr, "trace_decode: out of memory\n" );
+            return 1;
+        }
+
+        if( xNameLength >= sizeof( pxSymbol->cName ) )
+        {
+            xNameLength = sizeof( pxSymbol->cName ) - 1;
+        }
+
+        pxSymbol->ulFirstEvent = prvRead32( pucSymbol + 4 );
+        memcpy( pxSymbol->cName, pucSymbol + 8, xNameLength );
+
+        /* Keep each address's names sorted newest first. */
+        while( ( *ppxInsert != NULL ) && ( ( *ppxInsert )->ulFirstEvent > pxSymbol->ulFirstEvent ) )
+        {
+            ppxInsert = &( ( *ppxInsert )->pxOlder );
+        }
+
+        pxSymbol->pxOlder = *ppxInsert;
+        *ppxInsert = pxSymbol;
+    }
+
+    prvGetObject( decodeTICK_ISR )->eKind = eKindISR;
+
+    fprintf( pxOut, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" );
+    prvBeginEvent();
+    fprintf( pxOut, "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"FreeRTOS\"}}" );
+    prvThreadName( decodeCPU_TID, "CPU" );
+    prvThreadName( decodeISR_TID, "Interrupts" );
+
+    /* Once the ring has wrapped the oldest event is the one the next write
+     * would overwrite. */
+    ulCount = ( ulWritten > ulEvents ) ? ulEvents : ulWritten;
+    ulFirst = ( ulWritten > ulEvents ) ? ( ulWritten & ( ulEvents - 1 ) ) : 0;
+
+    for( i = 0; i < ulCount; i++ )
+    {
+        const uint8_t * pucEvent = pucEvents + ( ( size_t ) ( ( ulFirst + i ) & ( ulEvents - 1 ) ) * 12 );
+        uint32_t ulTimestamp = prvRead32( pucEvent );
+        uint32_t ulEventAndParameter = prvRead32( pucEvent + 8 );
+
+        /* The counter wraps, consecutive events are assumed to be less than
+         * one wrap apart. */
+        if( i > 0 )
+        {
+            ullTicks += ( uint32_t ) ( ulTimestamp - ulPrevious );
+        }
+
+        ulPrevious = ulTimestamp;
+        dTime = ( double ) ullTicks / dTicksPerMicrosecond;
+        ulEventNumber = ulWritten - ulCount + ( uint32_t ) i;
+
+        prvDecodeEvent( dTime, prvRead32( pucEvent + 4 ), ( int ) ( ulEventAndParameter & 0xffU ), ulEventAndParameter >> 8 );
+    }
+
+    /* Close the slices still open at the end of the trace. */
+    if( pxRunning != NULL )
+    {
+        prvSlice( decodeCPU_TID, pxRunning->cName, dCpuSince, dTime );
+    }
+
+    for( i = 0; i < xTaskCount; i++ )
+    {
+        if( ( ppxTasks[ i ]->eState != eStateUnknown ) && ( ppxTasks[ i ]->eState != eStateDeleted ) )
+        {
+            prvEnterState( ppxTasks[ i ], eStateUnknown, "", dTime );
+        }
+    }
+
+    fprintf( pxOut, "\n]}\n" );
+
+    if( pxOut != stdout )
+    {
+        fclose( pxOut );
+    }
+
+    fprintf( stderr, "%lu events decoded, %lu older events overwritten, %.3f ms\n",
+             ( unsigned long ) ulCount, ( unsigned long ) ( ulWritten - ulCount ), dTime / 1000.0 );
+    prvPrintSummary( dTime );
+
+    free( pucDump );
+
+    return 0;
+}
@@ -1,26 +1,141 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#ifdef USE_HOST_SIM
+#include <time.h>
+#else
 #include "air32f10x.h"
+#endif
 
 #include "FreeRTOS.h"
 #include "task.h"
 
+/* 置1时以内核基准测试 (Benchmark/) 代替演示任务, 结果以CSV表格打印 */
+#ifndef mainRUN_KERNEL_BENCH
+#define mainRUN_KERNEL_BENCH 0
+#endif
+
+#if ( mainRUN_KERNEL_BENCH == 1 )
+#include "bench.h"
+#else
+#include "static_objects.h"
+#endif
+
+/* 置1时在创建任务前用vPortDefineHeapRegions()定义堆区域, 使用heap_5.c或heap_6.c时需要 */
+#ifndef mainDEFINE_HEAP_REGIONS
+#define mainDEFINE_HEAP_REGIONS 0
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 ) && defined(USE_HOST_SIM)
+/* 调度器退出或断言失败时跟踪缓冲区写入此文件, 用Tools/trace_decode转换 */
+#ifndef mainTRACE_FILE
+#define mainTRACE_FILE "freertos_trace.bin"
+#endif
+
+static void prvWriteTrace(void)
+{
+    size_t xSize;
+    const void *pvBuffer;
+    FILE *pxFile;
+
+    vTraceRecorderStop();
+    pvBuffer = pvTraceRecorderGetBuffer(&xSize);
+
+    pxFile = fopen(mainTRACE_FILE, "wb");
+    if (pxFile != NULL) {
+        fwrite(pvBuffer, 1, xSize, pxFile);
+        fclose(pxFile);
+        fprintf(stderr, "trace written to %s\n", mainTRACE_FILE);
+    }
+}
+#endif
+
+#ifndef USE_HOST_SIM
 USART_TypeDef *USART_TEST = USART1;
 
 void UART_Configuration(uint32_t bound);
+#endif
 
 uint32_t SystemCoreClock = 256000000;
 
 #define mainCREATOR_TASK_PRIORITY           ( tskIDLE_PRIORITY + 3 )
+#define mainBENCH_TASK_PRIORITY             ( tskIDLE_PRIORITY + 2 )
 #define TASK_PRORITY_LED 3
 
 #define LED1_GPIO_PORT GPIOB
 #define LED1_GPIO_PORT_RCC RCC_APB2Periph_GPIOB
 #define LED1_GPIO GPIO_Pin_11
 
+#if ( mainDEFINE_HEAP_REGIONS == 1 )
+/* 与heap_4相同大小的单个区域, 便于比较两者的碎片情况 */
+static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+
+static void prvInitialiseHeap(void)
+{
+    const HeapRegion_t xHeapRegions[] =
+    {
+        { ucHeap, sizeof( ucHeap ) },
+        { NULL, 0 }
+    };
+
+    vPortDefineHeapRegions( xHeapRegions );
+}
+#endif
+
+#if ( mainRUN_KERNEL_BENCH != 1 )
+/* 演示程序的静态对象表: 任务的TCB和栈, 队列, 信号量与定时器的存储都是静态变量,
+   由vCreateSystemObjects()在启动调度器前创建, 不调用pvPortMalloc(), 见static_objects.h */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#define mainCPU_LOAD_TASK( X ) \
+    X( xCpuLoadTask, task_cpu_load, "task_cpu_load", 256, NULL, tskIDLE_PRIORITY + 1 )
+#else
+#define mainCPU_LOAD_TASK( X )
+#endif
+
+/* 定时器每秒把LED的新状态发到xLedQueue, task_led取出后点亮或熄灭LED,
+   xPrintMutex保证各任务的printf输出不交错 */
+#define mainTASKS( X ) \
+    X( xLedTask, task_led, "task_led", 128, NULL, TASK_PRORITY_LED ) \
+    mainCPU_LOAD_TASK( X )
+#define mainQUEUES( X ) \
+    X( xLedQueue, 2, sizeof( uint8_t ) )
+#define mainSEMAPHORES( X ) \
+    X( xPrintMutex, MUTEX, 0, 0 )
+#define mainTIMERS( X ) \
+    X( xLedTimer, "led", pdMS_TO_TICKS( 1000 ), pdTRUE, NULL, prvLedTimerCallback, pdTRUE )
+
+staticDECLARE_OBJECTS( mainTASKS, mainQUEUES, mainSEMAPHORES, mainTIMERS )
+
+static void prvLedTimerCallback(TimerHandle_t xTimer)//在定时器任务中翻转LED状态
+{
+    static uint8_t ucLedOn = 0;
+
+    ( void ) xTimer;
+    ucLedOn = !ucLedOn;
+    ( void ) xQueueSend(xLedQueue, &ucLedOn, 0); //队列满时丢弃, 下一秒再发
+}
+#endif
+
+#if ( mainRUN_KERNEL_BENCH == 1 )
+/* 基准测试模式下不创建演示任务 */
+#elif defined(USE_HOST_SIM)
+static void task_led(void *pvParameters)//运行指示灯, 主机上以打印代替GPIO
+{
+    uint8_t ucLedOn;
+
+    while(1) {
+        xQueueReceive(xLedQueue, &ucLedOn, portMAX_DELAY);
+        xSemaphoreTake(xPrintMutex, portMAX_DELAY);
+        printf("[%lu] LED %s\n", (unsigned long)xTaskGetTickCount(), ucLedOn ? "on" : "off");
+        xSemaphoreGive(xPrintMutex);
+    }
+    vTaskDelete( NULL );
+}
+#else
 static void task_led(void *pvParameters)//运行指示灯
 {
+	uint8_t ucLedOn;
+
 	RCC_APB2PeriphClockCmd(LED1_GPIO_PORT_RCC, ENABLE);
 	GPIO_InitTypeDef gpio_conf;
     GPIO_StructInit(&gpio_conf);
@@ -29,16 +144,49 @@ static void task_led(void *pvParameters)//运行指示灯
 	gpio_conf.GPIO_Speed = GPIO_Speed_50MHz;
 	GPIO_Init(LED1_GPIO_PORT, &gpio_conf);
     while(1) {
-        GPIO_SetBits(LED1_GPIO_PORT, LED1_GPIO);
-        vTaskDelay(pdMS_TO_TICKS(1000));
-        GPIO_ResetBits(LED1_GPIO_PORT, LED1_GPIO);
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        xQueueReceive(xLedQueue, &ucLedOn, portMAX_DELAY);
+        if (ucLedOn) {
+            GPIO_SetBits(LED1_GPIO_PORT, LED1_GPIO);
+        } else {
+            GPIO_ResetBits(LED1_GPIO_PORT, LED1_GPIO);
+        }
+    }
+    vTaskDelete( NULL );
+}
+#endif
+
+#if ( mainRUN_KERNEL_BENCH != 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 )
+#define mainCPU_LOAD_TASKS 8
+
+static void task_cpu_load(void *pvParameters)//每5秒打印各任务的CPU占用率
+{
+    static TaskRunTimeSnapshot_t xSnapshot[mainCPU_LOAD_TASKS];
+    UBaseType_t i, uxTasks;
+
+    while(1) {
+        vTaskDelay(pdMS_TO_TICKS(5000));
+        uxTasks = uxTaskGetRunTimeSnapshot(xSnapshot, mainCPU_LOAD_TASKS, NULL);
+        xSemaphoreTake(xPrintMutex, portMAX_DELAY); //整张表一次打印完
+        for (i = 0; i < uxTasks; i++) {
+            printf("%-16s cpu %2u.%02u%%  isr %2u.%02u%%\n", xSnapshot[i].pcTaskName,
+                   xSnapshot[i].usCPUUsage / 100U, xSnapshot[i].usCPUUsage % 100U,
+                   xSnapshot[i].usISRUsage / 100U, xSnapshot[i].usISRUsage % 100U);
+        }
+        xSemaphoreGive(xPrintMutex);
     }
     vTaskDelete( NULL );
 }
+#endif
+
+#if ( mainRUN_KERNEL_BENCH != 1 )
+staticDEFINE_OBJECTS( vCreateSystemObjects, mainTASKS, mainQUEUES, mainSEMAPHORES, mainTIMERS )
+#endif
 
 int main(void)
 {
+#ifdef USE_HOST_SIM
+	printf("FreeRTOS %s on the Posix port\n", tskKERNEL_VERSION_NUMBER);
+#else
 	RCC_ClocksTypeDef clocks;
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
 	UART_Configuration(115200); //串口初始化
@@ -47,16 +195,83 @@ int main(void)
 	printf("SYSCLK: %3.1fMhz, \nHCLK: %3.1fMhz, \nPCLK1: %3.1fMhz, \nPCLK2: %3.1fMhz, \nADCCLK: %3.1fMhz\n",
 			   (float)clocks.SYSCLK_Frequency / 1000000, (float)clocks.HCLK_Frequency / 1000000,
 			   (float)clocks.PCLK1_Frequency / 1000000, (float)clocks.PCLK2_Frequency / 1000000, (float)clocks.ADCCLK_Frequency / 1000000);
+#endif
     
-    xTaskCreate( task_led, "task_led", 128, NULL, TASK_PRORITY_LED, NULL );
+#if ( mainDEFINE_HEAP_REGIONS == 1 )
+    prvInitialiseHeap();
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+#ifndef USE_HOST_SIM
+    /* 跟踪时间戳使用DWT周期计数器 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    vTraceRecorderStart(); //时钟配置完成后记录时间戳频率
+#endif
+
+#if ( mainRUN_KERNEL_BENCH == 1 )
+    vStartKernelBenchmarks( mainBENCH_TASK_PRIORITY );
+#else
+    vCreateSystemObjects();
+#endif
     
 	/* Start the scheduler. */
 	vTaskStartScheduler();
-	/* Will only get here if there was not enough heap space to create the
-	idle task. */
+#if ( configUSE_TRACE_RECORDER == 1 ) && defined(USE_HOST_SIM)
+	prvWriteTrace();
+#endif
+	/* Will only get here once the scheduler has been ended, as the idle and
+	timer tasks are created in static memory. */
 	return 0;
 }
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+/* 静态分配时空闲任务和定时器任务的TCB与栈由应用提供 */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if ( configUSE_TIMERS == 1 )
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+#endif
+
+#ifdef USE_HOST_SIM
+void vAssertCalled( const char * pcFile, unsigned long ulLine )
+{
+	taskDISABLE_INTERRUPTS();
+	fprintf(stderr, "ASSERT! %s:%lu\n", pcFile, ulLine);
+#if ( configUSE_TRACE_RECORDER == 1 )
+	prvWriteTrace(); //保留导致断言的事件
+#endif
+	abort();
+}
+
+uint32_t ulHostTraceTimestamp(void)
+{
+	struct timespec xNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &xNow);
+
+	return (uint32_t)((uint64_t)xNow.tv_sec * 1000000000ULL + (uint64_t)xNow.tv_nsec);
+}
+#else
 void SystemInit(void)
 {
 	RCC_DeInit(); //复位RCC寄存器
@@ -132,3 +347,4 @@ int fputc(int c, FILE *f)
 	}
 	return (SER_PutChar(c));
 }
+#endif